@@ -1244,7 +1244,7 @@ add_newdoc('numpy.core.multiarray', 'frombuffer',
 
 add_newdoc('numpy.core.multiarray', 'concatenate',
     """
-    concatenate((a1, a2, ...), axis=0)
+    concatenate((a1, a2, ...), axis=0, nthreads=1)
 
     Join a sequence of arrays together.
 
@@ -1255,6 +1255,10 @@ add_newdoc('numpy.core.multiarray', 'concatenate',
         corresponding to `axis` (the first, by default).
     axis : int, optional
         The axis along which the arrays will be joined.  Default is 0.
+    nthreads : int, optional
+        The number of threads copying the inputs which are contiguous in
+        the same layout as their place in the result. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
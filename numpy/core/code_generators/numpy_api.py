@@ -344,6 +344,12 @@ multiarray_funcs_api = {
     'NpyNA_FromDTypeAndPayload':            304,
     'PyArray_AllowNAConverter':             305,
     'PyArray_OutputAllowNAConverter':       306,
+    'PyDataMem_NEW':                        307,
+    'PyDataMem_NEW_ZEROED':                 308,
+    'PyDataMem_FREE':                       309,
+    'PyDataMem_RENEW':                      310,
+    'PyDataMem_SetHandler':                 311,
+    'PyDataMem_GetHandler':                 312,
 }
 
 ufunc_types_api = {
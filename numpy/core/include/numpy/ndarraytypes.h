@@ -336,10 +336,28 @@ NpyMaskValue_Create(npy_bool exposed, npy_uint8 payload)
    * allocated.
    */
 
-  /* Data buffer */
-#define PyDataMem_NEW(size) ((char *)malloc(size))
-#define PyDataMem_FREE(ptr)  free(ptr)
-#define PyDataMem_RENEW(ptr,size) ((char *)realloc(ptr,size))
+  /*
+   * Data buffer. PyDataMem_NEW, PyDataMem_NEW_ZEROED, PyDataMem_FREE
+   * and PyDataMem_RENEW are functions in the C API. Blocks are
+   * allocated by the currently installed PyDataMem_Handler, and freed
+   * and reallocated by the handler which allocated them.
+   */
+typedef void *(PyDataMem_MallocFunc)(void *ctx, size_t size);
+typedef void *(PyDataMem_CallocFunc)(void *ctx, size_t nelem, size_t elsize);
+typedef void *(PyDataMem_ReallocFunc)(void *ctx, void *ptr, size_t new_size);
+typedef void (PyDataMem_FreeFunc)(void *ctx, void *ptr);
+
+typedef struct {
+    /* A short name identifying the allocator */
+    const char *name;
+    /* Opaque data passed as the first argument to the functions */
+    void *ctx;
+    PyDataMem_MallocFunc *malloc;
+    /* Must return zero-filled memory, like calloc */
+    PyDataMem_CallocFunc *calloc;
+    PyDataMem_ReallocFunc *realloc;
+    PyDataMem_FreeFunc *free;
+} PyDataMem_Handler;
 
 #define NPY_USE_PYMEM 1
 
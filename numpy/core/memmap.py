@@ -1,7 +1,9 @@
 __all__ = ['memmap']
 
 import warnings
-from numeric import uint8, ndarray, dtype
+from numeric import uint8, ndarray, dtype, frombuffer, asarray, concatenate, \
+        newaxis, empty
+from multiarray import _madvise
 import sys
 
 from numpy.compat import asbytes
@@ -17,6 +19,9 @@ mode_equivalents = {
     "write":"w+"
     }
 
+# Default size in bytes of the blocks of `memmap.blocks`.
+BLOCK_BYTES = 2**26
+
 class memmap(ndarray):
     """
     Create a memory-map to an array stored in a *binary* file on disk.
@@ -88,6 +93,17 @@ class memmap(ndarray):
         Flush any changes in memory to file on disk.
         When you delete a memmap object, flush is called first to write
         changes to disk before removing the object.
+    advise
+        Tell the operating system how rows of the array will be accessed.
+    prefetch
+        Start reading rows of the array from disk ahead of their use.
+    blocks
+        Iterate over blocks of rows, prefetching the next block while the
+        current one is processed.
+    reduce
+        Reduce the array with a ufunc a block of rows at a time.
+    apply
+        Apply a function to the array a block of rows at a time.
 
     Notes
     -----
@@ -269,7 +285,7 @@ class memmap(ndarray):
         else:
             self._mmap = None
 
-    def flush(self):
+    def flush(self, start=None, stop=None):
         """
         Write any changes in the array to the file on disk.
 
@@ -277,12 +293,306 @@ class memmap(ndarray):
 
         Parameters
         ----------
-        None
+        start, stop : int, optional
+            If given, only the pages holding rows ``start:stop`` along the
+            first axis are written, with ``msync``.
 
         See Also
         --------
         memmap
 
         """
+        if start is not None or stop is not None:
+            if self._mmap is not None:
+                lo, hi = self._byte_range(start, stop)
+                if lo < hi:
+                    self._mmap.flush(lo, hi - lo)
+            return
         if self.base is not None and hasattr(self.base, 'flush'):
             self.base.flush()
+
+    def advise(self, advice, start=None, stop=None):
+        """
+        Tell the operating system how rows ``start:stop`` along the first
+        axis will be accessed, with ``madvise``.
+
+        Parameters
+        ----------
+        advice : {'normal', 'random', 'sequential', 'willneed', 'dontneed'}
+            The expected access. 'willneed' starts reading the rows in the
+            background, and 'dontneed' lets the pages be dropped from
+            memory; for a copy-on-write map ('c' mode) this discards the
+            changes made to them.
+        start, stop : int, optional
+            The rows to advise on. Default: all of them.
+
+        Notes
+        -----
+        The advice is only a hint, which is ignored on platforms without
+        ``madvise``. It is given for the pages entirely inside the rows.
+        A ValueError is raised if the rows are not in the memory map,
+        as for the result of arithmetic on a memmap.
+
+        """
+        # Check that the rows are in the map before advising on them
+        self._byte_range(start, stop)
+        _madvise(self._rows(start, stop), advice)
+
+    def prefetch(self, start=None, stop=None, background=False):
+        """
+        Start reading rows ``start:stop`` along the first axis from disk.
+
+        Parameters
+        ----------
+        start, stop : int, optional
+            The rows to read. Default: all of them.
+        background : bool, optional
+            By default the operating system is asked to read the rows
+            ahead (``madvise`` with 'willneed'). If True, a thread touches
+            every page of the rows instead, which also works where the
+            advice is ignored.
+
+        Returns
+        -------
+        thread : threading.Thread or None
+            The thread reading the rows, when `background` is True.
+
+        """
+        if not background:
+            self.advise('willneed', start, stop)
+            return None
+        import threading
+        pages = self._pages(start, stop)
+        thread = threading.Thread(target=_touch, args=(pages,))
+        thread.setDaemon(True)
+        thread.start()
+        return thread
+
+    def blocks(self, rows=None, prefetch=True, background=False,
+               evict=False):
+        """
+        Iterate over blocks of rows along the first axis, prefetching the
+        next block while the current one is processed.
+
+        Parameters
+        ----------
+        rows : int, optional
+            The number of rows in a block. Default: as many as fit in
+            `BLOCK_BYTES` bytes, rounded down so that the blocks start on
+            pages of the file if the array does.
+        prefetch : bool, optional
+            Whether to prefetch the next block, see `prefetch`.
+        background : bool, optional
+            Prefetch with a thread instead of ``madvise``.
+        evict : bool, optional
+            Whether to let the pages of a block be dropped from memory once
+            the next block is requested, so that a scan of a file larger
+            than memory doesn't push other data out of the page cache. Only
+            allowed for read-only maps.
+
+        Yields
+        ------
+        block : memmap
+            Views of consecutive rows of the array.
+
+        """
+        if self.ndim == 0:
+            raise ValueError("a 0-d memmap has no rows")
+        if evict and self.mode != 'r':
+            raise ValueError("evict is only allowed in mode 'r'")
+        n = len(self)
+        if rows is None:
+            rows = self._block_rows()
+        thread = None
+        if prefetch:
+            thread = self.prefetch(0, rows, background)
+        for lo in range(0, n, rows):
+            hi = min(lo + rows, n)
+            if prefetch and hi < n:
+                if thread is not None:
+                    thread.join()
+                thread = self.prefetch(hi, hi + rows, background)
+            yield self[lo:hi]
+            if evict:
+                self.advise('dontneed', lo, hi)
+        if thread is not None:
+            thread.join()
+
+    def reduce(self, ufunc, axis=None, dtype=None, rows=None,
+               background=False, evict=None):
+        """
+        Reduce the array with `ufunc` a block of rows at a time, so that
+        arrays larger than memory can be reduced while the next block is
+        read from disk.
+
+        Parameters
+        ----------
+        ufunc : ufunc
+            A binary ufunc such as `add`, `minimum` or `maximum`. Those
+            which aren't reorderable, such as `subtract`, can only reduce
+            over one axis, as for ``ufunc.reduce``.
+        axis : None, int or tuple of ints, optional
+            The axes to reduce over, as for ``ufunc.reduce``, except that
+            the default is to reduce over all of them.
+        dtype : data-type, optional
+            The type used for the reduction, as for ``ufunc.reduce``.
+        rows, background : optional
+            The block size, and how the next block is prefetched, see
+            `blocks`.
+        evict : bool, optional
+            Whether to drop the blocks from memory once they are reduced.
+            Default: True for read-only maps.
+
+        Returns
+        -------
+        result : ndarray or scalar
+            The reduction. Reducing a block at a time may round floating
+            point sums differently from ``ufunc.reduce``.
+
+        Examples
+        --------
+        >>> fp = np.lib.format.open_memmap('big.npy', mode='r')  # doctest: +SKIP
+        >>> total = fp.reduce(np.add)  # doctest: +SKIP
+        >>> column_max = fp.reduce(np.maximum, axis=0)  # doctest: +SKIP
+
+        """
+        if evict is None:
+            evict = self.mode == 'r'
+        whole = self.view(ndarray)
+        if self.ndim == 0 or len(self) == 0:
+            return ufunc.reduce(whole, axis=axis, dtype=dtype)
+        if axis is None:
+            axes = tuple(range(self.ndim))
+        elif isinstance(axis, tuple):
+            axes = axis
+        else:
+            axes = (axis,)
+        over_rows = 0 in [ax % self.ndim for ax in axes]
+        # The reductions of the blocks can only be combined for a
+        # reorderable ufunc. For others, such as subtract, a reduction
+        # along the rows alone starts each block from the result so far
+        # instead. A reduction over several axes raises for those.
+        carry = (over_rows and len(axes) == 1 and
+                 not _reorderable(ufunc))
+        result = None
+        parts = []
+        for block in self.blocks(rows, True, background, evict):
+            block = block.view(ndarray)
+            if carry and result is not None:
+                block = concatenate([result[newaxis], block])
+            part = ufunc.reduce(block, axis=axes, dtype=dtype)
+            if not over_rows:
+                parts.append(part)
+            elif result is None or carry:
+                result = asarray(part)
+            else:
+                ufunc(result, part, out=result)
+        if not over_rows:
+            return concatenate(parts)
+        if result.ndim == 0:
+            return result[()]
+        return result
+
+    def apply(self, func, out=None, rows=None, background=False,
+              evict=None):
+        """
+        Apply `func` to the array a block of rows at a time, while the next
+        block is read from disk.
+
+        Parameters
+        ----------
+        func : callable
+            Called with each block of rows, as an ndarray, and returning an
+            array with one row for each row of the block.
+        out : ndarray, optional
+            Where to store the results, which may be another memmap. By
+            default they are joined into a new array.
+        rows, background, evict : optional
+            See `reduce`.
+
+        Returns
+        -------
+        out : ndarray
+
+        """
+        if evict is None:
+            evict = self.mode == 'r'
+        parts = []
+        lo = 0
+        for block in self.blocks(rows, True, background, evict):
+            part = func(block.view(ndarray))
+            if out is None:
+                parts.append(part)
+            else:
+                out[lo:lo + len(block)] = part
+            lo += len(block)
+        if out is None:
+            return concatenate(parts)
+        return out
+
+    def _block_rows(self):
+        import mmap
+        rowbytes = max(1, self[0:1].nbytes)
+        rows = max(1, BLOCK_BYTES // rowbytes)
+        # Blocks start on pages when their size is a multiple of the page
+        # size, so a step of that many rows is kept.
+        a, b = rowbytes, mmap.PAGESIZE
+        while b:
+            a, b = b, a % b
+        step = mmap.PAGESIZE // a
+        if rows >= step:
+            rows -= rows % step
+        return rows
+
+    def _rows(self, start, stop):
+        if self.ndim == 0:
+            return self
+        return self[start:stop]
+
+    def _byte_range(self, start, stop):
+        """
+        Return the page aligned offsets in the map of the memory holding
+        rows ``start:stop``.
+        """
+        import mmap
+        if self._mmap is None:
+            raise ValueError("the array is not in a memory map")
+        part = self._rows(start, stop)
+        if part.size == 0:
+            return 0, 0
+        lo = hi = part.__array_interface__['data'][0]
+        for n, stride in zip(part.shape, part.strides):
+            if stride < 0:
+                lo += stride*(n - 1)
+            else:
+                hi += stride*(n - 1)
+        hi += part.itemsize
+        base = frombuffer(self._mmap, dtype=uint8)
+        start = base.__array_interface__['data'][0]
+        if lo < start or hi > start + len(base):
+            raise ValueError("the array is not in the memory map")
+        lo -= start
+        hi -= start
+        return lo - lo % mmap.PAGESIZE, hi
+
+    def _pages(self, start, stop):
+        """A byte of each page holding rows ``start:stop``."""
+        import mmap
+        lo, hi = self._byte_range(start, stop)
+        return frombuffer(self._mmap, dtype=uint8)[lo:hi:mmap.PAGESIZE]
+
+def _reorderable(ufunc):
+    """
+    Whether the binary `ufunc` is reorderable, which ``ufunc.reduce`` only
+    allows reductions over several axes for.
+    """
+    try:
+        ufunc.reduce(empty((1, 1), dtype=ufunc.types[0][0]), axis=(0, 1))
+    except ValueError:
+        return False
+    return True
+
+def _touch(pages):
+    # The reduction reads a byte of every page without holding the GIL
+    if len(pages):
+        pages.max()
@@ -417,6 +417,11 @@ def configuration(parent_package='',top_path=None):
             moredefs.extend(cocache.check_ieee_macros(config_cmd)[0])
             moredefs.extend(cocache.check_complex(config_cmd, mathlibs)[0])
 
+            # Memory allocation functions for the data allocation policies
+            for f in OPTIONAL_MEMFUNCS:
+                if config_cmd.check_func(f, decl=True):
+                    moredefs.append((fname2def(f), 1))
+
             # Signal check
             if is_npy_no_signal():
                 moredefs.append('__NPY_PRIVATE_NO_SIGNAL')
@@ -699,6 +704,7 @@ def configuration(parent_package='',top_path=None):
         cmd.template_sources(sources, ext)
 
     multiarray_deps = [
+            join('src', 'multiarray', 'alloc.h'),
             join('src', 'multiarray', 'arrayobject.h'),
             join('src', 'multiarray', 'arraytypes.h'),
             join('src', 'multiarray', 'array_assign.h'),
@@ -725,6 +731,8 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'scalartypes.h'),
             join('src', 'multiarray', 'sequence.h'),
             join('src', 'multiarray', 'shape.h'),
+            join('src', 'multiarray', 'textreader.h'),
+            join('src', 'multiarray', 'textwriter.h'),
             join('src', 'multiarray', 'ucsnarrow.h'),
             join('src', 'multiarray', 'usertypes.h'),
             join('src', 'multiarray', 'na_mask.h'),
@@ -753,6 +761,7 @@ def configuration(parent_package='',top_path=None):
             ]
 
     multiarray_src = [
+            join('src', 'multiarray', 'alloc.c'),
             join('src', 'multiarray', 'arrayobject.c'),
             join('src', 'multiarray', 'arraytypes.c.src'),
             join('src', 'multiarray', 'array_assign.c'),
@@ -797,6 +806,8 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'shape.c'),
             join('src', 'multiarray', 'scalarapi.c'),
             join('src', 'multiarray', 'scalartypes.c.src'),
+            join('src', 'multiarray', 'textreader.c'),
+            join('src', 'multiarray', 'textwriter.c'),
             join('src', 'multiarray', 'usertypes.c')]
 
     if PYTHON_HAS_UNICODE_WIDE:
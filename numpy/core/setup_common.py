@@ -106,6 +106,9 @@ C99_FUNCS = ["sin", "cos", "tan", "sinh", "cosh", "tanh", "fabs", "floor",
         "hypot", "atan2", "pow", "fmod", "modf", 'frexp', 'ldexp',
         "exp2", "log2", "copysign", "nextafter"]
 
+# Functions used by the optional data allocation policies, if available
+OPTIONAL_MEMFUNCS = ["madvise"]
+
 C99_FUNCS_SINGLE = [f + 'f' for f in C99_FUNCS]
 C99_FUNCS_EXTENDED = [f + 'l' for f in C99_FUNCS]
 
@@ -174,7 +174,7 @@ def atleast_3d(*arys):
         return res
 
 
-def vstack(tup):
+def vstack(tup, nthreads=1):
     """
     Stack arrays in sequence vertically (row wise).
 
@@ -186,6 +186,10 @@ def vstack(tup):
     tup : sequence of ndarrays
         Tuple containing arrays to be stacked. The arrays must have the same
         shape along all but the first axis.
+    nthreads : int, optional
+        The number of threads copying the arrays, see `concatenate`.
+        Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -223,9 +227,9 @@ def vstack(tup):
            [4]])
 
     """
-    return _nx.concatenate(map(atleast_2d,tup),0)
+    return _nx.concatenate(map(atleast_2d,tup), 0, nthreads)
 
-def hstack(tup):
+def hstack(tup, nthreads=1):
     """
     Stack arrays in sequence horizontally (column wise).
 
@@ -236,6 +240,10 @@ def hstack(tup):
     ----------
     tup : sequence of ndarrays
         All arrays must have the same shape along all but the second axis.
+    nthreads : int, optional
+        The number of threads copying the arrays, see `concatenate`.
+        Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -270,7 +278,7 @@ def hstack(tup):
     arrs = map(atleast_1d,tup)
     # As a special case, dimension 0 of 1-dimensional arrays is "horizontal"
     if arrs[0].ndim == 1:
-        return _nx.concatenate(arrs, 0)
+        return _nx.concatenate(arrs, 0, nthreads)
     else:
-        return _nx.concatenate(arrs, 1)
+        return _nx.concatenate(arrs, 1, nthreads)
 
@@ -0,0 +1,853 @@
+/*
+ * This file implements the allocation of array data through a
+ * replaceable handler, together with a few built-in allocation
+ * policies.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+#include "pythread.h"
+
+#ifdef HAVE_MADVISE
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "alloc.h"
+#include "array_assign.h"
+
+/*
+ * Alignment used by the 'aligned' and 'hugepage' policies, which is
+ * the size of a cache line on most current CPUs, and enough for any
+ * vector load or store.
+ */
+#define NPY_DATA_ALIGNMENT 64
+
+/*
+ * The 'hugepage' policy aligns blocks of at least this many bytes to
+ * the huge page size, and asks the kernel to back them with huge pages.
+ */
+#define NPY_HUGEPAGE_SIZE (2*1024*1024)
+#define NPY_HUGEPAGE_THRESHOLD (4*1024*1024)
+
+/*
+ * The default policy, which uses the C library allocator.
+ */
+
+static void *
+default_malloc(void *NPY_UNUSED(ctx), size_t size)
+{
+    return malloc(size);
+}
+
+static void *
+default_calloc(void *NPY_UNUSED(ctx), size_t nelem, size_t elsize)
+{
+    return calloc(nelem, elsize);
+}
+
+static void *
+default_realloc(void *NPY_UNUSED(ctx), void *ptr, size_t new_size)
+{
+    return realloc(ptr, new_size);
+}
+
+static void
+default_free(void *NPY_UNUSED(ctx), void *ptr)
+{
+    free(ptr);
+}
+
+/*
+ * The 'aligned' and 'hugepage' policies. Their blocks are carved out of
+ * a larger block from the C library allocator, whose address is stored
+ * just before the aligned block, so zeroed blocks can come from calloc,
+ * which maps fresh zero pages for large blocks instead of clearing them.
+ *
+ * The 'ctx' of these handlers points to the minimum size, in bytes,
+ * above which a block gets huge page alignment and advice, or is NULL
+ * to never use huge pages.
+ */
+
+static size_t
+aligned_alignment(void *ctx, size_t size)
+{
+    if (ctx != NULL && size >= *(size_t *)ctx) {
+        return NPY_HUGEPAGE_SIZE;
+    }
+    return NPY_DATA_ALIGNMENT;
+}
+
+static void
+aligned_advise(void *ctx, void *ptr, size_t size)
+{
+#if defined(HAVE_MADVISE) && defined(MADV_HUGEPAGE)
+    if (ptr != NULL && ctx != NULL && size >= *(size_t *)ctx) {
+        /* The advice is only a hint, so ignore any failure */
+        madvise(ptr, size, MADV_HUGEPAGE);
+    }
+#endif
+}
+
+/* The offset of the aligned block inside the raw block 'raw' */
+static npy_uintp
+aligned_offset(void *raw, size_t alignment)
+{
+    npy_uintp ptr = (npy_uintp)raw + sizeof(void *);
+
+    return ptr + (alignment - ptr % alignment) % alignment - (npy_uintp)raw;
+}
+
+/*
+ * Returns the aligned block inside the raw block 'raw', and stores
+ * 'raw' just before it.
+ */
+static void *
+aligned_place(void *raw, size_t alignment)
+{
+    void **ptr = (void **)((char *)raw + aligned_offset(raw, alignment));
+
+    ptr[-1] = raw;
+    return ptr;
+}
+
+/*
+ * The size of a raw block with 'extra' bytes in front of 'size' bytes,
+ * or 0 if it overflows.
+ */
+static size_t
+aligned_raw_size(size_t size, size_t extra)
+{
+    return (size > (size_t)-1 - extra) ? 0 : size + extra;
+}
+
+static void *
+aligned_malloc(void *ctx, size_t size)
+{
+    size_t alignment = aligned_alignment(ctx, size);
+    size_t raw_size = aligned_raw_size(size, alignment + sizeof(void *));
+    void *raw, *ptr;
+
+    raw = (raw_size != 0) ? malloc(raw_size) : NULL;
+    if (raw == NULL) {
+        return NULL;
+    }
+    ptr = aligned_place(raw, alignment);
+    aligned_advise(ctx, ptr, size);
+    return ptr;
+}
+
+static void *
+aligned_calloc(void *ctx, size_t nelem, size_t elsize)
+{
+    size_t size = nelem * elsize, alignment, raw_size;
+    void *raw, *ptr;
+
+    if (elsize != 0 && size / elsize != nelem) {
+        return NULL;
+    }
+    alignment = aligned_alignment(ctx, size);
+    raw_size = aligned_raw_size(size, alignment + sizeof(void *));
+    raw = (raw_size != 0) ? calloc(raw_size, 1) : NULL;
+    if (raw == NULL) {
+        return NULL;
+    }
+    ptr = aligned_place(raw, alignment);
+    aligned_advise(ctx, ptr, size);
+    return ptr;
+}
+
+static void *
+aligned_realloc(void *ctx, void *ptr, size_t new_size)
+{
+    size_t alignment = aligned_alignment(ctx, new_size), raw_size;
+    void *raw, *new_raw;
+    npy_uintp offset, new_offset;
+
+    if (ptr == NULL) {
+        return aligned_malloc(ctx, new_size);
+    }
+    raw = ((void **)ptr)[-1];
+    offset = (char *)ptr - (char *)raw;
+    /* Leave room to read the data at either offset */
+    raw_size = aligned_raw_size(new_size,
+                        NPY_MAX(offset, alignment + sizeof(void *)));
+    new_raw = (raw_size != 0) ? realloc(raw, raw_size) : NULL;
+    if (new_raw == NULL) {
+        return NULL;
+    }
+
+    /*
+     * realloc doesn't preserve the alignment, so move the data if it
+     * was lost.
+     */
+    new_offset = aligned_offset(new_raw, alignment);
+    if (new_offset != offset) {
+        memmove((char *)new_raw + new_offset, (char *)new_raw + offset,
+                                                            new_size);
+    }
+    ptr = aligned_place(new_raw, alignment);
+    aligned_advise(ctx, ptr, new_size);
+    return ptr;
+}
+
+static void
+aligned_free(void *NPY_UNUSED(ctx), void *ptr)
+{
+    if (ptr != NULL) {
+        free(((void **)ptr)[-1]);
+    }
+}
+
+static size_t hugepage_threshold = NPY_HUGEPAGE_THRESHOLD;
+
+static PyDataMem_Handler default_handler = {
+    "default",
+    NULL,
+    &default_malloc,
+    &default_calloc,
+    &default_realloc,
+    &default_free
+};
+
+static PyDataMem_Handler aligned_handler = {
+    "aligned",
+    NULL,
+    &aligned_malloc,
+    &aligned_calloc,
+    &aligned_realloc,
+    &aligned_free
+};
+
+static PyDataMem_Handler hugepage_handler = {
+    "hugepage",
+    &hugepage_threshold,
+    &aligned_malloc,
+    &aligned_calloc,
+    &aligned_realloc,
+    &aligned_free
+};
+
+static PyDataMem_Handler *builtin_handlers[] = {
+    &default_handler,
+    &aligned_handler,
+    &hugepage_handler,
+    NULL
+};
+
+static PyDataMem_Handler *current_handler = &default_handler;
+
+/*
+ * The handler which allocated each block of array data, for the blocks
+ * not allocated by the default handler. A block is always resized and
+ * released by the handler which allocated it, whichever handler is
+ * current at the time, and a block which isn't in the table belongs to
+ * the default handler. So the table stays empty until another handler
+ * is installed.
+ *
+ * The table is an open addressing hash table with linear probing, at
+ * most half full. Array data is also allocated and released without
+ * the GIL, so it is protected by its own lock.
+ */
+typedef struct {
+    void *ptr;
+    PyDataMem_Handler *handler;
+} block_owner;
+
+#define NPY_OWNERS_MINSIZE 64
+
+static block_owner *owners = NULL;
+static npy_uintp owners_size = 0, owners_used = 0;
+static PyThread_type_lock owners_lock = NULL;
+
+static npy_uintp
+owner_slot(void *ptr)
+{
+    return (((npy_uintp)ptr >> 4) * 2654435761u) & (owners_size - 1);
+}
+
+/* Returns the slot of 'ptr', or of the empty slot where it would go */
+static npy_uintp
+find_owner(void *ptr)
+{
+    npy_uintp i = owner_slot(ptr);
+
+    while (owners[i].ptr != NULL && owners[i].ptr != ptr) {
+        i = (i + 1) & (owners_size - 1);
+    }
+    return i;
+}
+
+/*
+ * Records 'handler' as the owner of 'ptr'. Returns -1 if the table is
+ * full and can't grow.
+ */
+static int
+insert_owner(void *ptr, PyDataMem_Handler *handler)
+{
+    npy_uintp i;
+
+    if (2*(owners_used + 1) > owners_size) {
+        npy_uintp new_size = NPY_MAX(2*owners_size, NPY_OWNERS_MINSIZE);
+        block_owner *old = owners, *new_owners;
+        npy_uintp old_size = owners_size;
+
+        new_owners = calloc(new_size, sizeof(block_owner));
+        if (new_owners != NULL) {
+            owners = new_owners;
+            owners_size = new_size;
+            for (i = 0; i < old_size; ++i) {
+                if (old[i].ptr != NULL) {
+                    owners[find_owner(old[i].ptr)] = old[i];
+                }
+            }
+            free(old);
+        }
+        else if (owners_used + 1 >= owners_size) {
+            return -1;
+        }
+    }
+
+    i = find_owner(ptr);
+    if (owners[i].ptr == NULL) {
+        ++owners_used;
+    }
+    owners[i].ptr = ptr;
+    owners[i].handler = handler;
+    return 0;
+}
+
+/*
+ * Removes 'ptr' from the table, returning its owner, or NULL if it
+ * wasn't in the table.
+ */
+static PyDataMem_Handler *
+remove_owner(void *ptr)
+{
+    npy_uintp i, j, k, mask = owners_size - 1;
+    PyDataMem_Handler *handler;
+
+    if (owners_used == 0) {
+        return NULL;
+    }
+    i = find_owner(ptr);
+    if (owners[i].ptr == NULL) {
+        return NULL;
+    }
+    handler = owners[i].handler;
+
+    /*
+     * Move the following entries of the run back into the gap, unless
+     * that would put them before their own slot.
+     */
+    for (j = (i + 1) & mask; owners[j].ptr != NULL; j = (j + 1) & mask) {
+        k = owner_slot(owners[j].ptr);
+        if ((j > i) ? (k <= i || k > j) : (k <= i && k > j)) {
+            owners[i] = owners[j];
+            i = j;
+        }
+    }
+    owners[i].ptr = NULL;
+    --owners_used;
+    return handler;
+}
+
+/*
+ * Forgets the block 'ptr', returning the handler which allocated it.
+ */
+static PyDataMem_Handler *
+forget_block(void *ptr)
+{
+    PyDataMem_Handler *handler = NULL;
+
+    if (owners_lock == NULL || ptr == NULL) {
+        return &default_handler;
+    }
+    PyThread_acquire_lock(owners_lock, WAIT_LOCK);
+    handler = remove_owner(ptr);
+    PyThread_release_lock(owners_lock);
+    return (handler != NULL) ? handler : &default_handler;
+}
+
+/*
+ * Records that 'handler' allocated 'ptr', or releases it and returns
+ * NULL if that fails. A block from the default handler is not recorded.
+ */
+static void *
+record_block(void *ptr, PyDataMem_Handler *handler)
+{
+    int failed;
+
+    if (ptr == NULL || handler == &default_handler) {
+        return ptr;
+    }
+    PyThread_acquire_lock(owners_lock, WAIT_LOCK);
+    failed = insert_owner(ptr, handler) < 0;
+    PyThread_release_lock(owners_lock);
+    if (failed) {
+        handler->free(handler->ctx, ptr);
+        return NULL;
+    }
+    return ptr;
+}
+
+/*
+ * A cache of recently freed small data blocks and dimension/stride
+ * blocks, used by the array constructor and destructor to avoid going
+ * through the allocator for the many small temporaries of an
+ * expression. Data blocks are binned by their exact size in bytes,
+ * dimension blocks by the number of dimensions they were created for.
+ * The cache is only used with the GIL held.
+ */
+#define NPY_ALLOC_CACHE_MAX 64
+#define NPY_ALLOC_CACHE_DEFAULT 8
+#define NPY_DATA_CACHE_NBUCKETS 1024
+#define NPY_DIM_CACHE_NBUCKETS (NPY_MAXDIMS + 1)
+
+typedef struct {
+    npy_intp available;
+    void *ptrs[NPY_ALLOC_CACHE_MAX];
+} cache_bucket;
+
+static cache_bucket datacache[NPY_DATA_CACHE_NBUCKETS];
+static cache_bucket dimcache[NPY_DIM_CACHE_NBUCKETS];
+
+/* The maximum number of blocks kept in each bucket */
+static npy_intp alloc_cache_size = NPY_ALLOC_CACHE_DEFAULT;
+
+static npy_uintp data_cache_hits = 0, data_cache_misses = 0;
+static npy_uintp dim_cache_hits = 0, dim_cache_misses = 0;
+
+static void
+dim_free(void *ptr)
+{
+    PyDimMem_FREE(ptr);
+}
+
+/*
+ * Releases the blocks above 'size' in each of the 'nbuckets' buckets
+ * of 'cache' with 'dealloc'.
+ */
+static void
+trim_cache(cache_bucket *cache, npy_intp nbuckets, npy_intp size,
+                                        void (*dealloc)(void *))
+{
+    npy_intp i;
+
+    for (i = 0; i < nbuckets; ++i) {
+        while (cache[i].available > size) {
+            dealloc(cache[i].ptrs[--cache[i].available]);
+        }
+    }
+}
+
+/*NUMPY_API
+ * Allocates memory for array data.
+ */
+NPY_NO_EXPORT void *
+PyDataMem_NEW(size_t size)
+{
+    PyDataMem_Handler *handler = current_handler;
+
+    return record_block(handler->malloc(handler->ctx, size), handler);
+}
+
+/*NUMPY_API
+ * Allocates zero-initialized memory for array data.
+ */
+NPY_NO_EXPORT void *
+PyDataMem_NEW_ZEROED(size_t nelem, size_t elsize)
+{
+    PyDataMem_Handler *handler = current_handler;
+
+    return record_block(handler->calloc(handler->ctx, nelem, elsize),
+                        handler);
+}
+
+/*NUMPY_API
+ * Frees memory for array data, with the handler which allocated it.
+ */
+NPY_NO_EXPORT void
+PyDataMem_FREE(void *ptr)
+{
+    PyDataMem_Handler *handler = forget_block(ptr);
+
+    handler->free(handler->ctx, ptr);
+}
+
+/*NUMPY_API
+ * Reallocates/resizes memory for array data, with the handler which
+ * allocated it.
+ */
+NPY_NO_EXPORT void *
+PyDataMem_RENEW(void *ptr, size_t size)
+{
+    PyDataMem_Handler *handler;
+    void *new_ptr;
+
+    if (ptr == NULL) {
+        return PyDataMem_NEW(size);
+    }
+    /*
+     * Forget the block first, since once it is resized its address may
+     * be handed out again. Recording one block after forgetting another
+     * can't fail.
+     */
+    handler = forget_block(ptr);
+    new_ptr = handler->realloc(handler->ctx, ptr, size);
+    if (new_ptr == NULL) {
+        record_block(ptr, handler);
+        return NULL;
+    }
+    return record_block(new_ptr, handler);
+}
+
+/*NUMPY_API
+ * Sets the handler used to allocate array data, returning the
+ * previous one. Passing NULL restores the default handler, which
+ * uses malloc and free. Returns NULL with an exception set on failure.
+ *
+ * Each block of array data is released by the handler which allocated
+ * it, so handlers can be switched while arrays are alive. The handler
+ * struct must outlive all the memory it allocated.
+ */
+NPY_NO_EXPORT PyDataMem_Handler *
+PyDataMem_SetHandler(PyDataMem_Handler *handler)
+{
+    PyDataMem_Handler *old_handler = current_handler;
+
+    if (handler == NULL) {
+        handler = &default_handler;
+    }
+    if (handler != &default_handler && owners_lock == NULL) {
+        owners_lock = PyThread_allocate_lock();
+        if (owners_lock == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+    }
+
+    /* Let new arrays get their data from the new handler */
+    trim_cache(datacache, NPY_DATA_CACHE_NBUCKETS, 0, &PyDataMem_FREE);
+    current_handler = handler;
+    return old_handler;
+}
+
+/*NUMPY_API
+ * Returns the handler currently used to allocate array data.
+ */
+NPY_NO_EXPORT PyDataMem_Handler *
+PyDataMem_GetHandler(void)
+{
+    return current_handler;
+}
+
+/*
+ * Allocates 'sz' bytes of array data, reusing a cached block of
+ * exactly that size if one is available.
+ */
+NPY_NO_EXPORT void *
+npy_alloc_cache(npy_uintp sz)
+{
+    if (sz < NPY_DATA_CACHE_NBUCKETS) {
+        if (datacache[sz].available > 0) {
+            ++data_cache_hits;
+            return datacache[sz].ptrs[--datacache[sz].available];
+        }
+        ++data_cache_misses;
+    }
+    return PyDataMem_NEW(sz);
+}
+
+/*
+ * Allocates 'sz' bytes of zero-initialized array data. Cached blocks
+ * are cleared explicitly, larger blocks come from the zeroing
+ * allocation of the handler, which can map fresh zero pages.
+ */
+NPY_NO_EXPORT void *
+npy_alloc_cache_zero(npy_uintp sz)
+{
+    void *p;
+
+    if (sz < NPY_DATA_CACHE_NBUCKETS) {
+        p = npy_alloc_cache(sz);
+        if (p != NULL) {
+            memset(p, 0, sz);
+        }
+        return p;
+    }
+    return PyDataMem_NEW_ZEROED(sz, 1);
+}
+
+/*
+ * Releases array data allocated with npy_alloc_cache or PyDataMem_NEW,
+ * where 'sz' is at most the size the block was allocated with.
+ */
+NPY_NO_EXPORT void
+npy_free_cache(void *p, npy_uintp sz)
+{
+    if (p != NULL && sz > 0 && sz < NPY_DATA_CACHE_NBUCKETS &&
+                        datacache[sz].available < alloc_cache_size) {
+        datacache[sz].ptrs[datacache[sz].available++] = p;
+        return;
+    }
+    PyDataMem_FREE(p);
+}
+
+/*
+ * Allocates a block for the dimensions, strides and NA mask strides of
+ * an array with 'nd' dimensions, as PyDimMem_NEW(3*nd) does.
+ */
+NPY_NO_EXPORT npy_intp *
+npy_alloc_cache_dim(int nd)
+{
+    if (nd >= 0 && nd < NPY_DIM_CACHE_NBUCKETS) {
+        if (dimcache[nd].available > 0) {
+            ++dim_cache_hits;
+            return dimcache[nd].ptrs[--dimcache[nd].available];
+        }
+        ++dim_cache_misses;
+    }
+    return PyDimMem_NEW(3*nd);
+}
+
+/*
+ * Releases a dimensions block of an array with 'nd' dimensions, which
+ * must have room for at least 3*nd values.
+ */
+NPY_NO_EXPORT void
+npy_free_cache_dim(npy_intp *p, int nd)
+{
+    if (p != NULL && nd >= 0 && nd < NPY_DIM_CACHE_NBUCKETS &&
+                        dimcache[nd].available < alloc_cache_size) {
+        dimcache[nd].ptrs[dimcache[nd].available++] = p;
+        return;
+    }
+    PyDimMem_FREE(p);
+}
+
+NPY_NO_EXPORT PyObject *
+array_set_alloc_cache_size(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    npy_intp old_size = alloc_cache_size;
+    int size;
+
+    if (!PyArg_ParseTuple(args, "i:set_alloc_cache_size", &size)) {
+        return NULL;
+    }
+    if (size < 0 || size > NPY_ALLOC_CACHE_MAX) {
+        PyErr_Format(PyExc_ValueError,
+                "allocation cache size must be between 0 and %d",
+                NPY_ALLOC_CACHE_MAX);
+        return NULL;
+    }
+
+    alloc_cache_size = size;
+    trim_cache(datacache, NPY_DATA_CACHE_NBUCKETS, size, &PyDataMem_FREE);
+    trim_cache(dimcache, NPY_DIM_CACHE_NBUCKETS, size, &dim_free);
+
+    return PyInt_FromLong((long)old_size);
+}
+
+NPY_NO_EXPORT PyObject *
+array_alloc_cache_stats(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    int reset = 0;
+    npy_intp i, data_cached = 0, dim_cached = 0;
+
+    if (!PyArg_ParseTuple(args, "|i:alloc_cache_stats", &reset)) {
+        return NULL;
+    }
+
+    for (i = 0; i < NPY_DATA_CACHE_NBUCKETS; ++i) {
+        data_cached += datacache[i].available;
+    }
+    for (i = 0; i < NPY_DIM_CACHE_NBUCKETS; ++i) {
+        dim_cached += dimcache[i].available;
+    }
+
+    if (reset) {
+        data_cache_hits = data_cache_misses = 0;
+        dim_cache_hits = dim_cache_misses = 0;
+    }
+
+    return Py_BuildValue("{s:i,s:K,s:K,s:n,s:K,s:K,s:n}",
+            "size", (int)alloc_cache_size,
+            "data_hits", (unsigned PY_LONG_LONG)data_cache_hits,
+            "data_misses", (unsigned PY_LONG_LONG)data_cache_misses,
+            "data_cached", (Py_ssize_t)data_cached,
+            "dim_hits", (unsigned PY_LONG_LONG)dim_cache_hits,
+            "dim_misses", (unsigned PY_LONG_LONG)dim_cache_misses,
+            "dim_cached", (Py_ssize_t)dim_cached);
+}
+
+/*
+ * Returns the built-in handler called 'name', or NULL.
+ */
+static PyDataMem_Handler *
+find_builtin_handler(const char *name)
+{
+    PyDataMem_Handler **handler;
+
+    for (handler = builtin_handlers; *handler != NULL; ++handler) {
+        if (strcmp((*handler)->name, name) == 0) {
+            return *handler;
+        }
+    }
+    return NULL;
+}
+
+NPY_NO_EXPORT PyObject *
+array_set_data_allocator(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    char *name;
+    PyDataMem_Handler *handler;
+
+    if (!PyArg_ParseTuple(args, "s:set_data_allocator", &name)) {
+        return NULL;
+    }
+
+    handler = find_builtin_handler(name);
+    if (handler == NULL) {
+        PyErr_Format(PyExc_ValueError,
+                "unknown data allocator '%s', must be one of "
+                "'default', 'aligned' or 'hugepage'", name);
+        return NULL;
+    }
+
+    handler = PyDataMem_SetHandler(handler);
+    if (handler == NULL) {
+        return NULL;
+    }
+    return PyUString_FromString(handler->name);
+}
+
+NPY_NO_EXPORT PyObject *
+array_get_data_allocator(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, ":get_data_allocator")) {
+        return NULL;
+    }
+
+    return PyUString_FromString(current_handler->name);
+}
+
+/* The advice is discarded on platforms without madvise */
+#ifdef HAVE_MADVISE
+#define NPY_MADV(advice) (advice)
+#else
+#define NPY_MADV(advice) 0
+#endif
+
+/*
+ * 'dontneed' throws anonymous memory away, so it is only passed on for
+ * the memory of a memory mapped file, which is read back from the file.
+ */
+static const struct {
+    const char *name;
+    int advice;
+    int mmap_only;
+} madvise_names[] = {
+    {"normal", NPY_MADV(MADV_NORMAL), 0},
+    {"random", NPY_MADV(MADV_RANDOM), 0},
+    {"sequential", NPY_MADV(MADV_SEQUENTIAL), 0},
+    {"willneed", NPY_MADV(MADV_WILLNEED), 0},
+    {"dontneed", NPY_MADV(MADV_DONTNEED), 1},
+    {NULL, 0, 0}
+};
+
+/*
+ * Returns 1 if the memory of 'arr' belongs to an mmap.mmap object, 0 if
+ * not, and -1 on error.
+ */
+static int
+array_is_mmap(PyArrayObject *arr)
+{
+    static PyObject *mmap_type = NULL;
+    PyObject *base = (PyObject *)arr;
+
+    if (mmap_type == NULL) {
+        PyObject *mod = PyImport_ImportModule("mmap");
+
+        if (mod == NULL) {
+            return -1;
+        }
+        mmap_type = PyObject_GetAttrString(mod, "mmap");
+        Py_DECREF(mod);
+        if (mmap_type == NULL) {
+            return -1;
+        }
+    }
+
+    while (PyArray_Check(base) &&
+                    PyArray_BASE((PyArrayObject *)base) != NULL) {
+        base = PyArray_BASE((PyArrayObject *)base);
+    }
+    return PyObject_IsInstance(base, mmap_type);
+}
+
+NPY_NO_EXPORT PyObject *
+array_madvise(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyArrayObject *arr;
+    char *name;
+    int i;
+
+    if (!PyArg_ParseTuple(args, "O!s:_madvise", &PyArray_Type, &arr, &name)) {
+        return NULL;
+    }
+    for (i = 0; madvise_names[i].name != NULL; ++i) {
+        if (strcmp(madvise_names[i].name, name) == 0) {
+            break;
+        }
+    }
+    if (madvise_names[i].name == NULL) {
+        PyErr_Format(PyExc_ValueError,
+                "unknown advice '%s', must be one of 'normal', 'random', "
+                "'sequential', 'willneed' or 'dontneed'", name);
+        return NULL;
+    }
+    if (madvise_names[i].mmap_only) {
+        int is_mmap = array_is_mmap(arr);
+
+        if (is_mmap < 0) {
+            return NULL;
+        }
+        if (!is_mmap) {
+            PyErr_Format(PyExc_ValueError,
+                    "advice '%s' is only allowed for the memory of a "
+                    "memory mapped file", name);
+            return NULL;
+        }
+    }
+
+#ifdef HAVE_MADVISE
+    {
+        npy_uintp start, end, page;
+
+        get_array_memory_extents(arr, &start, &end);
+        /*
+         * Only advise on the pages which are entirely part of the array,
+         * since the others also hold memory which isn't the array's.
+         */
+        page = (npy_uintp)sysconf(_SC_PAGESIZE);
+        start += (page - start % page) % page;
+        end -= end % page;
+        if (start < end) {
+            /* The advice is only a hint, so ignore any failure */
+            madvise((void *)start, end - start, madvise_names[i].advice);
+        }
+    }
+#endif
+    Py_INCREF(Py_None);
+    return Py_None;
+}
@@ -0,0 +1,54 @@
+#ifndef _NPY_PRIVATE__ALLOC_H_
+#define _NPY_PRIVATE__ALLOC_H_
+
+/*
+ * Allocation of array data and dimensions through a small cache of
+ * recently freed blocks. Only to be called with the GIL held.
+ */
+NPY_NO_EXPORT void *
+npy_alloc_cache(npy_uintp sz);
+
+NPY_NO_EXPORT void *
+npy_alloc_cache_zero(npy_uintp sz);
+
+NPY_NO_EXPORT void
+npy_free_cache(void *p, npy_uintp sz);
+
+NPY_NO_EXPORT npy_intp *
+npy_alloc_cache_dim(int nd);
+
+NPY_NO_EXPORT void
+npy_free_cache_dim(npy_intp *p, int nd);
+
+/*
+ * Python wrapper for selecting one of the built-in data allocation
+ * policies by name. Returns the name of the previous policy.
+ */
+NPY_NO_EXPORT PyObject *
+array_set_data_allocator(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/* Python wrapper returning the name of the current data allocator */
+NPY_NO_EXPORT PyObject *
+array_get_data_allocator(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * Python wrapper setting the number of blocks kept per size in the
+ * allocation cache. Returns the previous number.
+ */
+NPY_NO_EXPORT PyObject *
+array_set_alloc_cache_size(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/* Python wrapper returning a dict of allocation cache statistics */
+NPY_NO_EXPORT PyObject *
+array_alloc_cache_stats(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * Python wrapper passing advice about the use of the memory holding an
+ * array, usually a memory map, to madvise, for the pages entirely inside
+ * the array. 'dontneed' is refused unless the memory belongs to an
+ * mmap.mmap object. Does nothing on platforms without madvise.
+ */
+NPY_NO_EXPORT PyObject *
+array_madvise(PyObject *NPY_UNUSED(self), PyObject *args);
+
+#endif
@@ -88,6 +88,11 @@ broadcast_strides(int ndim, npy_intp *shape,
 NPY_NO_EXPORT int
 raw_array_is_aligned(int ndim, char *data, npy_intp *strides, int alignment);
 
+/* Gets a half-open range [start, end) which contains the array data */
+NPY_NO_EXPORT void
+get_array_memory_extents(PyArrayObject *arr,
+                    npy_uintp *out_start, npy_uintp *out_end);
+
 /* Returns 1 if the arrays have overlapping data, 0 otherwise */
 NPY_NO_EXPORT int
 arrays_overlap(PyArrayObject *arr1, PyArrayObject *arr2);
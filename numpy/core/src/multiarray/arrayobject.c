@@ -52,6 +52,7 @@ maintainer email:  oliphant.travis@ieee.org
 #include "buffer.h"
 #include "na_object.h"
 #include "na_mask.h"
+#include "alloc.h"
 
 /*NUMPY_API
   Compute the size of an array (in number of items)
@@ -399,18 +400,18 @@ array_dealloc(PyArrayObject *self)
              * self already...
              */
         }
-        PyDataMem_FREE(fa->data);
+        npy_free_cache(fa->data, PyArray_NBYTES(self));
     }
 
     /* If the array has an NA mask, free its associated data */
     if (fa->flags & NPY_ARRAY_MASKNA) {
         Py_XDECREF(fa->maskna_dtype);
         if (fa->flags & NPY_ARRAY_OWNMASKNA) {
-            PyDataMem_FREE(fa->maskna_data);
+            PyArray_free(fa->maskna_data);
         }
     }
 
-    PyDimMem_FREE(fa->dimensions);
+    npy_free_cache_dim(fa->dimensions, fa->nd);
     Py_DECREF(fa->descr);
     Py_TYPE(self)->tp_free((PyObject *)self);
 }
@@ -16,6 +16,7 @@
 #include "mapping.h"
 #include "lowlevel_strided_loops.h"
 #include "scalartypes.h"
+#include "textwriter.h"
 
 #include "convert.h"
 
@@ -159,6 +160,11 @@ PyArray_ToFile(PyArrayObject *self, FILE *fp, char *sep, char *format)
         /*
          * text data
          */
+        int ret = npy_tofile_text(self, fp, sep, format);
+
+        if (ret != 0) {
+            return (ret < 0) ? -1 : 0;
+        }
 
         it = (PyArrayIterObject *)
             PyArray_IterNew((PyObject *)self);
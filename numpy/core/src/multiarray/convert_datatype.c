@@ -1767,79 +1767,61 @@ PyArray_ObjectType(PyObject *op, int minimum_type)
     return ret;
 }
 
-/* Raises error when len(op) == 0 */
-
-/*NUMPY_API*/
-NPY_NO_EXPORT PyArrayObject **
-PyArray_ConvertToCommonType(PyObject *op, int *retn)
+/*
+ * The type PyArray_ConvertToCommonType converts the n items of the
+ * sequence op to. A scalar only changes the common type of the arrays
+ * when it is of another kind and cannot be coerced to it. If mps is not
+ * NULL, the scalars which are cast to the type by force are marked with
+ * Py_None in it, and *allscalars is set when no item is an array.
+ */
+NPY_NO_EXPORT PyArray_Descr *
+sequence_common_type(PyObject *op, int n, PyArrayObject **mps,
+                     int *allscalars)
 {
-    int i, n, allscalars = 0;
-    PyArrayObject **mps = NULL;
+    int i;
     PyObject *otmp;
     PyArray_Descr *intype = NULL, *stype = NULL;
     PyArray_Descr *newtype = NULL;
     NPY_SCALARKIND scalarkind = NPY_NOSCALAR, intypekind = NPY_NOSCALAR;
 
-    *retn = n = PySequence_Length(op);
-    if (n == 0) {
-        PyErr_SetString(PyExc_ValueError, "0-length sequence.");
-    }
-    if (PyErr_Occurred()) {
-        *retn = 0;
-        return NULL;
-    }
-    mps = (PyArrayObject **)PyDataMem_NEW(n*sizeof(PyArrayObject *));
-    if (mps == NULL) {
-        *retn = 0;
-        return (void*)PyErr_NoMemory();
-    }
-
-    if (PyArray_Check(op)) {
-        for (i = 0; i < n; i++) {
-            mps[i] = (PyArrayObject *) array_big_item((PyArrayObject *)op, i);
-        }
-        if (!PyArray_ISCARRAY((PyArrayObject *)op)) {
-            for (i = 0; i < n; i++) {
-                PyObject *obj;
-                obj = PyArray_NewCopy(mps[i], NPY_CORDER);
-                Py_DECREF(mps[i]);
-                mps[i] = (PyArrayObject *)obj;
-            }
-        }
-        return mps;
-    }
-
-    for (i = 0; i < n; i++) {
-        mps[i] = NULL;
-    }
-
+    *allscalars = 0;
     for (i = 0; i < n; i++) {
         otmp = PySequence_GetItem(op, i);
+        if (otmp == NULL) {
+            goto fail;
+        }
         if (!PyArray_CheckAnyScalar(otmp)) {
             newtype = PyArray_DescrFromObject(otmp, intype);
             Py_XDECREF(intype);
-            if (newtype == NULL) {
+            intype = newtype;
+            if (intype == NULL) {
+                Py_DECREF(otmp);
                 goto fail;
             }
-            intype = newtype;
             intypekind = PyArray_ScalarKind(intype->type_num, NULL);
         }
         else {
             newtype = PyArray_DescrFromObject(otmp, stype);
             Py_XDECREF(stype);
             stype = newtype;
+            if (stype == NULL) {
+                Py_DECREF(otmp);
+                goto fail;
+            }
             scalarkind = PyArray_ScalarKind(newtype->type_num, NULL);
-            mps[i] = (PyArrayObject *)Py_None;
-            Py_INCREF(Py_None);
+            if (mps != NULL) {
+                mps[i] = (PyArrayObject *)Py_None;
+                Py_INCREF(Py_None);
+            }
         }
-        Py_XDECREF(otmp);
+        Py_DECREF(otmp);
     }
-    if (intype==NULL) {
+    if (intype == NULL) {
         /* all scalars */
-        allscalars = 1;
+        *allscalars = 1;
         intype = stype;
         Py_INCREF(intype);
-        for (i = 0; i < n; i++) {
+        for (i = 0; mps != NULL && i < n; i++) {
             Py_XDECREF(mps[i]);
             mps[i] = NULL;
         }
@@ -1857,12 +1839,68 @@ PyArray_ConvertToCommonType(PyObject *op, int *retn)
             Py_XDECREF(intype);
             intype = newtype;
         }
-        for (i = 0; i < n; i++) {
+        for (i = 0; mps != NULL && i < n; i++) {
             Py_XDECREF(mps[i]);
             mps[i] = NULL;
         }
     }
+    Py_XDECREF(stype);
+    return intype;
+
+ fail:
+    Py_XDECREF(intype);
+    Py_XDECREF(stype);
+    return NULL;
+}
 
+/* Raises error when len(op) == 0 */
+
+/*NUMPY_API*/
+NPY_NO_EXPORT PyArrayObject **
+PyArray_ConvertToCommonType(PyObject *op, int *retn)
+{
+    int i, n, allscalars = 0;
+    PyArrayObject **mps = NULL;
+    PyObject *otmp;
+    PyArray_Descr *intype = NULL;
+
+    *retn = n = PySequence_Length(op);
+    if (n == 0) {
+        PyErr_SetString(PyExc_ValueError, "0-length sequence.");
+    }
+    if (PyErr_Occurred()) {
+        *retn = 0;
+        return NULL;
+    }
+    mps = (PyArrayObject **)PyDataMem_NEW(n*sizeof(PyArrayObject *));
+    if (mps == NULL) {
+        *retn = 0;
+        return (void*)PyErr_NoMemory();
+    }
+
+    if (PyArray_Check(op)) {
+        for (i = 0; i < n; i++) {
+            mps[i] = (PyArrayObject *) array_big_item((PyArrayObject *)op, i);
+        }
+        if (!PyArray_ISCARRAY((PyArrayObject *)op)) {
+            for (i = 0; i < n; i++) {
+                PyObject *obj;
+                obj = PyArray_NewCopy(mps[i], NPY_CORDER);
+                Py_DECREF(mps[i]);
+                mps[i] = (PyArrayObject *)obj;
+            }
+        }
+        return mps;
+    }
+
+    for (i = 0; i < n; i++) {
+        mps[i] = NULL;
+    }
+
+    intype = sequence_common_type(op, n, mps, &allscalars);
+    if (intype == NULL) {
+        goto fail;
+    }
 
     /* Make sure all arrays are actual array objects. */
     for (i = 0; i < n; i++) {
@@ -1885,12 +1923,10 @@ PyArray_ConvertToCommonType(PyObject *op, int *retn)
         }
     }
     Py_DECREF(intype);
-    Py_XDECREF(stype);
     return mps;
 
  fail:
     Py_XDECREF(intype);
-    Py_XDECREF(stype);
     *retn = 0;
     for (i = 0; i < n; i++) {
         Py_XDECREF(mps[i]);
@@ -10,6 +10,10 @@ PyArray_ObjectType(PyObject *op, int minimum_type);
 NPY_NO_EXPORT PyArrayObject **
 PyArray_ConvertToCommonType(PyObject *op, int *retn);
 
+NPY_NO_EXPORT PyArray_Descr *
+sequence_common_type(PyObject *op, int n, PyArrayObject **mps,
+                     int *allscalars);
+
 NPY_NO_EXPORT int
 PyArray_ValidType(int type);
 
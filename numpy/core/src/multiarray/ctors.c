@@ -25,6 +25,8 @@
 #include "_datetime.h"
 #include "datetime_strings.h"
 #include "na_object.h"
+#include "alloc.h"
+#include "numpyos.h"
 
 /*
  * Reading from a file or a string.
@@ -202,6 +204,299 @@ fromfile_skip_separator(FILE **fp, const char *sep, void *NPY_UNUSED(stream_data
     return result;
 }
 
+/*
+ * Buffered text reading.
+ *
+ * Instead of calling next_element and skip_separator for every element,
+ * the text is parsed in place from a block of memory: the string itself
+ * for fromstring, or a buffer which is refilled from the file in large
+ * blocks for fromfile. The matching rules are those of the string
+ * functions above. A scan which runs into the end of the part of a file
+ * read so far refills the buffer and starts over at the beginning of the
+ * element, so numbers and separators are never split between blocks.
+ */
+#define FROM_BUFFER_SIZE 4096
+#define FROM_TEXT_BLOCK (1 << 16)
+
+typedef struct {
+    FILE *fp;
+    char *buffer;
+    npy_intp size;
+    /* end of the text read so far, where a NUL is stored */
+    char *end;
+    int eof;
+} text_block;
+
+/*
+ * Move the text from *pos on to the front of the buffer, doubling its
+ * size if that leaves less than half of it free, and append the next
+ * block of the file.
+ *
+ * Returns 0 on success and -1 if out of memory.
+ */
+static int
+text_block_refill(text_block *b, char **pos)
+{
+    npy_intp keep = b->end - *pos;
+    size_t n, want;
+
+    if (keep > (b->size - 1) / 2) {
+        char *tmp = malloc(2 * b->size);
+
+        if (tmp == NULL) {
+            return -1;
+        }
+        memcpy(tmp, *pos, keep);
+        free(b->buffer);
+        b->buffer = tmp;
+        b->size *= 2;
+    }
+    else if (keep > 0) {
+        memmove(b->buffer, *pos, keep);
+    }
+    want = b->size - 1 - keep;
+    n = fread(b->buffer + keep, 1, want, b->fp);
+    if (n < want) {
+        b->eof = 1;
+    }
+    b->end = b->buffer + keep + n;
+    *b->end = '\0';
+    *pos = b->buffer;
+    return 0;
+}
+
+/*
+ * The end of a number is found by looking for whitespace or the first
+ * character of the separator, so the buffered reader is only used when
+ * that character cannot be part of a number.
+ */
+static int
+text_separator_ends_numbers(const char *sep)
+{
+    char c;
+
+    while (isspace(*sep)) {
+        sep++;
+    }
+    c = *sep;
+    return !((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+             (c >= 'A' && c <= 'Z') || c == '+' || c == '-' ||
+             c == '.' || c == '_' || c == '(' || c == ')');
+}
+
+/*
+ * Parse a signed number into the unsigned integer type of dtype at
+ * token, as the "%u" of its scanfunc does, wrapping negative values
+ * around. The fromstr of the unsigned types doesn't take a sign.
+ */
+static void
+text_fromstr_signed(char *token, char *dptr, char **endptr,
+                    PyArray_Descr *dtype)
+{
+    dtype->f->fromstr(token + 1, dptr, endptr, dtype);
+    if (*endptr == token + 1) {
+        /* Only a sign, which isn't a number */
+        *endptr = token;
+        return;
+    }
+    if (*token == '+') {
+        return;
+    }
+    switch (dtype->type_num) {
+        case NPY_UBYTE:
+            *(npy_ubyte *)dptr = (npy_ubyte)(0 - *(npy_ubyte *)dptr);
+            break;
+        case NPY_USHORT:
+            *(npy_ushort *)dptr = (npy_ushort)(0 - *(npy_ushort *)dptr);
+            break;
+        case NPY_UINT:
+            *(npy_uint *)dptr = 0 - *(npy_uint *)dptr;
+            break;
+        case NPY_ULONG:
+            *(npy_ulong *)dptr = 0 - *(npy_ulong *)dptr;
+            break;
+        case NPY_ULONGLONG:
+            *(npy_ulonglong *)dptr = 0 - *(npy_ulonglong *)dptr;
+            break;
+    }
+}
+
+/*
+ * Whether array_from_text_buffered can read a file into this type with
+ * the results of its scanfunc.
+ */
+static int
+text_buffered_scans(PyArray_Descr *dtype)
+{
+    return PyTypeNum_ISBOOL(dtype->type_num) ||
+           PyTypeNum_ISINTEGER(dtype->type_num) ||
+           PyTypeNum_ISFLOAT(dtype->type_num);
+}
+
+/*
+ * Create an array by parsing the text in [data, end), or if fp is not
+ * NULL, the rest of the file, which must be seekable. The file is left
+ * positioned after the text which was used, as array_from_text does.
+ */
+static PyArrayObject *
+array_from_text_buffered(PyArray_Descr *dtype, npy_intp num, char *sep,
+                         size_t *nread, FILE *fp, char *data, char *end)
+{
+    PyArrayObject *r;
+    char *dptr, *clean_sep, *tmp, *pos;
+    char stop;
+    int err = 0, native, scan_skips_space;
+    npy_intp size, elsize = dtype->elsize;
+    text_block b = {NULL, NULL, 0, NULL, 1};
+
+    size = (num >= 0) ? num : FROM_BUFFER_SIZE;
+    r = (PyArrayObject *)
+        PyArray_NewFromDescr(&PyArray_Type,
+                             dtype,
+                             1, &size,
+                             NULL, NULL,
+                             0, NULL);
+    if (r == NULL) {
+        return NULL;
+    }
+    clean_sep = swab_separator(sep);
+    for (pos = clean_sep; *pos == ' '; pos++) {
+    }
+    stop = *pos;
+    native = PyArray_ISNBO(dtype->byteorder);
+    /* fscanf of an integer does not count trailing whitespace as an item */
+    scan_skips_space = !PyTypeNum_ISFLOAT(dtype->type_num) &&
+                       !PyTypeNum_ISBOOL(dtype->type_num);
+
+    NPY_BEGIN_ALLOW_THREADS;
+    if (fp != NULL) {
+        b.fp = fp;
+        b.eof = 0;
+        b.size = FROM_TEXT_BLOCK + 1;
+        b.buffer = malloc(b.size);
+        if (b.buffer == NULL) {
+            err = 1;
+            goto done;
+        }
+        b.end = pos = b.buffer;
+        if (text_block_refill(&b, &pos) < 0) {
+            err = 1;
+            goto done;
+        }
+        end = b.end;
+    }
+    else {
+        pos = data;
+    }
+    dptr = PyArray_DATA(r);
+    while (num < 0 || (npy_intp)*nread < num) {
+        char *s = pos, *token, *tokend, *q;
+        int res;
+
+        /* The extent of the next number, which has no spaces or separator */
+        token = s;
+        while (token < end && NumPyOS_ascii_isspace(*token)) {
+            token++;
+        }
+        tokend = token;
+        while (tokend < end && *tokend != '\0' && *tokend != stop &&
+                                !NumPyOS_ascii_isspace(*tokend)) {
+            tokend++;
+        }
+        if (tokend == end && !b.eof) {
+            if (text_block_refill(&b, &pos) < 0) {
+                err = 1;
+                break;
+            }
+            end = b.end;
+            continue;
+        }
+        if (fp != NULL && token == end && (token == s || scan_skips_space)) {
+            /* The end of the file, like scanfunc returning EOF */
+            pos = token;
+            break;
+        }
+
+        switch (native ? dtype->type_num : NPY_NOTYPE) {
+            case NPY_DOUBLE:
+                *(npy_double *)dptr =
+                        NumPyOS_ascii_strtod_fast(token, tokend, &q);
+                break;
+            case NPY_FLOAT:
+                *(npy_float *)dptr =
+                        (npy_float)NumPyOS_ascii_strtod_fast(token, tokend, &q);
+                break;
+            default:
+                if (PyTypeNum_ISUNSIGNED(dtype->type_num) &&
+                                (*token == '+' || *token == '-')) {
+                    text_fromstr_signed(token, dptr, &q, dtype);
+                    if (q == token) {
+                        q = s;
+                    }
+                }
+                else {
+                    dtype->f->fromstr(s, dptr, &q, dtype);
+                }
+                break;
+        }
+        if (q > end) {
+            break;
+        }
+        res = fromstr_skip_separator(&q, clean_sep, end);
+        if (res == -1 && q >= end && !b.eof) {
+            if (text_block_refill(&b, &pos) < 0) {
+                err = 1;
+                break;
+            }
+            end = b.end;
+            continue;
+        }
+
+        *nread += 1;
+        dptr += elsize;
+        pos = q;
+        if (num < 0 && (npy_intp)*nread == size) {
+            size += size / 2;
+            tmp = PyDataMem_RENEW(PyArray_DATA(r), size * elsize);
+            if (tmp == NULL) {
+                err = 1;
+                break;
+            }
+            ((PyArrayObject_fields *)r)->data = tmp;
+            dptr = tmp + *nread * elsize;
+        }
+        if (res < 0) {
+            break;
+        }
+    }
+    if (fp != NULL && !err) {
+        /* Give back the text after the last separator which was used */
+        fseek(fp, -(long)(b.end - pos), SEEK_CUR);
+    }
+    if (num < 0 && !err) {
+        tmp = PyDataMem_RENEW(PyArray_DATA(r), NPY_MAX(*nread,1) * elsize);
+        if (tmp == NULL) {
+            err = 1;
+        }
+        else {
+            PyArray_DIMS(r)[0] = *nread;
+            ((PyArrayObject_fields *)r)->data = tmp;
+        }
+    }
+done:
+    NPY_END_ALLOW_THREADS;
+    free(b.buffer);
+    free(clean_sep);
+    if (err == 1) {
+        PyErr_NoMemory();
+    }
+    if (PyErr_Occurred()) {
+        Py_DECREF(r);
+        return NULL;
+    }
+    return r;
+}
+
 /*
  * Change a sub-array field to the base descriptor
  * and update the dimensions and strides
@@ -860,15 +1155,17 @@ discover_dimensions(PyObject *obj, int *maxndim, npy_intp *d, int check_it,
     return 0;
 }
 
-/*NUMPY_API
- * Generic new array creation routine.
+/*
+ * Implementation of PyArray_NewFromDescr. If 'zeroed' is true and
+ * 'data' is NULL, the data is allocated zero-initialized, which for
+ * large arrays lets the operating system supply the zero pages lazily.
  *
  * steals a reference to descr (even on failure)
  */
-NPY_NO_EXPORT PyObject *
-PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
-                     npy_intp *dims, npy_intp *strides, void *data,
-                     int flags, PyObject *obj)
+static PyObject *
+PyArray_NewFromDescr_int(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
+                         npy_intp *dims, npy_intp *strides, void *data,
+                         int flags, PyObject *obj, int zeroed)
 {
     PyArrayObject_fields *fa;
     int i;
@@ -887,9 +1184,9 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
         }
         nd =_update_descr_and_dimensions(&descr, newdims,
                                          newstrides, nd);
-        ret = PyArray_NewFromDescr(subtype, descr, nd, newdims,
-                                   newstrides,
-                                   data, flags, obj);
+        ret = PyArray_NewFromDescr_int(subtype, descr, nd, newdims,
+                                       newstrides,
+                                       data, flags, obj, zeroed);
         return ret;
     }
 
@@ -986,7 +1283,7 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
     fa->maskna_data = NULL;
 
     if (nd > 0) {
-        fa->dimensions = PyDimMem_NEW(3*nd);
+        fa->dimensions = npy_alloc_cache_dim(nd);
         if (fa->dimensions == NULL) {
             PyErr_NoMemory();
             goto fail;
@@ -1022,20 +1319,21 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
         if (sd == 0) {
             sd = descr->elsize;
         }
-        data = PyDataMem_NEW(sd);
-        if (data == NULL) {
-            PyErr_NoMemory();
-            goto fail;
-        }
-        fa->flags |= NPY_ARRAY_OWNDATA;
-
         /*
          * It is bad to have unitialized OBJECT pointers
          * which could also be sub-fields of a VOID array
          */
-        if (PyDataType_FLAGCHK(descr, NPY_NEEDS_INIT)) {
-            memset(data, 0, sd);
+        if (zeroed || PyDataType_FLAGCHK(descr, NPY_NEEDS_INIT)) {
+            data = npy_alloc_cache_zero(sd);
         }
+        else {
+            data = npy_alloc_cache(sd);
+        }
+        if (data == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+        fa->flags |= NPY_ARRAY_OWNDATA;
     }
     else {
         /*
@@ -1108,6 +1406,20 @@ PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
     return NULL;
 }
 
+/*NUMPY_API
+ * Generic new array creation routine.
+ *
+ * steals a reference to descr (even on failure)
+ */
+NPY_NO_EXPORT PyObject *
+PyArray_NewFromDescr(PyTypeObject *subtype, PyArray_Descr *descr, int nd,
+                     npy_intp *dims, npy_intp *strides, void *data,
+                     int flags, PyObject *obj)
+{
+    return PyArray_NewFromDescr_int(subtype, descr, nd, dims, strides,
+                                    data, flags, obj, 0);
+}
+
 /*NUMPY_API
  * Creates a new array with the same shape as the provided one,
  * with possible memory layout order and data type changes.
@@ -2992,17 +3304,20 @@ PyArray_Zeros(int nd, npy_intp *dims, PyArray_Descr *type, int is_f_order)
     if (!type) {
         type = PyArray_DescrFromType(NPY_DEFAULT_TYPE);
     }
-    ret = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
-                                                type,
-                                                nd, dims,
-                                                NULL, NULL,
-                                                is_f_order, NULL);
+    ret = (PyArrayObject *)PyArray_NewFromDescr_int(&PyArray_Type,
+                                                    type,
+                                                    nd, dims,
+                                                    NULL, NULL,
+                                                    is_f_order, NULL, 1);
     if (ret == NULL) {
         return NULL;
     }
-    if (_zerofill(ret) < 0) {
-        Py_DECREF(ret);
-        return NULL;
+
+    /* The data is zeroed already, only objects need filling in */
+    if (PyDataType_REFCHK(PyArray_DESCR(ret))) {
+        if (_zerofill(ret) < 0) {
+            return NULL;
+        }
     }
     return (PyObject *)ret;
 
@@ -3412,7 +3727,6 @@ array_fromfile_binary(FILE *fp, PyArray_Descr *dtype, npy_intp num, size_t *nrea
  * Create an array by reading from the given stream, using the passed
  * next_element and skip_separator functions.
  */
-#define FROM_BUFFER_SIZE 4096
 static PyArrayObject *
 array_from_text(PyArray_Descr *dtype, npy_intp num, char *sep, size_t *nread,
                 void *stream, next_element next, skip_separator skip_sep,
@@ -3422,9 +3736,7 @@ array_from_text(PyArray_Descr *dtype, npy_intp num, char *sep, size_t *nread,
     npy_intp i;
     char *dptr, *clean_sep, *tmp;
     int err = 0;
-    npy_intp thisbuf = 0;
     npy_intp size;
-    npy_intp bytes, totalbytes;
 
     size = (num >= 0) ? num : FROM_BUFFER_SIZE;
     r = (PyArrayObject *)
@@ -3438,25 +3750,22 @@ array_from_text(PyArray_Descr *dtype, npy_intp num, char *sep, size_t *nread,
     }
     clean_sep = swab_separator(sep);
     NPY_BEGIN_ALLOW_THREADS;
-    totalbytes = bytes = size * dtype->elsize;
     dptr = PyArray_DATA(r);
     for (i= 0; num < 0 || i < num; i++) {
         if (next(&stream, dptr, dtype, stream_data) < 0) {
             break;
         }
         *nread += 1;
-        thisbuf += 1;
         dptr += dtype->elsize;
-        if (num < 0 && thisbuf == size) {
-            totalbytes += bytes;
-            tmp = PyDataMem_RENEW(PyArray_DATA(r), totalbytes);
+        if (num < 0 && (npy_intp)*nread == size) {
+            size += size / 2;
+            tmp = PyDataMem_RENEW(PyArray_DATA(r), size * dtype->elsize);
             if (tmp == NULL) {
                 err = 1;
                 break;
             }
             ((PyArrayObject_fields *)r)->data = tmp;
-            dptr = tmp + (totalbytes - bytes);
-            thisbuf = 0;
+            dptr = tmp + *nread * dtype->elsize;
         }
         if (skip_sep(&stream, clean_sep, stream_data) < 0) {
             break;
@@ -3532,9 +3841,16 @@ PyArray_FromFile(FILE *fp, PyArray_Descr *dtype, npy_intp num, char *sep)
             Py_DECREF(dtype);
             return NULL;
         }
-        ret = array_from_text(dtype, num, sep, &nread, fp,
-                (next_element) fromfile_next_element,
-                (skip_separator) fromfile_skip_separator, NULL);
+        else if (text_buffered_scans(dtype) &&
+                 text_separator_ends_numbers(sep) && ftell(fp) >= 0) {
+            ret = array_from_text_buffered(dtype, num, sep, &nread,
+                                           fp, NULL, NULL);
+        }
+        else {
+            ret = array_from_text(dtype, num, sep, &nread, fp,
+                    (next_element) fromfile_next_element,
+                    (skip_separator) fromfile_skip_separator, NULL);
+        }
     }
     if (ret == NULL) {
         Py_DECREF(dtype);
@@ -3761,17 +4077,24 @@ PyArray_FromString(char *data, npy_intp slen, PyArray_Descr *dtype,
             Py_DECREF(dtype);
             return NULL;
         }
-        if (slen < 0) {
-            end = NULL;
+        if (dtype->f->fromstr != NULL && text_separator_ends_numbers(sep)) {
+            end = data + ((slen < 0) ? (npy_intp)strlen(data) : slen);
+            ret = array_from_text_buffered(dtype, num, sep, &nread,
+                                           NULL, data, end);
         }
         else {
-            end = data + slen;
+            if (slen < 0) {
+                end = NULL;
+            }
+            else {
+                end = data + slen;
+            }
+            ret = array_from_text(dtype, num, sep, &nread,
+                                  data,
+                                  (next_element) fromstr_next_element,
+                                  (skip_separator) fromstr_skip_separator,
+                                  end);
         }
-        ret = array_from_text(dtype, num, sep, &nread,
-                              data,
-                              (next_element) fromstr_next_element,
-                              (skip_separator) fromstr_skip_separator,
-                              end);
     }
     return (PyObject *)ret;
 }
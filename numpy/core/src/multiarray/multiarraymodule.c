@@ -17,6 +17,7 @@
 #define PY_SSIZE_T_CLEAN
 #include "Python.h"
 #include "structmember.h"
+#include "pythread.h"
 
 #define NPY_NO_DEPRECATED_API
 #define _MULTIARRAYMODULE
@@ -28,6 +29,10 @@
 
 #include "npy_config.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "numpy/npy_3kcompat.h"
 
 NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
@@ -55,6 +60,9 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "na_object.h"
 #include "na_mask.h"
 #include "reduction.h"
+#include "alloc.h"
+#include "textreader.h"
+#include "textwriter.h"
 
 /* Only here for API compatibility */
 NPY_NO_EXPORT PyTypeObject PyBigArray_Type;
@@ -307,10 +315,207 @@ PyArray_Free(PyObject *op, void *ptr)
 
 
 /*
- * Concatenates a list of ndarrays.
+ * Result size in bytes above which concatenate copies contiguous blocks
+ * with non-temporal stores. A result this big doesn't fit in the last
+ * level cache anyway, so writing around the cache avoids evicting the
+ * inputs that are still to be read.
+ */
+#define NPY_CONCATENATE_STREAM_THRESHOLD (8*1024*1024)
+
+/*
+ * Copies 'count' bytes from 'src' to 'dst', which must not overlap,
+ * using non-temporal stores for the 16-byte aligned part of the
+ * destination when 'stream' is true and SSE2 is available.
+ */
+static void
+concatenate_block_copy(char *dst, char *src, npy_intp count, int stream)
+{
+#ifdef __SSE2__
+    if (stream && count >= 64) {
+        npy_intp head = (16 - ((npy_uintp)dst & 15)) & 15;
+
+        memcpy(dst, src, head);
+        dst += head;
+        src += head;
+        count -= head;
+        while (count >= 64) {
+            __m128i a = _mm_loadu_si128((__m128i *)(src));
+            __m128i b = _mm_loadu_si128((__m128i *)(src + 16));
+            __m128i c = _mm_loadu_si128((__m128i *)(src + 32));
+            __m128i d = _mm_loadu_si128((__m128i *)(src + 48));
+            _mm_stream_si128((__m128i *)(dst), a);
+            _mm_stream_si128((__m128i *)(dst + 16), b);
+            _mm_stream_si128((__m128i *)(dst + 32), c);
+            _mm_stream_si128((__m128i *)(dst + 48), d);
+            dst += 64;
+            src += 64;
+            count -= 64;
+        }
+        /* Make the streamed data visible before anything else is stored */
+        _mm_sfence();
+    }
+#endif
+    memcpy(dst, src, count);
+}
+
+/*
+ * Fewest bytes of the block copy worth starting another thread for.
+ */
+#define NPY_CONCATENATE_THREAD_MIN_BYTES (1024*1024)
+
+/* A raw block of bytes to copy into the concatenation result */
+typedef struct {
+    char *dst, *src;
+    npy_intp count;
+} concatenate_block;
+
+/*
+ * The part of the block copy done by one thread: the bytes [lo, hi)
+ * of all blocks taken one after the other. 'done' is released when
+ * the part is copied.
+ */
+typedef struct {
+    concatenate_block *blocks;
+    npy_intp nblocks, lo, hi;
+    int stream;
+    PyThread_type_lock done;
+} concatenate_task;
+
+static void
+concatenate_run_task(void *arg)
+{
+    concatenate_task *task = (concatenate_task *)arg;
+    npy_intp iblock, start = 0, lo, hi;
+
+    for (iblock = 0; iblock < task->nblocks && start < task->hi; ++iblock) {
+        concatenate_block *block = &task->blocks[iblock];
+
+        lo = NPY_MAX(task->lo, start);
+        hi = NPY_MIN(task->hi, start + block->count);
+        if (lo < hi) {
+            concatenate_block_copy(block->dst + (lo - start),
+                                   block->src + (lo - start),
+                                   hi - lo, task->stream);
+        }
+        start += block->count;
+    }
+    if (task->done != NULL) {
+        PyThread_release_lock(task->done);
+    }
+}
+
+/*
+ * Copies the raw blocks of a concatenation, splitting their bytes
+ * evenly between up to 'nthreads' threads, each of which gets at
+ * least NPY_CONCATENATE_THREAD_MIN_BYTES. The calling thread copies
+ * the first part itself, without the GIL. A part whose thread can't
+ * be started is copied by the calling thread as well, so this can't
+ * fail. Must be called with the GIL held.
+ */
+static void
+concatenate_block_copies(concatenate_block *blocks, npy_intp nblocks,
+                         int stream, int nthreads)
+{
+    concatenate_task one_task, *tasks = &one_task;
+    npy_intp iblock, total = 0;
+    int itask, ntasks = 1;
+    NPY_BEGIN_THREADS_DEF;
+
+    for (iblock = 0; iblock < nblocks; ++iblock) {
+        total += blocks[iblock].count;
+    }
+#if NPY_ALLOW_THREADS
+    if (nthreads > 1 && total >= 2*NPY_CONCATENATE_THREAD_MIN_BYTES) {
+        ntasks = (int)NPY_MIN(nthreads,
+                              total / NPY_CONCATENATE_THREAD_MIN_BYTES);
+        tasks = PyArray_malloc(ntasks * sizeof(concatenate_task));
+        if (tasks == NULL) {
+            tasks = &one_task;
+            ntasks = 1;
+        }
+    }
+#endif
+
+    for (itask = 0; itask < ntasks; ++itask) {
+        concatenate_task *task = &tasks[itask];
+
+        task->blocks = blocks;
+        task->nblocks = nblocks;
+        task->lo = total / ntasks * itask;
+        task->hi = (itask == ntasks - 1) ? total : task->lo + total / ntasks;
+        task->stream = stream;
+        task->done = NULL;
+    }
+
+#if NPY_ALLOW_THREADS
+    /* The workers never touch Python objects, so don't need the GIL */
+    for (itask = 1; itask < ntasks; ++itask) {
+        concatenate_task *task = &tasks[itask];
+
+        task->done = PyThread_allocate_lock();
+        if (task->done == NULL) {
+            continue;
+        }
+        PyThread_acquire_lock(task->done, 1);
+        if (PyThread_start_new_thread(concatenate_run_task, task) == -1) {
+            PyThread_release_lock(task->done);
+            PyThread_free_lock(task->done);
+            task->done = NULL;
+        }
+    }
+#endif
+
+    NPY_BEGIN_THREADS;
+    concatenate_run_task(&tasks[0]);
+    for (itask = 1; itask < ntasks; ++itask) {
+        concatenate_task *task = &tasks[itask];
+
+        if (task->done == NULL) {
+            concatenate_run_task(task);
+        }
+#if NPY_ALLOW_THREADS
+        else {
+            /* Wait for the worker to finish its part */
+            PyThread_acquire_lock(task->done, 1);
+            PyThread_release_lock(task->done);
+            PyThread_free_lock(task->done);
+        }
+#endif
+    }
+    NPY_END_THREADS;
+
+    if (tasks != &one_task) {
+        PyArray_free(tasks);
+    }
+}
+
+/*
+ * Returns true if 'arr' can be copied into the window 'view' of the
+ * concatenation result as one raw block of bytes. Both must be a
+ * single contiguous segment with the same memory layout, and their
+ * dtypes must be equivalent.
+ */
+static int
+concatenate_can_block_copy(PyArrayObject *view, PyArrayObject *arr)
+{
+    if (!PyArray_EquivTypes(PyArray_DESCR(view), PyArray_DESCR(arr))) {
+        return 0;
+    }
+    PyArray_UpdateFlags(view, NPY_ARRAY_C_CONTIGUOUS |
+                              NPY_ARRAY_F_CONTIGUOUS);
+    return (PyArray_IS_C_CONTIGUOUS(view) &&
+                        PyArray_IS_C_CONTIGUOUS(arr)) ||
+           (PyArray_IS_F_CONTIGUOUS(view) &&
+                        PyArray_IS_F_CONTIGUOUS(arr));
+}
+
+/*
+ * Concatenates a list of ndarrays. The inputs which can be copied as
+ * raw blocks are copied by up to 'nthreads' threads.
  */
 NPY_NO_EXPORT PyArrayObject *
-PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis)
+PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis,
+                          int nthreads)
 {
     PyTypeObject *subtype = &PyArray_Type;
     double priority = NPY_PRIORITY;
@@ -320,6 +525,8 @@ PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis)
     PyArray_Descr *dtype = NULL;
     PyArrayObject *ret = NULL;
     PyArrayObject_fields *sliding_view = NULL;
+    concatenate_block *blocks = NULL;
+    npy_intp nblocks = 0;
     int has_maskna;
 
     if (narrays <= 0) {
@@ -444,17 +651,44 @@ PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis)
         Py_DECREF(ret);
         return NULL;
     }
-    for (iarrays = 0; iarrays < narrays; ++iarrays) {
-        /* Set the dimension to match the input array's */
-        sliding_view->dimensions[axis] = PyArray_SHAPE(arrays[iarrays])[axis];
 
-        /* Copy the data for this array */
-        if (PyArray_AssignArray((PyArrayObject *)sliding_view, arrays[iarrays],
-                            NULL, NPY_SAME_KIND_CASTING, 0, NULL) < 0) {
+    /*
+     * Inputs which can be copied as one raw block are only recorded
+     * here, and copied together afterwards without the GIL. Everything
+     * else is assigned right away.
+     */
+    if (!has_maskna && !PyDataType_REFCHK(PyArray_DESCR(ret))) {
+        blocks = PyArray_malloc(narrays * sizeof(concatenate_block));
+        if (blocks == NULL) {
             Py_DECREF(sliding_view);
             Py_DECREF(ret);
+            PyErr_NoMemory();
             return NULL;
         }
+    }
+
+    for (iarrays = 0; iarrays < narrays; ++iarrays) {
+        /* Set the dimension to match the input array's */
+        sliding_view->dimensions[axis] = PyArray_SHAPE(arrays[iarrays])[axis];
+
+        if (blocks != NULL && concatenate_can_block_copy(
+                    (PyArrayObject *)sliding_view, arrays[iarrays])) {
+            blocks[nblocks].dst = sliding_view->data;
+            blocks[nblocks].src = PyArray_BYTES(arrays[iarrays]);
+            blocks[nblocks].count = PyArray_NBYTES(arrays[iarrays]);
+            ++nblocks;
+        }
+        else {
+            /* Copy the data for this array */
+            if (PyArray_AssignArray((PyArrayObject *)sliding_view,
+                                arrays[iarrays],
+                                NULL, NPY_SAME_KIND_CASTING, 0, NULL) < 0) {
+                PyArray_free(blocks);
+                Py_DECREF(sliding_view);
+                Py_DECREF(ret);
+                return NULL;
+            }
+        }
 
         /* Slide to the start of the next window */
         sliding_view->data += sliding_view->dimensions[axis] *
@@ -464,8 +698,15 @@ PyArray_ConcatenateArrays(int narrays, PyArrayObject **arrays, int axis)
                                      sliding_view->maskna_strides[axis];
         }
     }
-
     Py_DECREF(sliding_view);
+
+    if (nblocks > 0) {
+        concatenate_block_copies(blocks, nblocks,
+                PyArray_NBYTES(ret) > NPY_CONCATENATE_STREAM_THRESHOLD,
+                nthreads);
+    }
+    PyArray_free(blocks);
+
     return ret;
 }
 
@@ -587,17 +828,12 @@ PyArray_ConcatenateFlattenedArrays(int narrays, PyArrayObject **arrays,
 }
 
 
-/*NUMPY_API
- * Concatenate
- *
- * Concatenate an arbitrary Python sequence into an array.
- * op is a python object supporting the sequence interface.
- * Its elements will be concatenated together to form a single
- * multidimensional array. If axis is NPY_MAXDIMS or bigger, then
- * each sequence object will be flattened before concatenation
-*/
-NPY_NO_EXPORT PyObject *
-PyArray_Concatenate(PyObject *op, int axis)
+/*
+ * PyArray_Concatenate, with the raw block copies of concatenating
+ * along an axis done by up to 'nthreads' threads.
+ */
+static PyObject *
+concatenate_sequence(PyObject *op, int axis, int nthreads)
 {
     int iarrays, narrays;
     PyArrayObject **arrays;
@@ -632,7 +868,7 @@ PyArray_Concatenate(PyObject *op, int axis)
         ret = PyArray_ConcatenateFlattenedArrays(narrays, arrays, NPY_CORDER);
     }
     else {
-        ret = PyArray_ConcatenateArrays(narrays, arrays, axis);
+        ret = PyArray_ConcatenateArrays(narrays, arrays, axis, nthreads);
     }
 
     for (iarrays = 0; iarrays < narrays; ++iarrays) {
@@ -650,6 +886,21 @@ fail:
     return NULL;
 }
 
+/*NUMPY_API
+ * Concatenate
+ *
+ * Concatenate an arbitrary Python sequence into an array.
+ * op is a python object supporting the sequence interface.
+ * Its elements will be concatenated together to form a single
+ * multidimensional array. If axis is NPY_MAXDIMS or bigger, then
+ * each sequence object will be flattened before concatenation
+*/
+NPY_NO_EXPORT PyObject *
+PyArray_Concatenate(PyObject *op, int axis)
+{
+    return concatenate_sequence(op, axis, 1);
+}
+
 static int
 _signbit_set(PyArrayObject *arr)
 {
@@ -2239,14 +2490,14 @@ static PyObject *
 array_concatenate(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
 {
     PyObject *a0;
-    int axis = 0;
-    static char *kwlist[] = {"seq", "axis", NULL};
+    int axis = 0, nthreads = 1;
+    static char *kwlist[] = {"seq", "axis", "nthreads", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&", kwlist,
-                &a0, PyArray_AxisConverter, &axis)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O&i", kwlist,
+                &a0, PyArray_AxisConverter, &axis, &nthreads)) {
         return NULL;
     }
-    return PyArray_Concatenate(a0, axis);
+    return concatenate_sequence(a0, axis, nthreads);
 }
 
 static PyObject *
@@ -2857,15 +3108,211 @@ array_set_datetimeparse_function(PyObject *NPY_UNUSED(self),
 }
 
 
+/*
+ * The original implementation of PyArray_Where, which computes
+ * 'condition != 0' into a temporary and uses PyArray_Choose. This
+ * is kept for inputs with NA masks, which the NpyIter-based kernel
+ * below does not propagate, for subclasses of ndarray, whose own
+ * comparison and array wrapping decide the result, and for conditions
+ * which are not boolean, integer or floating point. Their comparison
+ * with zero can't be done by the kernel's cast to boolean, which would
+ * drop the imaginary part of a complex value, and object conditions
+ * are compared with zero instead of tested for truth.
+ */
+static PyObject *
+where_via_choose(PyArrayObject *arr, PyObject *x, PyObject *y)
+{
+    PyObject *tup = NULL, *obj = NULL;
+    PyObject *ret = NULL, *zero = NULL;
+
+    zero = PyInt_FromLong((long) 0);
+    obj = PyArray_EnsureAnyArray(PyArray_GenericBinaryFunction(arr, zero,
+                n_ops.not_equal));
+    Py_DECREF(zero);
+    if (obj == NULL) {
+        return NULL;
+    }
+    tup = Py_BuildValue("(OO)", y, x);
+    if (tup == NULL) {
+        Py_DECREF(obj);
+        return NULL;
+    }
+    ret = PyArray_Choose((PyArrayObject *)obj, tup, NULL, NPY_RAISE);
+    Py_DECREF(obj);
+    Py_DECREF(tup);
+    return ret;
+}
+
+/*
+ * Inner loop of the where kernel for an element size which fits
+ * in one of the sized unsigned integer types. The contiguous case
+ * is written as a branchless select, which avoids mispredictions on
+ * random conditions and lets the compiler use vector instructions.
+ */
+#define WHERE_INNER_LOOP(type) \
+    if (cstride == sizeof(npy_bool) && dstride == sizeof(type) && \
+                xstride == sizeof(type) && ystride == sizeof(type)) { \
+        npy_bool *c = (npy_bool *)csrc; \
+        type *d = (type *)dst, *xs = (type *)xsrc, *ys = (type *)ysrc; \
+        for (i = 0; i < count; ++i) { \
+            /* a mask select, which vectorizes to a blend */ \
+            type m = (type)0 - (type)(c[i] != 0); \
+            d[i] = (xs[i] & m) | (ys[i] & ~m); \
+        } \
+    } \
+    else { \
+        for (i = 0; i < count; ++i) { \
+            *(type *)dst = *(npy_bool *)csrc ? *(type *)xsrc \
+                                             : *(type *)ysrc; \
+            dst += dstride; \
+            csrc += cstride; \
+            xsrc += xstride; \
+            ysrc += ystride; \
+        } \
+    }
+
+/*
+ * Evaluates 'where(condition, x, y)' in a single broadcasting pass
+ * with a four operand iterator, [out, condition, x, y]. The iterator
+ * casts the condition to boolean and x and y to common_dtype,
+ * buffering as needed, so the inner loop only has to select elements.
+ */
+static PyObject *
+where_kernel(PyArrayObject *arr, PyArrayObject *ax, PyArrayObject *ay,
+             PyArray_Descr *common_dtype)
+{
+    PyArrayObject *op[4] = {NULL, arr, ax, ay};
+    npy_uint32 op_flags[4];
+    PyArray_Descr *op_dtypes[4] = {NULL, NULL, NULL, NULL};
+    npy_uint32 flags;
+    NpyIter *iter = NULL;
+    PyObject *ret = NULL;
+    NPY_BEGIN_THREADS_DEF;
+
+    op_dtypes[0] = common_dtype;
+    op_dtypes[1] = PyArray_DescrFromType(NPY_BOOL);
+    op_dtypes[2] = common_dtype;
+    op_dtypes[3] = common_dtype;
+
+    flags = NPY_ITER_EXTERNAL_LOOP |
+            NPY_ITER_BUFFERED |
+            NPY_ITER_GROWINNER |
+            NPY_ITER_REFS_OK |
+            NPY_ITER_ZEROSIZE_OK;
+    op_flags[0] = NPY_ITER_WRITEONLY | NPY_ITER_ALLOCATE |
+                  NPY_ITER_NO_SUBTYPE | NPY_ITER_ALIGNED | NPY_ITER_NBO;
+    op_flags[1] = NPY_ITER_READONLY | NPY_ITER_ALIGNED;
+    op_flags[2] = NPY_ITER_READONLY | NPY_ITER_ALIGNED | NPY_ITER_NBO;
+    op_flags[3] = NPY_ITER_READONLY | NPY_ITER_ALIGNED | NPY_ITER_NBO;
+
+    /* Casting the condition to boolean is 'unsafe', so allow it */
+    iter = NpyIter_MultiNew(4, op, flags, NPY_KEEPORDER, NPY_UNSAFE_CASTING,
+                            op_flags, op_dtypes);
+    Py_DECREF(op_dtypes[1]);
+    if (iter == NULL) {
+        return NULL;
+    }
+
+    if (NpyIter_GetIterSize(iter) > 0) {
+        NpyIter_IterNextFunc *iternext;
+        char **dataptr;
+        npy_intp *strideptr, *innersizeptr;
+        PyArray_Descr *dtype;
+        PyArray_CopySwapFunc *copyswap;
+        PyArrayObject *out;
+        npy_intp itemsize;
+        int needs_api, refs;
+
+        iternext = NpyIter_GetIterNext(iter, NULL);
+        if (iternext == NULL) {
+            goto finish;
+        }
+        dataptr = NpyIter_GetDataPtrArray(iter);
+        strideptr = NpyIter_GetInnerStrideArray(iter);
+        innersizeptr = NpyIter_GetInnerLoopSizePtr(iter);
+        out = NpyIter_GetOperandArray(iter)[0];
+        dtype = PyArray_DESCR(out);
+        copyswap = dtype->f->copyswap;
+        itemsize = dtype->elsize;
+        refs = PyDataType_REFCHK(dtype);
+        needs_api = refs || NpyIter_IterationNeedsAPI(iter);
+
+        if (!needs_api) {
+            NPY_BEGIN_THREADS;
+        }
+
+        do {
+            char *dst = dataptr[0], *csrc = dataptr[1];
+            char *xsrc = dataptr[2], *ysrc = dataptr[3];
+            npy_intp dstride = strideptr[0], cstride = strideptr[1];
+            npy_intp xstride = strideptr[2], ystride = strideptr[3];
+            npy_intp count = *innersizeptr, i;
+
+            if (refs) {
+                /* Object references must be handled by copyswap */
+                for (i = 0; i < count; ++i) {
+                    copyswap(dst, *(npy_bool *)csrc ? xsrc : ysrc,
+                             0, out);
+                    dst += dstride;
+                    csrc += cstride;
+                    xsrc += xstride;
+                    ysrc += ystride;
+                }
+            }
+            else if (itemsize == 1) {
+                WHERE_INNER_LOOP(npy_uint8);
+            }
+            else if (itemsize == 2) {
+                WHERE_INNER_LOOP(npy_uint16);
+            }
+            else if (itemsize == 4) {
+                WHERE_INNER_LOOP(npy_uint32);
+            }
+            else if (itemsize == 8) {
+                WHERE_INNER_LOOP(npy_uint64);
+            }
+            else {
+                for (i = 0; i < count; ++i) {
+                    memmove(dst, *(npy_bool *)csrc ? xsrc : ysrc, itemsize);
+                    dst += dstride;
+                    csrc += cstride;
+                    xsrc += xstride;
+                    ysrc += ystride;
+                }
+            }
+        } while (iternext(iter));
+
+        if (!needs_api) {
+            NPY_END_THREADS;
+        }
+        else if (PyErr_Occurred()) {
+            goto finish;
+        }
+    }
+
+    ret = (PyObject *)NpyIter_GetOperandArray(iter)[0];
+    Py_INCREF(ret);
+
+finish:
+    if (NpyIter_Deallocate(iter) != NPY_SUCCEED) {
+        Py_XDECREF(ret);
+        ret = NULL;
+    }
+    return ret;
+}
+
+#undef WHERE_INNER_LOOP
+
 /*NUMPY_API
  * Where
  */
 NPY_NO_EXPORT PyObject *
 PyArray_Where(PyObject *condition, PyObject *x, PyObject *y)
 {
-    PyArrayObject *arr;
-    PyObject *tup = NULL, *obj = NULL;
-    PyObject *ret = NULL, *zero = NULL;
+    PyArrayObject *arr, *ax = NULL, *ay = NULL;
+    PyArray_Descr *common_dtype = NULL;
+    PyObject *tup = NULL, *ret = NULL;
+    int allscalars;
 
     arr = (PyArrayObject *)PyArray_FromAny(condition, NULL, 0, 0, 0, NULL);
     if (arr == NULL) {
@@ -2883,23 +3330,54 @@ PyArray_Where(PyObject *condition, PyObject *x, PyObject *y)
         return NULL;
     }
 
+    ax = (PyArrayObject *)PyArray_FromAny(x, NULL, 0, 0,
+                                    NPY_ARRAY_ALLOWNA, NULL);
+    if (ax == NULL) {
+        goto finish;
+    }
+    ay = (PyArrayObject *)PyArray_FromAny(y, NULL, 0, 0,
+                                    NPY_ARRAY_ALLOWNA, NULL);
+    if (ay == NULL) {
+        goto finish;
+    }
 
-    zero = PyInt_FromLong((long) 0);
-    obj = PyArray_EnsureAnyArray(PyArray_GenericBinaryFunction(arr, zero,
-                n_ops.not_equal));
-    Py_DECREF(zero);
-    Py_DECREF(arr);
-    if (obj == NULL) {
-        return NULL;
+    if (PyArray_HASMASKNA(arr) || PyArray_HASMASKNA(ax) ||
+            PyArray_HASMASKNA(ay) || !PyArray_CheckExact(arr) ||
+            !PyArray_CheckExact(ax) || !PyArray_CheckExact(ay) ||
+            !(PyArray_ISBOOL(arr) || PyArray_ISINTEGER(arr) ||
+              PyArray_ISFLOAT(arr))) {
+        ret = where_via_choose(arr, x, y);
+        goto finish;
     }
+
+    /* The result has the type PyArray_Choose would give it */
     tup = Py_BuildValue("(OO)", y, x);
     if (tup == NULL) {
-        Py_DECREF(obj);
-        return NULL;
+        goto finish;
     }
-    ret = PyArray_Choose((PyArrayObject *)obj, tup, NULL, NPY_RAISE);
-    Py_DECREF(obj);
-    Py_DECREF(tup);
+    common_dtype = sequence_common_type(tup, 2, NULL, &allscalars);
+    if (common_dtype == NULL) {
+        goto finish;
+    }
+    /* The kernel writes the result in native byte order */
+    if (!PyArray_ISNBO(common_dtype->byteorder)) {
+        PyArray_Descr *native;
+
+        native = PyArray_DescrNewByteorder(common_dtype, NPY_NATIVE);
+        Py_DECREF(common_dtype);
+        common_dtype = native;
+        if (common_dtype == NULL) {
+            goto finish;
+        }
+    }
+    ret = where_kernel(arr, ax, ay, common_dtype);
+
+finish:
+    Py_DECREF(arr);
+    Py_XDECREF(ax);
+    Py_XDECREF(ay);
+    Py_XDECREF(tup);
+    Py_XDECREF(common_dtype);
     return ret;
 }
 
@@ -3786,6 +4264,29 @@ static struct PyMethodDef array_module_methods[] = {
     {"test_interrupt",
         (PyCFunction)test_interrupt,
         METH_VARARGS, NULL},
+    /* Data allocation policies */
+    {"set_data_allocator",
+        (PyCFunction)array_set_data_allocator,
+        METH_VARARGS, NULL},
+    {"get_data_allocator",
+        (PyCFunction)array_get_data_allocator,
+        METH_VARARGS, NULL},
+    {"set_alloc_cache_size",
+        (PyCFunction)array_set_alloc_cache_size,
+        METH_VARARGS, NULL},
+    {"alloc_cache_stats",
+        (PyCFunction)array_alloc_cache_stats,
+        METH_VARARGS, NULL},
+    {"_madvise",
+        (PyCFunction)array_madvise,
+        METH_VARARGS, NULL},
+    /* Text reading and writing */
+    {"_loadtxt",
+        (PyCFunction)array__loadtxt,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_format_rows",
+        (PyCFunction)array__format_rows,
+        METH_VARARGS, NULL},
     {NULL, NULL, 0, NULL}                /* sentinel */
 };
 
@@ -6,6 +6,7 @@
  */
 
 #include "common.c"
+#include "alloc.c"
 
 #include "scalartypes.c"
 #include "scalarapi.c"
@@ -31,6 +32,8 @@
 #include "convert_datatype.c"
 #include "convert.c"
 #include "shape.c"
+#include "textreader.c"
+#include "textwriter.c"
 #include "item_selection.c"
 #include "calculation.c"
 #include "usertypes.c"
@@ -3,6 +3,7 @@
 
 #include <locale.h>
 #include <stdio.h>
+#include <float.h>
 
 #define NPY_NO_DEPRECATED_API
 #define _MULTIARRAYMODULE
@@ -548,6 +549,178 @@ NumPyOS_ascii_strtod(const char *s, char** endptr)
 }
 
 
+/*
+ * Exact powers of ten representable as doubles, for the fast path
+ * of NumPyOS_ascii_strtod_fast.
+ */
+static const double _exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#ifdef __GLIBC__
+static int
+_decimal_point_is_dot(void)
+{
+    const char *decimal_point = localeconv()->decimal_point;
+
+    return decimal_point[0] == '.' && decimal_point[1] == '\0';
+}
+#endif
+
+/*
+ * NumPyOS_ascii_strtod_fast:
+ *
+ * Like NumPyOS_ascii_strtod, but parses the text in [s, end), which
+ * need not be NUL terminated. Plain decimal numbers with at most 15
+ * significant digits and a small exponent are an exact integer times
+ * or divided by an exact power of ten, which gives the correctly
+ * rounded result with a single operation, so these are converted
+ * directly without touching the locale or the Python API. Anything
+ * else is copied and passed on to NumPyOS_ascii_strtod.
+ *
+ * If no number could be parsed, *endptr is set to s.
+ */
+NPY_NO_EXPORT double
+NumPyOS_ascii_strtod_fast(const char *s, const char *end, char **endptr)
+{
+    char buffer[FLOAT_FORMATBUFLEN+1];
+    char *copy, *q;
+    const char *p = s;
+    npy_uint64 mantissa = 0;
+    int ndigits = 0, nsignificant = 0, exponent = 0, negative = 0;
+    double result;
+    size_t n;
+
+    while (p < end && NumPyOS_ascii_isspace(*p)) {
+        ++p;
+    }
+    s = p;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    /* Integer part */
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (mantissa != 0 || *p != '0') {
+            mantissa = mantissa * 10 + (*p - '0');
+            ++nsignificant;
+        }
+        ++ndigits;
+        ++p;
+        if (nsignificant > 15) {
+            goto slow;
+        }
+    }
+    /* Fraction part */
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (mantissa != 0 || *p != '0') {
+                mantissa = mantissa * 10 + (*p - '0');
+                ++nsignificant;
+            }
+            ++ndigits;
+            --exponent;
+            ++p;
+            if (nsignificant > 15) {
+                goto slow;
+            }
+        }
+    }
+    if (ndigits == 0) {
+        /* nan, inf, or not a number at all */
+        goto slow;
+    }
+    /* Exponent part, only if it has digits */
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *e = p + 1;
+        int exp_negative = 0, exp_value = 0;
+
+        if (e < end && (*e == '-' || *e == '+')) {
+            exp_negative = (*e == '-');
+            ++e;
+        }
+        if (e < end && *e >= '0' && *e <= '9') {
+            while (e < end && *e >= '0' && *e <= '9') {
+                exp_value = exp_value * 10 + (*e - '0');
+                if (exp_value > 10000) {
+                    goto slow;
+                }
+                ++e;
+            }
+            exponent += exp_negative ? -exp_value : exp_value;
+            p = e;
+        }
+    }
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    /* Extended precision intermediates could round twice */
+    goto slow;
+#endif
+    result = (double)mantissa;
+    if (mantissa == 0) {
+        /* Nothing to scale */
+    }
+    else if (exponent >= 0 && exponent <= 22) {
+        result *= _exact_powers_of_ten[exponent];
+    }
+    else if (exponent < 0 && exponent >= -22) {
+        result /= _exact_powers_of_ten[-exponent];
+    }
+    else if (exponent > 22 && exponent <= 22 + 15 - nsignificant) {
+        /* Move part of the exponent into the mantissa, which stays exact */
+        result *= _exact_powers_of_ten[exponent - 22];
+        result *= _exact_powers_of_ten[22];
+    }
+    else {
+        goto slow;
+    }
+    if (endptr != NULL) {
+        *endptr = (char *)p;
+    }
+    return negative ? -result : result;
+
+slow:
+    n = (size_t)(end - s);
+    if (n <= FLOAT_FORMATBUFLEN) {
+        copy = buffer;
+    }
+    else {
+        copy = malloc(n + 1);
+        if (copy == NULL) {
+            if (endptr != NULL) {
+                *endptr = (char *)s;
+            }
+            return -1.0;
+        }
+    }
+    memcpy(copy, s, n);
+    copy[n] = '\0';
+#ifdef __GLIBC__
+    /*
+     * The glibc strtod is correctly rounded, and unlike the Python one
+     * needs neither the GIL nor a copy, so use it for plain decimal
+     * numbers when the locale doesn't change the decimal point.
+     */
+    if (ndigits > 0 && _decimal_point_is_dot()) {
+        result = strtod(copy, &q);
+    }
+    else
+#endif
+    {
+        result = NumPyOS_ascii_strtod(copy, &q);
+    }
+    if (endptr != NULL) {
+        *endptr = (char *)(s + (q - copy));
+    }
+    if (copy != buffer) {
+        free(copy);
+    }
+    return result;
+}
+
 /*
  * NumPyOS_ascii_ftolf:
  *      * fp: FILE pointer
@@ -689,3 +862,364 @@ buffer_filled:
 #undef MATCH_ONE_OR_NONE
 #undef MATCH_ONE_OR_MORE
 #undef MATCH_ZERO_OR_MORE
+
+
+/*
+ * The shortest representation of doubles, with the Grisu3 algorithm of
+ * F. Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers", PLDI 2010. It finds the fewest digits which read back
+ * to the same double, and the closest of those, with 64-bit integer
+ * arithmetic. For about 0.5% of doubles it can't be sure of the result
+ * and gives up, leaving those to a slower, exact algorithm.
+ */
+
+/* A floating point number f * 2**e with a 64-bit significand */
+typedef struct {
+    npy_uint64 f;
+    int e;
+} _diy_fp;
+
+/* Normalized approximations of 10**k, for k = -348, -340, ..., 340 */
+static const struct {
+    npy_uint64 f;
+    short e;
+    short k;
+} _cached_powers_of_ten[] = {
+    {NPY_ULONGLONG_SUFFIX(0xfa8fd5a0081c0288), -1220, -348},
+    {NPY_ULONGLONG_SUFFIX(0xbaaee17fa23ebf76), -1193, -340},
+    {NPY_ULONGLONG_SUFFIX(0x8b16fb203055ac76), -1166, -332},
+    {NPY_ULONGLONG_SUFFIX(0xcf42894a5dce35ea), -1140, -324},
+    {NPY_ULONGLONG_SUFFIX(0x9a6bb0aa55653b2d), -1113, -316},
+    {NPY_ULONGLONG_SUFFIX(0xe61acf033d1a45df), -1087, -308},
+    {NPY_ULONGLONG_SUFFIX(0xab70fe17c79ac6ca), -1060, -300},
+    {NPY_ULONGLONG_SUFFIX(0xff77b1fcbebcdc4f), -1034, -292},
+    {NPY_ULONGLONG_SUFFIX(0xbe5691ef416bd60c), -1007, -284},
+    {NPY_ULONGLONG_SUFFIX(0x8dd01fad907ffc3c), -980, -276},
+    {NPY_ULONGLONG_SUFFIX(0xd3515c2831559a83), -954, -268},
+    {NPY_ULONGLONG_SUFFIX(0x9d71ac8fada6c9b5), -927, -260},
+    {NPY_ULONGLONG_SUFFIX(0xea9c227723ee8bcb), -901, -252},
+    {NPY_ULONGLONG_SUFFIX(0xaecc49914078536d), -874, -244},
+    {NPY_ULONGLONG_SUFFIX(0x823c12795db6ce57), -847, -236},
+    {NPY_ULONGLONG_SUFFIX(0xc21094364dfb5637), -821, -228},
+    {NPY_ULONGLONG_SUFFIX(0x9096ea6f3848984f), -794, -220},
+    {NPY_ULONGLONG_SUFFIX(0xd77485cb25823ac7), -768, -212},
+    {NPY_ULONGLONG_SUFFIX(0xa086cfcd97bf97f4), -741, -204},
+    {NPY_ULONGLONG_SUFFIX(0xef340a98172aace5), -715, -196},
+    {NPY_ULONGLONG_SUFFIX(0xb23867fb2a35b28e), -688, -188},
+    {NPY_ULONGLONG_SUFFIX(0x84c8d4dfd2c63f3b), -661, -180},
+    {NPY_ULONGLONG_SUFFIX(0xc5dd44271ad3cdba), -635, -172},
+    {NPY_ULONGLONG_SUFFIX(0x936b9fcebb25c996), -608, -164},
+    {NPY_ULONGLONG_SUFFIX(0xdbac6c247d62a584), -582, -156},
+    {NPY_ULONGLONG_SUFFIX(0xa3ab66580d5fdaf6), -555, -148},
+    {NPY_ULONGLONG_SUFFIX(0xf3e2f893dec3f126), -529, -140},
+    {NPY_ULONGLONG_SUFFIX(0xb5b5ada8aaff80b8), -502, -132},
+    {NPY_ULONGLONG_SUFFIX(0x87625f056c7c4a8b), -475, -124},
+    {NPY_ULONGLONG_SUFFIX(0xc9bcff6034c13053), -449, -116},
+    {NPY_ULONGLONG_SUFFIX(0x964e858c91ba2655), -422, -108},
+    {NPY_ULONGLONG_SUFFIX(0xdff9772470297ebd), -396, -100},
+    {NPY_ULONGLONG_SUFFIX(0xa6dfbd9fb8e5b88f), -369, -92},
+    {NPY_ULONGLONG_SUFFIX(0xf8a95fcf88747d94), -343, -84},
+    {NPY_ULONGLONG_SUFFIX(0xb94470938fa89bcf), -316, -76},
+    {NPY_ULONGLONG_SUFFIX(0x8a08f0f8bf0f156b), -289, -68},
+    {NPY_ULONGLONG_SUFFIX(0xcdb02555653131b6), -263, -60},
+    {NPY_ULONGLONG_SUFFIX(0x993fe2c6d07b7fac), -236, -52},
+    {NPY_ULONGLONG_SUFFIX(0xe45c10c42a2b3b06), -210, -44},
+    {NPY_ULONGLONG_SUFFIX(0xaa242499697392d3), -183, -36},
+    {NPY_ULONGLONG_SUFFIX(0xfd87b5f28300ca0e), -157, -28},
+    {NPY_ULONGLONG_SUFFIX(0xbce5086492111aeb), -130, -20},
+    {NPY_ULONGLONG_SUFFIX(0x8cbccc096f5088cc), -103, -12},
+    {NPY_ULONGLONG_SUFFIX(0xd1b71758e219652c), -77, -4},
+    {NPY_ULONGLONG_SUFFIX(0x9c40000000000000), -50, 4},
+    {NPY_ULONGLONG_SUFFIX(0xe8d4a51000000000), -24, 12},
+    {NPY_ULONGLONG_SUFFIX(0xad78ebc5ac620000), 3, 20},
+    {NPY_ULONGLONG_SUFFIX(0x813f3978f8940984), 30, 28},
+    {NPY_ULONGLONG_SUFFIX(0xc097ce7bc90715b3), 56, 36},
+    {NPY_ULONGLONG_SUFFIX(0x8f7e32ce7bea5c70), 83, 44},
+    {NPY_ULONGLONG_SUFFIX(0xd5d238a4abe98068), 109, 52},
+    {NPY_ULONGLONG_SUFFIX(0x9f4f2726179a2245), 136, 60},
+    {NPY_ULONGLONG_SUFFIX(0xed63a231d4c4fb27), 162, 68},
+    {NPY_ULONGLONG_SUFFIX(0xb0de65388cc8ada8), 189, 76},
+    {NPY_ULONGLONG_SUFFIX(0x83c7088e1aab65db), 216, 84},
+    {NPY_ULONGLONG_SUFFIX(0xc45d1df942711d9a), 242, 92},
+    {NPY_ULONGLONG_SUFFIX(0x924d692ca61be758), 269, 100},
+    {NPY_ULONGLONG_SUFFIX(0xda01ee641a708dea), 295, 108},
+    {NPY_ULONGLONG_SUFFIX(0xa26da3999aef774a), 322, 116},
+    {NPY_ULONGLONG_SUFFIX(0xf209787bb47d6b85), 348, 124},
+    {NPY_ULONGLONG_SUFFIX(0xb454e4a179dd1877), 375, 132},
+    {NPY_ULONGLONG_SUFFIX(0x865b86925b9bc5c2), 402, 140},
+    {NPY_ULONGLONG_SUFFIX(0xc83553c5c8965d3d), 428, 148},
+    {NPY_ULONGLONG_SUFFIX(0x952ab45cfa97a0b3), 455, 156},
+    {NPY_ULONGLONG_SUFFIX(0xde469fbd99a05fe3), 481, 164},
+    {NPY_ULONGLONG_SUFFIX(0xa59bc234db398c25), 508, 172},
+    {NPY_ULONGLONG_SUFFIX(0xf6c69a72a3989f5c), 534, 180},
+    {NPY_ULONGLONG_SUFFIX(0xb7dcbf5354e9bece), 561, 188},
+    {NPY_ULONGLONG_SUFFIX(0x88fcf317f22241e2), 588, 196},
+    {NPY_ULONGLONG_SUFFIX(0xcc20ce9bd35c78a5), 614, 204},
+    {NPY_ULONGLONG_SUFFIX(0x98165af37b2153df), 641, 212},
+    {NPY_ULONGLONG_SUFFIX(0xe2a0b5dc971f303a), 667, 220},
+    {NPY_ULONGLONG_SUFFIX(0xa8d9d1535ce3b396), 694, 228},
+    {NPY_ULONGLONG_SUFFIX(0xfb9b7cd9a4a7443c), 720, 236},
+    {NPY_ULONGLONG_SUFFIX(0xbb764c4ca7a44410), 747, 244},
+    {NPY_ULONGLONG_SUFFIX(0x8bab8eefb6409c1a), 774, 252},
+    {NPY_ULONGLONG_SUFFIX(0xd01fef10a657842c), 800, 260},
+    {NPY_ULONGLONG_SUFFIX(0x9b10a4e5e9913129), 827, 268},
+    {NPY_ULONGLONG_SUFFIX(0xe7109bfba19c0c9d), 853, 276},
+    {NPY_ULONGLONG_SUFFIX(0xac2820d9623bf429), 880, 284},
+    {NPY_ULONGLONG_SUFFIX(0x80444b5e7aa7cf85), 907, 292},
+    {NPY_ULONGLONG_SUFFIX(0xbf21e44003acdd2d), 933, 300},
+    {NPY_ULONGLONG_SUFFIX(0x8e679c2f5e44ff8f), 960, 308},
+    {NPY_ULONGLONG_SUFFIX(0xd433179d9c8cb841), 986, 316},
+    {NPY_ULONGLONG_SUFFIX(0x9e19db92b4e31ba9), 1013, 324},
+    {NPY_ULONGLONG_SUFFIX(0xeb96bf6ebadf77d9), 1039, 332},
+    {NPY_ULONGLONG_SUFFIX(0xaf87023b9bf0ee6b), 1066, 340},
+};
+
+#define _CACHED_POWERS_OFFSET 348
+#define _CACHED_POWERS_DISTANCE 8
+
+static _diy_fp
+_diy_fp_multiply(_diy_fp x, _diy_fp y)
+{
+    const npy_uint64 mask32 = 0xFFFFFFFFu;
+    npy_uint64 a = x.f >> 32, b = x.f & mask32;
+    npy_uint64 c = y.f >> 32, d = y.f & mask32;
+    npy_uint64 ac = a*c, bc = b*c, ad = a*d, bd = b*d;
+    npy_uint64 tmp = (bd >> 32) + (ad & mask32) + (bc & mask32);
+    _diy_fp r;
+
+    /* Round the lower half of the product */
+    tmp += (npy_uint64)1 << 31;
+    r.f = ac + (ad >> 32) + (bc >> 32) + (tmp >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static _diy_fp
+_diy_fp_normalize(_diy_fp x)
+{
+    while (!(x.f & NPY_ULONGLONG_SUFFIX(0xFFC0000000000000))) {
+        x.f <<= 10;
+        x.e -= 10;
+    }
+    while (!(x.f & NPY_ULONGLONG_SUFFIX(0x8000000000000000))) {
+        x.f <<= 1;
+        x.e -= 1;
+    }
+    return x;
+}
+
+/*
+ * Moves the last digit of the buffer down towards w, as long as that
+ * stays within the safe interval. Returns 1 if the result is certain
+ * to be the closest shortest representation, 0 if not.
+ */
+static int
+_grisu_round_weed(char *buffer, int length, npy_uint64 distance_too_high_w,
+                  npy_uint64 unsafe_interval, npy_uint64 rest,
+                  npy_uint64 ten_kappa, npy_uint64 unit)
+{
+    npy_uint64 small_distance = distance_too_high_w - unit;
+    npy_uint64 big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance &&
+            unsafe_interval - rest >= ten_kappa &&
+            (rest + ten_kappa < small_distance ||
+             small_distance - rest >= rest + ten_kappa - small_distance)) {
+        buffer[length - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_distance &&
+            unsafe_interval - rest >= ten_kappa &&
+            (rest + ten_kappa < big_distance ||
+             big_distance - rest > rest + ten_kappa - big_distance)) {
+        return 0;
+    }
+    return (2*unit <= rest) && (rest <= unsafe_interval - 4*unit);
+}
+
+/*
+ * Generates the digits of a number in the interval (low, high) around
+ * w, all with the same exponent between -60 and -32. The number is the
+ * digits times 10**kappa. Returns 1 on success, 0 if unsure.
+ */
+static int
+_grisu_digit_gen(_diy_fp low, _diy_fp w, _diy_fp high,
+                 char *buffer, int *length, int *kappa)
+{
+    npy_uint64 unit = 1;
+    npy_uint64 too_low = low.f - unit, too_high = high.f + unit;
+    npy_uint64 unsafe_interval = too_high - too_low;
+    int shift = -w.e;
+    npy_uint64 one = (npy_uint64)1 << shift;
+    npy_uint32 integrals = (npy_uint32)(too_high >> shift);
+    npy_uint64 fractionals = too_high & (one - 1);
+    npy_uint64 divisor = 1;
+
+    /* The largest power of ten not above the integral part */
+    *kappa = 0;
+    while (divisor <= integrals) {
+        divisor *= 10;
+        ++*kappa;
+    }
+    divisor /= 10;
+
+    *length = 0;
+    while (*kappa > 0) {
+        npy_uint64 rest;
+
+        buffer[(*length)++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        --*kappa;
+        rest = ((npy_uint64)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            return _grisu_round_weed(buffer, *length, too_high - w.f,
+                                     unsafe_interval, rest,
+                                     divisor << shift, unit);
+        }
+        divisor /= 10;
+    }
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        buffer[(*length)++] = (char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        --*kappa;
+        if (fractionals < unsafe_interval) {
+            return _grisu_round_weed(buffer, *length,
+                                     (too_high - w.f) * unit,
+                                     unsafe_interval, fractionals,
+                                     one, unit);
+        }
+    }
+}
+
+/*
+ * Finds the shortest digits of the positive, finite double v, which is
+ * the digits times 10**exponent. Returns 1 on success, 0 if unsure.
+ */
+static int
+_grisu3(double v, char *digits, int *ndigits, int *exponent)
+{
+    union {
+        double d;
+        npy_uint64 u;
+    } bits;
+    npy_uint64 significand;
+    int biased_exponent, k, index, kappa, ret;
+    _diy_fp w, m_plus, m_minus, c;
+
+    bits.d = v;
+    significand = bits.u & NPY_ULONGLONG_SUFFIX(0x000FFFFFFFFFFFFF);
+    biased_exponent = (int)((bits.u >> 52) & 0x7FF);
+    if (biased_exponent == 0) {
+        w.f = significand;
+        w.e = -1074;
+    }
+    else {
+        w.f = significand | NPY_ULONGLONG_SUFFIX(0x0010000000000000);
+        w.e = biased_exponent - 1075;
+    }
+
+    /* The boundaries halfway to the neighbouring doubles */
+    m_plus.f = (w.f << 1) + 1;
+    m_plus.e = w.e - 1;
+    m_plus = _diy_fp_normalize(m_plus);
+    if (significand == 0 && biased_exponent > 1) {
+        /* The double below is closer, at a power of two */
+        m_minus.f = (w.f << 2) - 1;
+        m_minus.e = w.e - 2;
+    }
+    else {
+        m_minus.f = (w.f << 1) - 1;
+        m_minus.e = w.e - 1;
+    }
+    m_minus.f <<= m_minus.e - m_plus.e;
+    m_minus.e = m_plus.e;
+    w = _diy_fp_normalize(w);
+
+    /* Scale by a power of ten which brings the exponent into [-60, -32] */
+    k = (int)ceil((-60 - (w.e + 64) + 63) * 0.30102999566398114);
+    index = (_CACHED_POWERS_OFFSET + k - 1) / _CACHED_POWERS_DISTANCE + 1;
+    c.f = _cached_powers_of_ten[index].f;
+    c.e = _cached_powers_of_ten[index].e;
+
+    ret = _grisu_digit_gen(_diy_fp_multiply(m_minus, c),
+                           _diy_fp_multiply(w, c),
+                           _diy_fp_multiply(m_plus, c),
+                           digits, ndigits, &kappa);
+    *exponent = kappa - _cached_powers_of_ten[index].k;
+    return ret;
+}
+
+/*
+ * NumPyOS_ascii_repr_double:
+ *
+ * Writes the shortest string which reads back to 'val' into 'buffer',
+ * which must hold at least 32 characters, in the format of repr() of
+ * Python floats. Returns the length of the string, or -1 for the values
+ * this doesn't handle, which are the non-finite ones and those where
+ * the fast algorithm gives up, for PyOS_double_to_string instead.
+ */
+NPY_NO_EXPORT int
+NumPyOS_ascii_repr_double(char *buffer, double val)
+{
+    char digits[20];
+    char *p = buffer;
+    int ndigits, exponent, decpt, i;
+
+    if (!npy_isfinite(val)) {
+        return -1;
+    }
+    if (npy_signbit(val)) {
+        *p++ = '-';
+        val = -val;
+    }
+    if (val == 0.0) {
+        strcpy(p, "0.0");
+        return (int)(p - buffer) + 3;
+    }
+    if (!_grisu3(val, digits, &ndigits, &exponent)) {
+        return -1;
+    }
+
+    /* The value is 0.digits times 10**decpt */
+    decpt = ndigits + exponent;
+    if (decpt <= -4 || decpt > 16) {
+        *p++ = digits[0];
+        if (ndigits > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, ndigits - 1);
+            p += ndigits - 1;
+        }
+        p += sprintf(p, "e%+.02d", decpt - 1);
+        return (int)(p - buffer);
+    }
+    if (decpt <= 0) {
+        *p++ = '0';
+        *p++ = '.';
+        for (i = 0; i < -decpt; ++i) {
+            *p++ = '0';
+        }
+        memcpy(p, digits, ndigits);
+        p += ndigits;
+    }
+    else if (decpt >= ndigits) {
+        memcpy(p, digits, ndigits);
+        p += ndigits;
+        for (i = ndigits; i < decpt; ++i) {
+            *p++ = '0';
+        }
+        *p++ = '.';
+        *p++ = '0';
+    }
+    else {
+        memcpy(p, digits, decpt);
+        p += decpt;
+        *p++ = '.';
+        memcpy(p, digits + decpt, ndigits - decpt);
+        p += ndigits - decpt;
+    }
+    *p = '\0';
+    return (int)(p - buffer);
+}
@@ -19,6 +19,12 @@ NumPyOS_ascii_formatl(char *buffer, size_t buf_size,
 NPY_NO_EXPORT double
 NumPyOS_ascii_strtod(const char *s, char** endptr);
 
+NPY_NO_EXPORT double
+NumPyOS_ascii_strtod_fast(const char *s, const char *end, char** endptr);
+
+NPY_NO_EXPORT int
+NumPyOS_ascii_repr_double(char *buffer, double val);
+
 NPY_NO_EXPORT int
 NumPyOS_ascii_ftolf(FILE *fp, double *value);
 
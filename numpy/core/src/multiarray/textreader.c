@@ -0,0 +1,1164 @@
+/*
+ * This file implements a tokenizer and parser for delimited text,
+ * which reads the numbers and strings of each row directly into the
+ * memory of the result array. It is the engine behind numpy.loadtxt.
+ *
+ * The text arrives in chunks of arbitrary size from a Python iterator,
+ * and is parsed without holding the GIL.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+#include <numpy/halffloat.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+
+#include "numpyos.h"
+#include "textreader.h"
+
+/* How a column is converted, and where it is stored in a row */
+typedef struct {
+    int type_num;
+    npy_intp offset;
+    int itemsize;
+    int swap;
+} text_column;
+
+/* A field found by the tokenizer */
+typedef struct {
+    const char *start;
+    const char *end;
+    /* Whether the field contains doubled quote characters */
+    int escaped;
+} text_field;
+
+/* Errors found while parsing, raised once the GIL is held again */
+enum {
+    TEXT_OK = 0,
+    TEXT_NO_MEMORY,
+    TEXT_BAD_VALUE,
+    TEXT_OVERFLOW,
+    TEXT_TOO_FEW_COLUMNS,
+    TEXT_TOO_MANY_ROWS
+};
+
+typedef struct {
+    /* Options */
+    char delimiter;         /* '\0' for runs of whitespace */
+    char quotechar;         /* '\0' for no quoting */
+    const char *comments;   /* NULL for no comments */
+    npy_intp comments_len;
+    npy_intp skiprows;
+    npy_intp *usecols;
+    npy_intp nusecols;
+    npy_intp max_rows;      /* -1 for no limit */
+    int count_only;         /* count the rows instead of storing them */
+
+    /* Layout of a row, set up from the dtype and the first row */
+    PyArray_Descr *dtype;
+    text_column *columns;
+    npy_intp ncolumns;      /* -1 until the first row is seen */
+    npy_intp rowsize;
+
+    /*
+     * Output buffer, allocated with PyDataMem_NEW, or the data of 'out'
+     * when the rows are stored into an array given by the caller
+     */
+    char *data;
+    npy_intp nrows;
+    npy_intp capacity;
+    PyArrayObject *out;
+
+    /* Fields of the current row */
+    text_field *fields;
+    npy_intp nfields;
+    npy_intp fields_capacity;
+    npy_intp row_newlines;
+    /* The line the current row starts on, counting from 1 */
+    npy_intp line;
+
+    /* Details of the error, if any */
+    int error;
+    npy_intp error_column;
+    char error_text[64];
+} text_reader;
+
+/* Initial size of the output buffer, in bytes */
+#define TEXT_INITIAL_BUFSIZE (64*1024)
+
+/*
+ * Returns 1 if the tokenizer can convert fields to 'dtype', which must
+ * not be structured, 0 otherwise.
+ */
+static int
+text_column_supported(PyArray_Descr *dtype)
+{
+    if (dtype->subarray != NULL || PyDataType_HASFIELDS(dtype)) {
+        return 0;
+    }
+    switch (dtype->type_num) {
+        case NPY_BOOL:
+        case NPY_BYTE:
+        case NPY_UBYTE:
+        case NPY_SHORT:
+        case NPY_USHORT:
+        case NPY_INT:
+        case NPY_UINT:
+        case NPY_LONG:
+        case NPY_ULONG:
+        case NPY_LONGLONG:
+        case NPY_ULONGLONG:
+        case NPY_HALF:
+        case NPY_FLOAT:
+        case NPY_DOUBLE:
+        case NPY_LONGDOUBLE:
+            return 1;
+        case NPY_STRING:
+            return dtype->elsize > 0;
+        default:
+            return 0;
+    }
+}
+
+static void
+text_column_init(text_column *column, PyArray_Descr *dtype, npy_intp offset)
+{
+    column->type_num = dtype->type_num;
+    column->offset = offset;
+    column->itemsize = dtype->elsize;
+    column->swap = (dtype->elsize > 1 && dtype->type_num != NPY_STRING &&
+                    !PyArray_ISNBO(dtype->byteorder));
+}
+
+/*
+ * Sets up the columns of a structured dtype, one per field. Returns 0
+ * on success, -1 with an exception set on failure.
+ */
+static int
+text_reader_init_fields(text_reader *r)
+{
+    PyArray_Descr *dtype = r->dtype;
+    npy_intp i, nfields = PyTuple_GET_SIZE(dtype->names);
+
+    r->columns = malloc(nfields * sizeof(text_column));
+    if (r->columns == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    for (i = 0; i < nfields; ++i) {
+        PyObject *tup = PyDict_GetItem(dtype->fields,
+                                    PyTuple_GET_ITEM(dtype->names, i));
+        PyArray_Descr *field_dtype;
+        npy_intp offset;
+
+        if (tup == NULL) {
+            PyErr_SetString(PyExc_RuntimeError, "invalid dtype fields");
+            return -1;
+        }
+        field_dtype = (PyArray_Descr *)PyTuple_GET_ITEM(tup, 0);
+        offset = PyArray_PyIntAsIntp(PyTuple_GET_ITEM(tup, 1));
+        if (offset == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (!text_column_supported(field_dtype)) {
+            PyErr_SetString(PyExc_TypeError,
+                    "the fields of the dtype must be of boolean, integer, "
+                    "floating point or string type");
+            return -1;
+        }
+        text_column_init(&r->columns[i], field_dtype, offset);
+    }
+    r->ncolumns = nfields;
+    r->rowsize = dtype->elsize;
+    if (r->nusecols > 0 && r->nusecols < nfields) {
+        PyErr_SetString(PyExc_ValueError,
+                "usecols must select a column for each field of the dtype");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * Sets up 'ncolumns' columns of the plain dtype of the reader. Doesn't
+ * need the GIL. Returns 0 on success, -1 if out of memory.
+ */
+static int
+text_reader_init_columns(text_reader *r, npy_intp ncolumns)
+{
+    npy_intp i;
+
+    r->columns = malloc(ncolumns * sizeof(text_column));
+    if (r->columns == NULL) {
+        return -1;
+    }
+    for (i = 0; i < ncolumns; ++i) {
+        text_column_init(&r->columns[i], r->dtype, i * r->dtype->elsize);
+    }
+    r->ncolumns = ncolumns;
+    r->rowsize = ncolumns * r->dtype->elsize;
+    return 0;
+}
+
+static int
+text_add_field(text_reader *r, const char *start, const char *end,
+                                                    int escaped)
+{
+    if (r->nfields == r->fields_capacity) {
+        npy_intp new_capacity = 2*r->fields_capacity + 8;
+        text_field *new_fields = realloc(r->fields,
+                                    new_capacity * sizeof(text_field));
+        if (new_fields == NULL) {
+            return -1;
+        }
+        r->fields = new_fields;
+        r->fields_capacity = new_capacity;
+    }
+    r->fields[r->nfields].start = start;
+    r->fields[r->nfields].end = end;
+    r->fields[r->nfields].escaped = escaped;
+    ++r->nfields;
+    return 0;
+}
+
+/*
+ * Splits the row starting at 'p' into fields. Returns 1 and sets
+ * *next to the start of the following row if a complete row was found,
+ * 0 if more data is needed to tell where the row ends, and -1 if out
+ * of memory. Unless 'final' is set, a row is only complete once its
+ * newline has been seen.
+ *
+ * A row without any fields is empty, and should be skipped.
+ */
+static int
+text_tokenize_row(text_reader *r, const char *p, const char *end,
+                                        int final, const char **next)
+{
+    const char quote = r->quotechar, delimiter = r->delimiter;
+    const char *q = p, *content_end;
+    const char *field_start = (delimiter != '\0') ? p : NULL;
+    const char *quote_start = NULL, *quote_end = NULL;
+    int in_quote = 0, escaped = 0, blank = 1, has_content = 0;
+
+#define ADD_FIELD(fend)                                                   \
+        do {                                                              \
+            int ret_;                                                     \
+            if (quote_start != NULL) {                                    \
+                ret_ = text_add_field(r, quote_start + 1,                 \
+                            (quote_end != NULL) ? quote_end : (fend),     \
+                            escaped);                                     \
+            }                                                             \
+            else {                                                        \
+                ret_ = text_add_field(r, field_start, (fend), 0);         \
+            }                                                             \
+            if (ret_ < 0) {                                               \
+                return -1;                                                \
+            }                                                             \
+            quote_start = quote_end = NULL;                               \
+            escaped = 0;                                                  \
+        } while (0)
+
+    r->nfields = 0;
+    r->row_newlines = 0;
+
+    for (;;) {
+        char c;
+
+        if (q == end) {
+            if (!final) {
+                return 0;
+            }
+            content_end = q;
+            break;
+        }
+        c = *q;
+
+        if (in_quote) {
+            if (c == quote) {
+                if (q + 1 == end && !final) {
+                    return 0;
+                }
+                if (q + 1 < end && q[1] == quote) {
+                    escaped = 1;
+                    q += 2;
+                    continue;
+                }
+                in_quote = 0;
+                quote_end = q;
+            }
+            else if (c == '\n') {
+                ++r->row_newlines;
+            }
+            ++q;
+            continue;
+        }
+
+        if (c == '\n' || c == '\r') {
+            content_end = q;
+            break;
+        }
+        if (r->comments != NULL && c == r->comments[0]) {
+            if (end - q < r->comments_len) {
+                if (!final) {
+                    return 0;
+                }
+            }
+            else if (memcmp(q, r->comments, r->comments_len) == 0) {
+                content_end = q;
+                while (q < end && *q != '\n' && *q != '\r') {
+                    ++q;
+                }
+                if (q == end && !final) {
+                    return 0;
+                }
+                break;
+            }
+        }
+
+        if (delimiter == '\0') {
+            if (c == ' ' || c == '\t' || c == '\v' || c == '\f') {
+                if (field_start != NULL) {
+                    ADD_FIELD(q);
+                    field_start = NULL;
+                }
+            }
+            else if (field_start == NULL) {
+                field_start = q;
+                if (c == quote && quote != '\0') {
+                    in_quote = 1;
+                    quote_start = q;
+                }
+            }
+        }
+        else if (c == delimiter) {
+            ADD_FIELD(q);
+            field_start = q + 1;
+            blank = 1;
+            has_content = 1;
+        }
+        else if (blank && !NumPyOS_ascii_isspace(c)) {
+            blank = 0;
+            has_content = 1;
+            if (c == quote && quote != '\0') {
+                in_quote = 1;
+                quote_start = q;
+            }
+        }
+        ++q;
+    }
+
+    /* The last field of the row */
+    if (delimiter == '\0') {
+        if (field_start != NULL) {
+            ADD_FIELD(content_end);
+        }
+    }
+    else if (has_content) {
+        ADD_FIELD(content_end);
+    }
+#undef ADD_FIELD
+
+    /* Skip the newline, which may be "\r\n" */
+    if (q < end) {
+        if (*q == '\r' && q + 1 == end && !final) {
+            return 0;
+        }
+        q += (*q == '\r' && q + 1 < end && q[1] == '\n') ? 2 : 1;
+    }
+    *next = q;
+    return 1;
+}
+
+/*
+ * Parses an integer, allowing a sign, into *out. Returns 0 on success,
+ * -1 if the text isn't an integer, and -2 on overflow.
+ */
+static int
+text_parse_int64(const char *s, const char *e, npy_int64 *out)
+{
+    npy_uint64 value = 0, limit;
+    int negative = 0;
+
+    if (s < e && (*s == '-' || *s == '+')) {
+        negative = (*s == '-');
+        ++s;
+    }
+    if (s == e) {
+        return -1;
+    }
+    limit = negative ? (npy_uint64)NPY_MAX_INT64 + 1 : NPY_MAX_INT64;
+    for (; s < e; ++s) {
+        int digit = *s - '0';
+
+        if (digit < 0 || digit > 9) {
+            return -1;
+        }
+        if (value > (limit - digit) / 10) {
+            return -2;
+        }
+        value = value * 10 + digit;
+    }
+    *out = negative ? (npy_int64)(0 - value) : (npy_int64)value;
+    return 0;
+}
+
+/* Like text_parse_int64, for unsigned integers without a sign */
+static int
+text_parse_uint64(const char *s, const char *e, npy_uint64 *out)
+{
+    npy_uint64 value = 0;
+
+    if (s < e && *s == '+') {
+        ++s;
+    }
+    if (s == e) {
+        return -1;
+    }
+    for (; s < e; ++s) {
+        int digit = *s - '0';
+
+        if (digit < 0 || digit > 9) {
+            return -1;
+        }
+        if (value > (NPY_MAX_UINT64 - digit) / 10) {
+            return -2;
+        }
+        value = value * 10 + digit;
+    }
+    *out = value;
+    return 0;
+}
+
+/* Parses a whole field as a double. Returns 0 on success, -1 if invalid */
+static int
+text_parse_double(const char *s, const char *e, double *out)
+{
+    char *endptr;
+
+    *out = NumPyOS_ascii_strtod_fast(s, e, &endptr);
+    return (endptr == e && endptr != s) ? 0 : -1;
+}
+
+/*
+ * Parses an integer field. Unless 'strict' is true, also accepts a
+ * floating point value, which is truncated towards zero, as
+ * int(float(text)) does.
+ */
+static int
+text_parse_integer(const char *s, const char *e, npy_int64 *out,
+                                                        int strict)
+{
+    double d;
+    int ret = text_parse_int64(s, e, out);
+
+    if (ret != -1) {
+        return (ret == 0) ? TEXT_OK : TEXT_OVERFLOW;
+    }
+    if (strict || text_parse_double(s, e, &d) < 0) {
+        return TEXT_BAD_VALUE;
+    }
+    if (!(d > -9223372036854775808.0 && d < 9223372036854775808.0)) {
+        return TEXT_OVERFLOW;
+    }
+    *out = (npy_int64)d;
+    return TEXT_OK;
+}
+
+/* Like text_parse_integer, for unsigned 64 bit integers */
+static int
+text_parse_unsigned(const char *s, const char *e, npy_uint64 *out,
+                                                        int strict)
+{
+    double d;
+    npy_int64 value;
+    int ret;
+
+    if (*s == '-') {
+        /* Negative values wrap around, as in a cast */
+        ret = text_parse_integer(s, e, &value, strict);
+        *out = (npy_uint64)value;
+        return ret;
+    }
+    ret = text_parse_uint64(s, e, out);
+    if (ret != -1) {
+        return (ret == 0) ? TEXT_OK : TEXT_OVERFLOW;
+    }
+    if (strict || text_parse_double(s, e, &d) < 0) {
+        return TEXT_BAD_VALUE;
+    }
+    if (!(d >= 0 && d < 18446744073709551616.0)) {
+        return TEXT_OVERFLOW;
+    }
+    *out = (npy_uint64)d;
+    return TEXT_OK;
+}
+
+/* Copies a string field, removing the escaping of quote characters */
+static void
+text_copy_string(text_reader *r, const text_field *field, char *dst,
+                                                        int itemsize)
+{
+    const char *s = field->start;
+    int n = 0;
+
+    if (!field->escaped) {
+        n = (int)NPY_MIN(field->end - s, itemsize);
+        memcpy(dst, s, n);
+    }
+    else {
+        while (s < field->end && n < itemsize) {
+            dst[n++] = *s;
+            s += (*s == r->quotechar) ? 2 : 1;
+        }
+    }
+    memset(dst + n, 0, itemsize - n);
+}
+
+static void
+text_byte_swap(char *p, int n)
+{
+    char *q = p + n - 1, tmp;
+
+    while (p < q) {
+        tmp = *p;
+        *p++ = *q;
+        *q-- = tmp;
+    }
+}
+
+#define TEXT_STORE(type, value)                                           \
+        do {                                                              \
+            type tmp_ = (type)(value);                                    \
+            memcpy(dst, &tmp_, sizeof(type));                             \
+        } while (0)
+
+/*
+ * Converts 'field' according to 'column' and stores it at 'dst'.
+ * Returns TEXT_OK or an error code.
+ */
+static int
+text_convert_field(text_reader *r, const text_field *field,
+                                const text_column *column, char *dst)
+{
+    const char *s = field->start, *e = field->end;
+    npy_int64 ivalue = 0;
+    npy_uint64 uvalue = 0;
+    double dvalue = 0;
+    int ret = TEXT_OK;
+
+    if (column->type_num == NPY_STRING) {
+        text_copy_string(r, field, dst, column->itemsize);
+        return TEXT_OK;
+    }
+
+    /* Numbers may be surrounded by whitespace */
+    while (s < e && NumPyOS_ascii_isspace(*s)) {
+        ++s;
+    }
+    while (e > s && NumPyOS_ascii_isspace(e[-1])) {
+        --e;
+    }
+    if (s == e) {
+        return TEXT_BAD_VALUE;
+    }
+
+    switch (column->type_num) {
+        case NPY_HALF:
+        case NPY_FLOAT:
+        case NPY_DOUBLE:
+        case NPY_LONGDOUBLE:
+            if (text_parse_double(s, e, &dvalue) < 0) {
+                return TEXT_BAD_VALUE;
+            }
+            break;
+        /*
+         * Booleans and 64 bit integers only accept integers, as the
+         * bool(int(text)), np.int64(text) and np.uint64(text) of the
+         * Python path do. The other integers also accept floating point
+         * values, as int(float(text)) does.
+         */
+        case NPY_BOOL:
+            ret = text_parse_int64(s, e, &ivalue);
+            if (ret == -2) {
+                /* Too big, but still true */
+                ivalue = 1;
+            }
+            ret = (ret == -1) ? TEXT_BAD_VALUE : TEXT_OK;
+            break;
+        case NPY_UBYTE:
+        case NPY_USHORT:
+        case NPY_UINT:
+        case NPY_ULONG:
+        case NPY_ULONGLONG:
+            ret = text_parse_unsigned(s, e, &uvalue,
+                                column->type_num == NPY_UINT64);
+            break;
+        default:
+            ret = text_parse_integer(s, e, &ivalue,
+                                column->type_num == NPY_INT64);
+            break;
+    }
+    if (ret != TEXT_OK) {
+        return ret;
+    }
+
+    switch (column->type_num) {
+        case NPY_BOOL:
+            TEXT_STORE(npy_bool, ivalue != 0);
+            break;
+        case NPY_BYTE:
+            TEXT_STORE(npy_byte, ivalue);
+            break;
+        case NPY_UBYTE:
+            TEXT_STORE(npy_ubyte, uvalue);
+            break;
+        case NPY_SHORT:
+            TEXT_STORE(npy_short, ivalue);
+            break;
+        case NPY_USHORT:
+            TEXT_STORE(npy_ushort, uvalue);
+            break;
+        case NPY_INT:
+            TEXT_STORE(npy_int, ivalue);
+            break;
+        case NPY_UINT:
+            TEXT_STORE(npy_uint, uvalue);
+            break;
+        case NPY_LONG:
+            TEXT_STORE(npy_long, ivalue);
+            break;
+        case NPY_ULONG:
+            TEXT_STORE(npy_ulong, uvalue);
+            break;
+        case NPY_LONGLONG:
+            TEXT_STORE(npy_longlong, ivalue);
+            break;
+        case NPY_ULONGLONG:
+            TEXT_STORE(npy_ulonglong, uvalue);
+            break;
+        case NPY_HALF:
+            TEXT_STORE(npy_half, npy_double_to_half(dvalue));
+            break;
+        case NPY_FLOAT:
+            TEXT_STORE(npy_float, dvalue);
+            break;
+        case NPY_DOUBLE:
+            TEXT_STORE(npy_double, dvalue);
+            break;
+        case NPY_LONGDOUBLE:
+            TEXT_STORE(npy_longdouble, dvalue);
+            break;
+    }
+    if (column->swap) {
+        text_byte_swap(dst, column->itemsize);
+    }
+    return TEXT_OK;
+}
+
+#undef TEXT_STORE
+
+/* Records an error found in 'field' of the current row */
+static void
+text_set_error(text_reader *r, int error, const text_field *field,
+                                                    npy_intp column)
+{
+    npy_intp n = 0;
+
+    r->error = error;
+    r->error_column = column;
+    if (field != NULL) {
+        n = NPY_MIN(field->end - field->start,
+                    (npy_intp)sizeof(r->error_text) - 1);
+        memcpy(r->error_text, field->start, n);
+    }
+    r->error_text[n] = '\0';
+}
+
+/*
+ * Converts the fields of the current row into a new row of the output
+ * buffer. Doesn't need the GIL. Returns 0 on success, -1 on error.
+ */
+static int
+text_store_row(text_reader *r)
+{
+    npy_intp i;
+    char *row;
+
+    if (r->ncolumns < 0 &&
+                text_reader_init_columns(r, r->nfields) < 0) {
+        text_set_error(r, TEXT_NO_MEMORY, NULL, 0);
+        return -1;
+    }
+
+    if (r->count_only) {
+        ++r->nrows;
+        return 0;
+    }
+
+    if (r->nrows == r->capacity) {
+        npy_intp new_capacity;
+        char *new_data;
+
+        if (r->out != NULL) {
+            text_set_error(r, TEXT_TOO_MANY_ROWS, NULL, 0);
+            return -1;
+        }
+        if (r->capacity == 0) {
+            new_capacity = TEXT_INITIAL_BUFSIZE / NPY_MAX(r->rowsize, 1) + 1;
+        }
+        else {
+            /* Grow geometrically, for amortized constant time appends */
+            new_capacity = r->capacity + r->capacity / 2;
+        }
+        new_data = PyDataMem_RENEW(r->data, new_capacity * r->rowsize);
+        if (new_data == NULL) {
+            text_set_error(r, TEXT_NO_MEMORY, NULL, 0);
+            return -1;
+        }
+        r->data = new_data;
+        r->capacity = new_capacity;
+    }
+
+    row = r->data + r->nrows * r->rowsize;
+    if (PyDataType_HASFIELDS(r->dtype)) {
+        /* Clear any padding between the fields */
+        memset(row, 0, r->rowsize);
+    }
+    for (i = 0; i < r->ncolumns; ++i) {
+        npy_intp index = (r->nusecols > 0) ? r->usecols[i] : i;
+        int ret;
+
+        if (index < 0) {
+            index += r->nfields;
+        }
+        if (index < 0 || index >= r->nfields) {
+            text_set_error(r, TEXT_TOO_FEW_COLUMNS, NULL, index);
+            return -1;
+        }
+        ret = text_convert_field(r, &r->fields[index],
+                                 &r->columns[i], row + r->columns[i].offset);
+        if (ret != TEXT_OK) {
+            text_set_error(r, ret, &r->fields[index], index);
+            return -1;
+        }
+    }
+    ++r->nrows;
+    return 0;
+}
+
+/* Whether the reader has got the largest number of rows it may read */
+#define TEXT_READER_FULL(r) ((r)->max_rows >= 0 && \
+                             (r)->nrows >= (r)->max_rows)
+
+/*
+ * Parses the complete rows in [*pbuf, end), or all of it if 'final' is
+ * set, appending them to the output buffer, and advances *pbuf past the
+ * parsed rows. Stops early once max_rows rows have been read. Doesn't
+ * need the GIL. Returns 0 on success, -1 on error.
+ */
+static int
+text_parse_rows(text_reader *r, const char **pbuf, const char *end,
+                                                        int final)
+{
+    const char *p = *pbuf, *next;
+    int ret = 0;
+
+    while (p < end && !TEXT_READER_FULL(r)) {
+        if (r->skiprows > 0) {
+            const char *q = p;
+
+            while (q < end && *q != '\n' && *q != '\r') {
+                ++q;
+            }
+            if ((q == end || (*q == '\r' && q + 1 == end)) && !final) {
+                break;
+            }
+            if (q < end) {
+                q += (*q == '\r' && q + 1 < end && q[1] == '\n') ? 2 : 1;
+            }
+            --r->skiprows;
+            ++r->line;
+            p = q;
+            continue;
+        }
+
+        ret = text_tokenize_row(r, p, end, final, &next);
+        if (ret == 0) {
+            break;
+        }
+        if (ret < 0) {
+            text_set_error(r, TEXT_NO_MEMORY, NULL, 0);
+            break;
+        }
+        ret = 0;
+        if (r->nfields > 0 && text_store_row(r) < 0) {
+            ret = -1;
+            break;
+        }
+        r->line += 1 + r->row_newlines;
+        p = next;
+    }
+    *pbuf = p;
+    return ret;
+}
+
+/* Raises the exception for the error recorded in the reader */
+static void
+text_reader_raise(text_reader *r)
+{
+    switch (r->error) {
+        case TEXT_NO_MEMORY:
+            PyErr_NoMemory();
+            break;
+        case TEXT_BAD_VALUE:
+            PyErr_Format(PyExc_ValueError,
+                    "could not convert '%s' in line %zd, column %zd",
+                    r->error_text, (Py_ssize_t)r->line,
+                    (Py_ssize_t)r->error_column);
+            break;
+        case TEXT_OVERFLOW:
+            PyErr_Format(PyExc_OverflowError,
+                    "value '%s' in line %zd, column %zd is out of range",
+                    r->error_text, (Py_ssize_t)r->line,
+                    (Py_ssize_t)r->error_column);
+            break;
+        case TEXT_TOO_FEW_COLUMNS:
+            PyErr_Format(PyExc_ValueError,
+                    "line %zd has %zd columns, but column %zd was "
+                    "requested", (Py_ssize_t)r->line,
+                    (Py_ssize_t)r->nfields, (Py_ssize_t)r->error_column);
+            break;
+        case TEXT_TOO_MANY_ROWS:
+            PyErr_Format(PyExc_ValueError,
+                    "line %zd doesn't fit, the output array only has "
+                    "room for %zd rows", (Py_ssize_t)r->line,
+                    (Py_ssize_t)r->capacity);
+            break;
+    }
+}
+
+/*
+ * Creates the result array from the output buffer, which it takes
+ * over. Returns a new reference, or NULL on failure.
+ */
+static PyObject *
+text_reader_result(text_reader *r)
+{
+    npy_intp dims[2];
+    int nd;
+    PyObject *ret;
+
+    dims[0] = r->nrows;
+    if (PyDataType_HASFIELDS(r->dtype)) {
+        nd = 1;
+    }
+    else {
+        nd = 2;
+        dims[1] = NPY_MAX(r->ncolumns, 0);
+    }
+
+    if (r->count_only) {
+        return Py_BuildValue("nn", (Py_ssize_t)r->nrows,
+                             (Py_ssize_t)NPY_MAX(r->ncolumns, 0));
+    }
+    if (r->out != NULL) {
+        /* The rows that were filled in */
+        return PySequence_GetSlice((PyObject *)r->out, 0, r->nrows);
+    }
+
+    Py_INCREF(r->dtype);
+    if (r->nrows == 0) {
+        return PyArray_NewFromDescr(&PyArray_Type, r->dtype, nd, dims,
+                                    NULL, NULL, 0, NULL);
+    }
+
+    /* Give back the unused part of the buffer */
+    if (r->capacity > r->nrows) {
+        char *new_data = PyDataMem_RENEW(r->data, r->nrows * r->rowsize);
+        if (new_data != NULL) {
+            r->data = new_data;
+            r->capacity = r->nrows;
+        }
+    }
+    ret = PyArray_NewFromDescr(&PyArray_Type, r->dtype, nd, dims,
+                               NULL, r->data, NPY_ARRAY_CARRAY, NULL);
+    if (ret == NULL) {
+        return NULL;
+    }
+    PyArray_ENABLEFLAGS((PyArrayObject *)ret, NPY_ARRAY_OWNDATA);
+    r->data = NULL;
+    return ret;
+}
+
+static void
+text_reader_dealloc(text_reader *r)
+{
+    free(r->columns);
+    free(r->fields);
+    if (r->out == NULL) {
+        PyDataMem_FREE(r->data);
+    }
+    PyArray_free(r->usecols);
+}
+
+/*
+ * Converts a bytes object of length one, or None, to a character, where
+ * None gives '\0'. Returns 0 on success, -1 with an exception set.
+ */
+static int
+text_char_converter(PyObject *obj, char *c, const char *name)
+{
+    if (obj == Py_None) {
+        *c = '\0';
+        return 0;
+    }
+    if (!PyBytes_Check(obj) || PyBytes_GET_SIZE(obj) != 1) {
+        PyErr_Format(PyExc_TypeError,
+                "%s must be a single byte or None", name);
+        return -1;
+    }
+    *c = PyBytes_AS_STRING(obj)[0];
+    return 0;
+}
+
+NPY_NO_EXPORT PyObject *
+array__loadtxt(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"chunks", "dtype", "delimiter", "comments",
+                             "quotechar", "skiprows", "usecols", "max_rows",
+                             "firstline", "count", "out", NULL};
+    PyObject *chunks, *delimiter = Py_None, *comments = Py_None;
+    PyObject *quotechar = Py_None, *usecols = Py_None;
+    PyObject *iter = NULL, *item, *ret = NULL, *rest = NULL;
+    PyArrayObject *out = NULL;
+    Py_ssize_t skiprows = 0, max_rows = -1, firstline = 1;
+    char *carry = NULL;
+    npy_intp carry_len = 0, carry_capacity = 0;
+    const char *p;
+    text_reader r;
+    int res = 0;
+    NPY_BEGIN_THREADS_DEF;
+
+    memset(&r, 0, sizeof(r));
+    r.ncolumns = -1;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO&|OOOnOnniO!:_loadtxt",
+                kwlist, &chunks, &PyArray_DescrConverter, &r.dtype,
+                &delimiter, &comments, &quotechar, &skiprows, &usecols,
+                &max_rows, &firstline, &r.count_only,
+                &PyArray_Type, &out)) {
+        return NULL;
+    }
+    r.max_rows = NPY_MAX(max_rows, -1);
+    r.line = firstline;
+
+    if (text_char_converter(delimiter, &r.delimiter, "delimiter") < 0 ||
+            text_char_converter(quotechar, &r.quotechar, "quotechar") < 0) {
+        goto finish;
+    }
+    if (r.delimiter != '\0' && r.delimiter == r.quotechar) {
+        PyErr_SetString(PyExc_ValueError,
+                "delimiter and quotechar must be different");
+        goto finish;
+    }
+    if (comments != Py_None) {
+        if (!PyBytes_Check(comments) || PyBytes_GET_SIZE(comments) == 0) {
+            PyErr_SetString(PyExc_TypeError,
+                    "comments must be a non-empty bytes object or None");
+            goto finish;
+        }
+        r.comments = PyBytes_AS_STRING(comments);
+        r.comments_len = PyBytes_GET_SIZE(comments);
+    }
+    r.skiprows = NPY_MAX(skiprows, 0);
+
+    if (usecols != Py_None) {
+        PyObject *seq = PySequence_Fast(usecols,
+                                        "usecols must be a sequence");
+        npy_intp i;
+
+        if (seq == NULL) {
+            goto finish;
+        }
+        r.nusecols = PySequence_Fast_GET_SIZE(seq);
+        r.usecols = PyArray_malloc(NPY_MAX(r.nusecols, 1) * sizeof(npy_intp));
+        if (r.usecols == NULL) {
+            Py_DECREF(seq);
+            PyErr_NoMemory();
+            goto finish;
+        }
+        for (i = 0; i < r.nusecols; ++i) {
+            r.usecols[i] = PyArray_PyIntAsIntp(
+                                    PySequence_Fast_GET_ITEM(seq, i));
+            if (r.usecols[i] == -1 && PyErr_Occurred()) {
+                Py_DECREF(seq);
+                goto finish;
+            }
+        }
+        Py_DECREF(seq);
+    }
+
+    if (PyDataType_HASFIELDS(r.dtype)) {
+        if (text_reader_init_fields(&r) < 0) {
+            goto finish;
+        }
+    }
+    else if (!text_column_supported(r.dtype)) {
+        PyErr_SetString(PyExc_TypeError,
+                "the dtype must be of boolean, integer, floating point "
+                "or string type");
+        goto finish;
+    }
+    else if (r.nusecols > 0 &&
+                text_reader_init_columns(&r, r.nusecols) < 0) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+
+    if (out != NULL) {
+        int nd = PyDataType_HASFIELDS(r.dtype) ? 1 : 2;
+
+        if (PyArray_NDIM(out) != nd ||
+                !PyArray_EquivTypes(PyArray_DESCR(out), r.dtype) ||
+                !PyArray_ISCARRAY(out) || PyArray_HASMASKNA(out)) {
+            PyErr_Format(PyExc_ValueError,
+                    "out must be a writeable, C-contiguous %d-dimensional "
+                    "array of the requested dtype", nd);
+            goto finish;
+        }
+        if (nd == 2) {
+            npy_intp ncolumns = PyArray_DIM(out, 1);
+
+            if (r.ncolumns < 0 &&
+                    text_reader_init_columns(&r, ncolumns) < 0) {
+                PyErr_NoMemory();
+                goto finish;
+            }
+            if (r.ncolumns != ncolumns) {
+                PyErr_SetString(PyExc_ValueError,
+                        "out doesn't have one column per used column");
+                goto finish;
+            }
+        }
+        r.out = out;
+        r.data = PyArray_DATA(out);
+        r.capacity = PyArray_DIM(out, 0);
+    }
+
+    iter = PyObject_GetIter(chunks);
+    if (iter == NULL) {
+        goto finish;
+    }
+    while (!TEXT_READER_FULL(&r) && (item = PyIter_Next(iter)) != NULL) {
+        const char *buf, *end;
+        npy_intp len;
+
+        if (!PyBytes_Check(item)) {
+            PyErr_SetString(PyExc_TypeError,
+                    "the text must be given as bytes");
+            Py_DECREF(item);
+            goto finish;
+        }
+        buf = PyBytes_AS_STRING(item);
+        len = PyBytes_GET_SIZE(item);
+
+        if (carry_len > 0) {
+            /* Complete the row left over from the previous chunk */
+            if (carry_len + len > carry_capacity) {
+                npy_intp new_capacity = 2*(carry_len + len);
+                char *new_carry = PyArray_realloc(carry, new_capacity);
+                if (new_carry == NULL) {
+                    Py_DECREF(item);
+                    PyErr_NoMemory();
+                    goto finish;
+                }
+                carry = new_carry;
+                carry_capacity = new_capacity;
+            }
+            memcpy(carry + carry_len, buf, len);
+            carry_len += len;
+            buf = carry;
+            len = carry_len;
+        }
+
+        p = buf;
+        end = buf + len;
+        NPY_BEGIN_THREADS;
+        res = text_parse_rows(&r, &p, end, 0);
+        NPY_END_THREADS;
+        if (res < 0) {
+            Py_DECREF(item);
+            text_reader_raise(&r);
+            goto finish;
+        }
+
+        if (TEXT_READER_FULL(&r)) {
+            /* Hand back the text which hasn't been parsed */
+            rest = PyBytes_FromStringAndSize(p, end - p);
+            Py_DECREF(item);
+            if (rest == NULL) {
+                goto finish;
+            }
+            break;
+        }
+
+        /* Keep the incomplete row at the end for the next chunk */
+        if (buf == carry) {
+            memmove(carry, p, end - p);
+            carry_len = end - p;
+        }
+        else if (p < end) {
+            if (end - p > carry_capacity) {
+                npy_intp new_capacity = 2*(end - p);
+                char *new_carry = PyArray_realloc(carry, new_capacity);
+                if (new_carry == NULL) {
+                    Py_DECREF(item);
+                    PyErr_NoMemory();
+                    goto finish;
+                }
+                carry = new_carry;
+                carry_capacity = new_capacity;
+            }
+            memcpy(carry, p, end - p);
+            carry_len = end - p;
+        }
+        Py_DECREF(item);
+    }
+    if (PyErr_Occurred()) {
+        goto finish;
+    }
+
+    if (rest == NULL) {
+        /* The last row may not end with a newline */
+        p = carry;
+        if (text_parse_rows(&r, &p, carry + carry_len, 1) < 0) {
+            text_reader_raise(&r);
+            goto finish;
+        }
+        rest = PyBytes_FromStringAndSize(p, carry + carry_len - p);
+        if (rest == NULL) {
+            goto finish;
+        }
+    }
+
+    ret = text_reader_result(&r);
+    if (ret != NULL && max_rows >= 0) {
+        /* Give the caller what it needs to carry on where this stopped */
+        ret = Py_BuildValue("NNn", ret, rest, (Py_ssize_t)r.line);
+        rest = NULL;
+    }
+
+finish:
+    Py_XDECREF(rest);
+    Py_XDECREF(iter);
+    PyArray_free(carry);
+    text_reader_dealloc(&r);
+    Py_XDECREF(r.dtype);
+    return ret;
+}
@@ -0,0 +1,14 @@
+#ifndef _NPY_PRIVATE__TEXTREADER_H_
+#define _NPY_PRIVATE__TEXTREADER_H_
+
+/*
+ * Python wrapper which parses delimited text, given as an iterable of
+ * bytes chunks, into a new array, or into the rows of 'out'. With
+ * 'count' set, it returns the number of rows and columns instead. With
+ * 'max_rows' given, it stops after that many rows and returns the array
+ * together with the unparsed text and the number of the next line.
+ */
+NPY_NO_EXPORT PyObject *
+array__loadtxt(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds);
+
+#endif
@@ -0,0 +1,799 @@
+/*
+ * This file implements the formatting of numbers as text, for
+ * numpy.savetxt and ndarray.tofile with a separator. The numbers are
+ * written with printf-style conversions, or in the shortest form which
+ * reads back to the same value, straight into a buffer instead of going
+ * through a Python object per element.
+ *
+ * Where C and Python formatting differ, such as for nan and inf, the
+ * element is formatted by Python, so that the output is always the same
+ * as that of the '%' operator.
+ *
+ * See LICENSE.txt for the license.
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#define NPY_NO_DEPRECATED_API
+#define _MULTIARRAYMODULE
+#include <numpy/arrayobject.h>
+#include <numpy/halffloat.h>
+
+#include "npy_config.h"
+#include "numpy/npy_3kcompat.h"
+
+#include "numpyos.h"
+#include "textwriter.h"
+
+/* A growable output buffer */
+typedef struct {
+    char *data;
+    npy_intp len;
+    npy_intp capacity;
+} text_buffer;
+
+/* How tofile writes its buffer out, in bytes */
+#define TEXT_FLUSH_SIZE (64*1024)
+
+/* Largest width and precision formatted in C */
+#define TEXT_MAX_WIDTH 1000
+
+/* The kinds of conversions */
+enum {
+    TEXT_CONV_INT,      /* d, i, u, o, x, X */
+    TEXT_CONV_FLOAT,    /* e, E, f, F, g, G */
+    TEXT_CONV_REPR,     /* r */
+    TEXT_CONV_STR       /* str() of each element, for tofile */
+};
+
+/* A conversion of a format, with the literal text before it */
+typedef struct {
+    char *prefix;
+    npy_intp prefix_len;
+    int kind;
+    char conversion;
+    int width;
+    int precision;
+    int left;
+    /*
+     * Whether Python formats numpy scalars rather than Python numbers,
+     * as for the rows of a 2-d array, which only matters for repr
+     */
+    int scalars;
+    /* The conversion for PyOS_snprintf, and as given for Python */
+    char spec[48];
+    char pyspec[48];
+} text_conversion;
+
+typedef struct {
+    text_conversion *conversions;
+    npy_intp nconversions;
+    char *suffix;
+    npy_intp suffix_len;
+} text_format;
+
+/* The value of an element, converted to the widest C type of its kind */
+typedef struct {
+    enum {TEXT_VALUE_INT, TEXT_VALUE_UINT, TEXT_VALUE_FLOAT} kind;
+    npy_longlong i;
+    npy_ulonglong u;
+    double d;
+} text_value;
+
+/*
+ * Makes room for 'n' more bytes in the buffer. Returns 0 on success,
+ * -1 with an exception set on failure.
+ */
+static int
+text_buffer_reserve(text_buffer *b, npy_intp n)
+{
+    if (b->len + n > b->capacity) {
+        npy_intp new_capacity = NPY_MAX(2*b->capacity, b->len + n);
+        char *new_data = PyArray_realloc(b->data, new_capacity);
+
+        if (new_data == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        b->data = new_data;
+        b->capacity = new_capacity;
+    }
+    return 0;
+}
+
+static int
+text_buffer_append(text_buffer *b, const char *s, npy_intp n)
+{
+    if (text_buffer_reserve(b, n) < 0) {
+        return -1;
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+    return 0;
+}
+
+/*
+ * Appends 's' padded with spaces to the width of the conversion, as
+ * Python does for %r and %s.
+ */
+static int
+text_buffer_append_padded(text_buffer *b, const text_conversion *c,
+                          const char *s, npy_intp n)
+{
+    npy_intp pad = NPY_MAX(c->width - n, 0);
+
+    if (text_buffer_reserve(b, n + pad) < 0) {
+        return -1;
+    }
+    if (!c->left) {
+        memset(b->data + b->len, ' ', pad);
+        b->len += pad;
+    }
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+    if (c->left) {
+        memset(b->data + b->len, ' ', pad);
+        b->len += pad;
+    }
+    return 0;
+}
+
+static void
+text_format_dealloc(text_format *f)
+{
+    npy_intp i;
+
+    for (i = 0; i < f->nconversions; ++i) {
+        PyArray_free(f->conversions[i].prefix);
+    }
+    PyArray_free(f->conversions);
+    PyArray_free(f->suffix);
+    f->conversions = NULL;
+    f->nconversions = 0;
+    f->suffix = NULL;
+}
+
+/*
+ * Parses the conversion starting at the '%' at 'p' into 'c', and sets
+ * *pend past it. Returns 1 if it can be formatted in C, 0 if not.
+ */
+static int
+text_parse_conversion(const char *p, const char **pend, text_conversion *c)
+{
+    const char *start = p, *flags;
+    int nflags, has_precision = 0;
+    char *q;
+
+    c->scalars = 0;
+    ++p;
+    flags = p;
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) {
+        ++p;
+    }
+    nflags = (int)(p - flags);
+    if (nflags > 5) {
+        return 0;
+    }
+    c->left = (memchr(flags, '-', nflags) != NULL);
+    c->width = 0;
+    while (*p >= '0' && *p <= '9' && c->width <= TEXT_MAX_WIDTH) {
+        c->width = 10*c->width + (*p++ - '0');
+    }
+    c->precision = 0;
+    if (*p == '.') {
+        ++p;
+        has_precision = 1;
+        while (*p >= '0' && *p <= '9' && c->precision <= TEXT_MAX_WIDTH) {
+            c->precision = 10*c->precision + (*p++ - '0');
+        }
+    }
+    if (c->width > TEXT_MAX_WIDTH || c->precision > TEXT_MAX_WIDTH ||
+                                     (*p >= '0' && *p <= '9')) {
+        return 0;
+    }
+    /* Python accepts and ignores length modifiers */
+    while (*p == 'h' || *p == 'l' || *p == 'L') {
+        ++p;
+    }
+    c->conversion = *p;
+    if (*p == '\0') {
+        return 0;
+    }
+    *pend = p + 1;
+
+    /* The conversion as given, for formatting with Python */
+    if (*pend - start >= (npy_intp)sizeof(c->pyspec)) {
+        return 0;
+    }
+    memcpy(c->pyspec, start, *pend - start);
+    c->pyspec[*pend - start] = '\0';
+
+    /* The conversion without length modifiers, for C */
+    q = c->spec;
+    *q++ = '%';
+    memcpy(q, flags, nflags);
+    q += nflags;
+    if (c->width > 0) {
+        q += sprintf(q, "%d", c->width);
+    }
+    if (has_precision) {
+        q += sprintf(q, ".%d", c->precision);
+    }
+    else {
+        c->precision = 6;
+    }
+
+    switch (c->conversion) {
+        case 'd':
+        case 'i':
+        case 'u':
+            /* Python prints negative numbers for %u */
+            c->conversion = 'd';
+            /* fall through */
+        case 'o':
+        case 'x':
+        case 'X':
+            /* The alternate forms differ between C and Python */
+            if (memchr(flags, '#', nflags) != NULL) {
+                return 0;
+            }
+            c->kind = TEXT_CONV_INT;
+            strcpy(q, NPY_LONGLONG_FMT);
+            q[strlen(q) - 1] = c->conversion;
+            return 1;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+            c->kind = TEXT_CONV_FLOAT;
+            *q++ = c->conversion;
+            *q = '\0';
+            return 1;
+        case 'r':
+            /* Precision truncates the repr, which is left to Python */
+            if (has_precision || nflags != (c->left ? 1 : 0)) {
+                return 0;
+            }
+            c->kind = TEXT_CONV_REPR;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Parses a printf-style format with 'nconversions' conversions. Returns
+ * 1 on success, 0 if the format can't be handled in C, with 'f' left
+ * empty, and -1 with an exception set on failure.
+ */
+static int
+text_parse_format(const char *fmt, npy_intp nconversions, text_format *f)
+{
+    npy_intp len = strlen(fmt), n = 0;
+    char *literal;
+    const char *p = fmt;
+
+    memset(f, 0, sizeof(*f));
+    f->conversions = PyArray_malloc(
+                        NPY_MAX(nconversions, 1) * sizeof(text_conversion));
+    literal = PyArray_malloc(len + 1);
+    if (f->conversions == NULL || literal == NULL) {
+        PyArray_free(literal);
+        text_format_dealloc(f);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    for (;;) {
+        if (*p == '%' && p[1] == '%') {
+            literal[n++] = '%';
+            p += 2;
+        }
+        else if (*p == '%' || *p == '\0') {
+            char *copy = PyArray_malloc(n + 1);
+
+            if (copy == NULL) {
+                PyArray_free(literal);
+                text_format_dealloc(f);
+                PyErr_NoMemory();
+                return -1;
+            }
+            memcpy(copy, literal, n);
+            copy[n] = '\0';
+            if (*p == '\0') {
+                f->suffix = copy;
+                f->suffix_len = n;
+                break;
+            }
+            if (f->nconversions == nconversions) {
+                PyArray_free(copy);
+                goto unsupported;
+            }
+            f->conversions[f->nconversions].prefix = copy;
+            f->conversions[f->nconversions].prefix_len = n;
+            ++f->nconversions;
+            if (!text_parse_conversion(p, &p,
+                        &f->conversions[f->nconversions - 1])) {
+                goto unsupported;
+            }
+            n = 0;
+        }
+        else {
+            literal[n++] = *p++;
+        }
+    }
+    PyArray_free(literal);
+    if (f->nconversions != nconversions) {
+        text_format_dealloc(f);
+        return 0;
+    }
+    return 1;
+
+unsupported:
+    PyArray_free(literal);
+    text_format_dealloc(f);
+    return 0;
+}
+
+/* Whether elements of 'dtype' can be formatted here */
+static int
+text_dtype_supported(PyArray_Descr *dtype)
+{
+    if (dtype->subarray != NULL || PyDataType_HASFIELDS(dtype)) {
+        return 0;
+    }
+    return PyTypeNum_ISBOOL(dtype->type_num) ||
+           PyTypeNum_ISINTEGER(dtype->type_num) ||
+           PyTypeNum_ISFLOAT(dtype->type_num);
+}
+
+/* Reads the element at 'data' into 'value' */
+static void
+text_get_value(PyArray_Descr *dtype, const char *data, text_value *value)
+{
+    union {
+        npy_longdouble ld;
+        char bytes[32];
+    } buf;
+    int elsize = dtype->elsize;
+
+    if (PyArray_ISNBO(dtype->byteorder) || elsize == 1) {
+        memcpy(buf.bytes, data, elsize);
+    }
+    else {
+        int k;
+
+        for (k = 0; k < elsize; ++k) {
+            buf.bytes[k] = data[elsize - 1 - k];
+        }
+    }
+
+    value->kind = TEXT_VALUE_INT;
+    switch (dtype->type_num) {
+#define CASE(num, type, value_kind, field)                              \
+        case num:                                                       \
+            value->kind = value_kind;                                   \
+            value->field = *(type *)buf.bytes;                          \
+            break;
+        CASE(NPY_BOOL, npy_bool, TEXT_VALUE_INT, i)
+        CASE(NPY_BYTE, npy_byte, TEXT_VALUE_INT, i)
+        CASE(NPY_UBYTE, npy_ubyte, TEXT_VALUE_INT, i)
+        CASE(NPY_SHORT, npy_short, TEXT_VALUE_INT, i)
+        CASE(NPY_USHORT, npy_ushort, TEXT_VALUE_INT, i)
+        CASE(NPY_INT, npy_int, TEXT_VALUE_INT, i)
+        CASE(NPY_UINT, npy_uint, TEXT_VALUE_INT, i)
+        CASE(NPY_LONG, npy_long, TEXT_VALUE_INT, i)
+        CASE(NPY_ULONG, npy_ulong, TEXT_VALUE_UINT, u)
+        CASE(NPY_LONGLONG, npy_longlong, TEXT_VALUE_INT, i)
+        CASE(NPY_ULONGLONG, npy_ulonglong, TEXT_VALUE_UINT, u)
+        CASE(NPY_FLOAT, npy_float, TEXT_VALUE_FLOAT, d)
+        CASE(NPY_DOUBLE, npy_double, TEXT_VALUE_FLOAT, d)
+        CASE(NPY_LONGDOUBLE, npy_longdouble, TEXT_VALUE_FLOAT, d)
+#undef CASE
+        case NPY_HALF:
+            value->kind = TEXT_VALUE_FLOAT;
+            value->d = npy_half_to_double(*(npy_half *)buf.bytes);
+            break;
+    }
+    if (value->kind == TEXT_VALUE_UINT && value->u <= NPY_MAX_LONGLONG) {
+        value->kind = TEXT_VALUE_INT;
+        value->i = (npy_longlong)value->u;
+    }
+}
+
+/*
+ * Formats the element at 'data' with Python, the way the '%' operator
+ * or str() does for the items or the scalars of an array.
+ */
+static int
+text_format_object(text_buffer *b, const text_conversion *c,
+                   PyArray_Descr *dtype, char *data)
+{
+    PyObject *obj, *str;
+    text_value value;
+    int ret;
+
+    if (c->scalars || dtype->type_num == NPY_LONGDOUBLE) {
+        Py_INCREF(dtype);
+        obj = PyArray_Scalar(data, dtype, NULL);
+    }
+    else {
+        text_get_value(dtype, data, &value);
+        if (dtype->type_num == NPY_BOOL) {
+            obj = PyBool_FromLong((long)value.i);
+        }
+        else if (value.kind == TEXT_VALUE_INT) {
+            obj = PyLong_FromLongLong(value.i);
+        }
+        else if (value.kind == TEXT_VALUE_UINT) {
+            obj = PyLong_FromUnsignedLongLong(value.u);
+        }
+        else {
+            obj = PyFloat_FromDouble(value.d);
+        }
+    }
+    if (obj == NULL) {
+        return -1;
+    }
+
+    if (c->kind == TEXT_CONV_STR) {
+        str = PyObject_Str(obj);
+        Py_DECREF(obj);
+    }
+    else {
+        PyObject *tuple = PyTuple_New(1), *spec;
+
+        if (tuple == NULL) {
+            Py_DECREF(obj);
+            return -1;
+        }
+        PyTuple_SET_ITEM(tuple, 0, obj);
+        spec = PyUString_FromString(c->pyspec);
+        if (spec == NULL) {
+            Py_DECREF(tuple);
+            return -1;
+        }
+        str = PyUString_Format(spec, tuple);
+        Py_DECREF(spec);
+        Py_DECREF(tuple);
+    }
+    if (str == NULL) {
+        return -1;
+    }
+#if defined(NPY_PY3K)
+    {
+        PyObject *bytes = PyUnicode_AsASCIIString(str);
+
+        Py_DECREF(str);
+        if (bytes == NULL) {
+            return -1;
+        }
+        str = bytes;
+    }
+#endif
+    ret = text_buffer_append(b, PyBytes_AS_STRING(str),
+                             PyBytes_GET_SIZE(str));
+    Py_DECREF(str);
+    return ret;
+}
+
+/*
+ * Formats the element at 'data' with the conversion 'c', and appends
+ * it to the buffer. Returns 0 on success, -1 with an exception set.
+ */
+static int
+text_format_value(text_buffer *b, const text_conversion *c,
+                  PyArray_Descr *dtype, char *data)
+{
+    text_value value;
+    npy_intp room;
+    char *s;
+
+    if ((c->kind == TEXT_CONV_REPR || c->kind == TEXT_CONV_STR) &&
+            (dtype->type_num == NPY_LONGDOUBLE ||
+             (c->scalars && dtype->type_num != NPY_DOUBLE))) {
+        /* These scalars have their own, shorter, str() and repr() */
+        return text_format_object(b, c, dtype, data);
+    }
+    text_get_value(dtype, data, &value);
+
+    /* Room for any number formatted in C, which is below 1e50 */
+    room = NPY_MAX(c->width, c->precision + 64) + 16;
+    if (text_buffer_reserve(b, room) < 0) {
+        return -1;
+    }
+    s = b->data + b->len;
+
+    switch (c->kind) {
+        case TEXT_CONV_INT:
+            if (value.kind == TEXT_VALUE_FLOAT) {
+                /* Python truncates floats with %d */
+                if (c->conversion != 'd' || !npy_isfinite(value.d) ||
+                        value.d >= 9.2e18 || value.d <= -9.2e18) {
+                    break;
+                }
+                value.i = (npy_longlong)value.d;
+            }
+            else if (value.kind == TEXT_VALUE_UINT ||
+                        (value.i < 0 && c->conversion != 'd')) {
+                /* Python writes a sign for negative hex and octal */
+                break;
+            }
+            b->len += PyOS_snprintf(s, room, c->spec, value.i);
+            return 0;
+        case TEXT_CONV_FLOAT:
+            if (value.kind == TEXT_VALUE_INT) {
+                value.d = (double)value.i;
+            }
+            else if (value.kind == TEXT_VALUE_UINT) {
+                value.d = (double)value.u;
+            }
+            /* Python 2 switches %f to %g above 1e50 */
+            if (!npy_isfinite(value.d) ||
+                        value.d >= 1e50 || value.d <= -1e50) {
+                break;
+            }
+            if (NumPyOS_ascii_formatd(s, room, c->spec, value.d, 0) == NULL) {
+                break;
+            }
+            b->len += strlen(s);
+            return 0;
+        case TEXT_CONV_REPR:
+        case TEXT_CONV_STR:
+            if (value.kind == TEXT_VALUE_FLOAT) {
+                char *repr, shortest[32];
+                int ret, n = -1;
+#if !defined(NPY_PY3K)
+                if (c->kind == TEXT_CONV_STR) {
+                    /* str() of a float has 12 significant digits */
+                    repr = PyOS_double_to_string(value.d, 'g', 12,
+                                                 Py_DTSF_ADD_DOT_0, NULL);
+                }
+                else
+#endif
+                {
+                    /* The shortest string which reads back the same */
+                    n = NumPyOS_ascii_repr_double(shortest, value.d);
+                    if (n >= 0) {
+                        return text_buffer_append_padded(b, c, shortest, n);
+                    }
+                    repr = PyOS_double_to_string(value.d, 'r', 0,
+                                                 Py_DTSF_ADD_DOT_0, NULL);
+                }
+                if (repr == NULL) {
+                    PyErr_NoMemory();
+                    return -1;
+                }
+                ret = text_buffer_append_padded(b, c, repr, strlen(repr));
+                PyMem_Free(repr);
+                return ret;
+            }
+            else if (c->kind == TEXT_CONV_STR) {
+                if (dtype->type_num == NPY_BOOL) {
+                    return text_buffer_append(b, value.i ? "True" : "False",
+                                              value.i ? 4 : 5);
+                }
+                if (value.kind == TEXT_VALUE_INT) {
+                    b->len += PyOS_snprintf(s, room,
+                                            "%" NPY_LONGLONG_FMT, value.i);
+                }
+                else {
+                    b->len += PyOS_snprintf(s, room,
+                                            "%" NPY_ULONGLONG_FMT, value.u);
+                }
+                return 0;
+            }
+            break;
+    }
+
+    return text_format_object(b, c, dtype, data);
+}
+
+/*
+ * Formats the rows of 'arr', a 2-d array with a column per conversion
+ * of the format, or a 1-d structured array with a field per conversion,
+ * into 'b'. Returns 1 on success, 0 if the array or the format can't
+ * be handled here, and -1 with an exception set on failure.
+ */
+static int
+text_format_rows(text_buffer *b, PyArrayObject *arr, const char *fmt,
+                 const char *newline, npy_intp newline_len)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(arr);
+    PyArray_Descr **dtypes = NULL;
+    npy_intp *offsets = NULL;
+    npy_intp ncolumns, nrows, i, j;
+    text_format f;
+    int ret = 0;
+
+    if (PyDataType_HASFIELDS(dtype)) {
+        if (PyArray_NDIM(arr) != 1) {
+            return 0;
+        }
+        ncolumns = PyTuple_GET_SIZE(dtype->names);
+    }
+    else if (PyArray_NDIM(arr) == 2 && text_dtype_supported(dtype)) {
+        ncolumns = PyArray_DIM(arr, 1);
+    }
+    else {
+        return 0;
+    }
+    nrows = PyArray_DIM(arr, 0);
+
+    ret = text_parse_format(fmt, ncolumns, &f);
+    if (ret <= 0) {
+        return ret;
+    }
+    dtypes = PyArray_malloc(NPY_MAX(ncolumns, 1) * sizeof(PyArray_Descr *));
+    offsets = PyArray_malloc(NPY_MAX(ncolumns, 1) * sizeof(npy_intp));
+    if (dtypes == NULL || offsets == NULL) {
+        PyErr_NoMemory();
+        ret = -1;
+        goto finish;
+    }
+
+    /* Where each column is found in a row, and how it is stored */
+    for (j = 0; j < ncolumns; ++j) {
+        f.conversions[j].scalars = !PyDataType_HASFIELDS(dtype);
+        if (PyDataType_HASFIELDS(dtype)) {
+            PyObject *name = PyTuple_GET_ITEM(dtype->names, j);
+            PyObject *field = PyDict_GetItem(dtype->fields, name);
+
+            dtypes[j] = (PyArray_Descr *)PyTuple_GET_ITEM(field, 0);
+            offsets[j] = PyInt_AsLong(PyTuple_GET_ITEM(field, 1));
+        }
+        else {
+            dtypes[j] = dtype;
+            offsets[j] = j * PyArray_STRIDE(arr, 1);
+        }
+        if (!text_dtype_supported(dtypes[j]) ||
+                (f.conversions[j].kind == TEXT_CONV_REPR &&
+                 !PyTypeNum_ISFLOAT(dtypes[j]->type_num))) {
+            /* Python writes the repr of integers as it likes */
+            ret = 0;
+            goto finish;
+        }
+    }
+
+    for (i = 0; i < nrows; ++i) {
+        char *row = PyArray_BYTES(arr) + i * PyArray_STRIDE(arr, 0);
+
+        for (j = 0; j < ncolumns; ++j) {
+            text_conversion *c = &f.conversions[j];
+
+            if (text_buffer_append(b, c->prefix, c->prefix_len) < 0 ||
+                    text_format_value(b, c, dtypes[j], row + offsets[j]) < 0) {
+                ret = -1;
+                goto finish;
+            }
+        }
+        if (text_buffer_append(b, f.suffix, f.suffix_len) < 0 ||
+                text_buffer_append(b, newline, newline_len) < 0) {
+            ret = -1;
+            goto finish;
+        }
+    }
+    ret = 1;
+
+finish:
+    PyArray_free(dtypes);
+    PyArray_free(offsets);
+    text_format_dealloc(&f);
+    return ret;
+}
+
+NPY_NO_EXPORT PyObject *
+array__format_rows(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyArrayObject *arr;
+    char *fmt, *newline;
+    Py_ssize_t newline_len;
+    text_buffer b = {NULL, 0, 0};
+    PyObject *ret = NULL;
+    int res;
+
+    if (!PyArg_ParseTuple(args, "O!ss#:_format_rows", &PyArray_Type, &arr,
+                          &fmt, &newline, &newline_len)) {
+        return NULL;
+    }
+
+    res = text_format_rows(&b, arr, fmt, newline, newline_len);
+    if (res > 0) {
+        ret = PyBytes_FromStringAndSize(b.data, b.len);
+    }
+    else if (res == 0) {
+        Py_INCREF(Py_None);
+        ret = Py_None;
+    }
+    PyArray_free(b.data);
+    return ret;
+}
+
+/* Writes out the buffer, and empties it */
+static int
+text_buffer_flush(text_buffer *b, FILE *fp)
+{
+    size_t n;
+    NPY_BEGIN_THREADS_DEF;
+
+    NPY_BEGIN_THREADS;
+    n = fwrite(b->data, 1, b->len, fp);
+    NPY_END_THREADS;
+    if (n < (size_t)b->len) {
+        PyErr_SetString(PyExc_IOError, "problem writing to file");
+        return -1;
+    }
+    b->len = 0;
+    return 0;
+}
+
+NPY_NO_EXPORT int
+npy_tofile_text(PyArrayObject *self, FILE *fp, const char *sep,
+                                               const char *format)
+{
+    PyArray_Descr *dtype = PyArray_DESCR(self);
+    PyArrayIterObject *it;
+    text_format f;
+    text_conversion str_conversion, *c;
+    text_buffer b = {NULL, 0, 0};
+    npy_intp sep_len = strlen(sep);
+    int ret = 0;
+
+    if (!text_dtype_supported(dtype)) {
+        return 0;
+    }
+    memset(&f, 0, sizeof(f));
+    if (format == NULL || format[0] == '\0') {
+        memset(&str_conversion, 0, sizeof(str_conversion));
+        str_conversion.kind = TEXT_CONV_STR;
+        str_conversion.prefix = "";
+        c = &str_conversion;
+    }
+    else {
+        ret = text_parse_format(format, 1, &f);
+        if (ret <= 0) {
+            return ret;
+        }
+        c = &f.conversions[0];
+        if (c->kind == TEXT_CONV_REPR &&
+                            !PyTypeNum_ISFLOAT(dtype->type_num)) {
+            text_format_dealloc(&f);
+            return 0;
+        }
+    }
+
+    it = (PyArrayIterObject *)PyArray_IterNew((PyObject *)self);
+    if (it == NULL) {
+        ret = -1;
+        goto finish;
+    }
+    while (it->index < it->size) {
+        if (text_buffer_append(&b, c->prefix, c->prefix_len) < 0 ||
+                text_format_value(&b, c, dtype, it->dataptr) < 0 ||
+                text_buffer_append(&b, f.suffix, f.suffix_len) < 0) {
+            ret = -1;
+            goto finish;
+        }
+        /* Write a separator after all but the last element */
+        if (it->index != it->size - 1 &&
+                text_buffer_append(&b, sep, sep_len) < 0) {
+            ret = -1;
+            goto finish;
+        }
+        if (b.len >= TEXT_FLUSH_SIZE && text_buffer_flush(&b, fp) < 0) {
+            ret = -1;
+            goto finish;
+        }
+        PyArray_ITER_NEXT(it);
+    }
+    ret = (text_buffer_flush(&b, fp) < 0) ? -1 : 1;
+
+finish:
+    Py_XDECREF(it);
+    PyArray_free(b.data);
+    text_format_dealloc(&f);
+    return ret;
+}
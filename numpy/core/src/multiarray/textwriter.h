@@ -0,0 +1,23 @@
+#ifndef _NPY_PRIVATE__TEXTWRITER_H_
+#define _NPY_PRIVATE__TEXTWRITER_H_
+
+/*
+ * Python wrapper which formats the rows of a 2-d array, or a 1-d
+ * structured array, with a printf-style format holding a conversion per
+ * column, each row followed by 'newline'. Returns the text as bytes, or
+ * None if the array or the format has to be formatted by Python.
+ */
+NPY_NO_EXPORT PyObject *
+array__format_rows(PyObject *NPY_UNUSED(self), PyObject *args);
+
+/*
+ * Writes the elements of 'self' to 'fp' as text, separated by 'sep', and
+ * formatted with 'format', or as str() does if it is empty. Returns 1
+ * on success, 0 if the elements have to be formatted by Python, and -1
+ * with an exception set on failure.
+ */
+NPY_NO_EXPORT int
+npy_tofile_text(PyArrayObject *self, FILE *fp, const char *sep,
+                                               const char *format);
+
+#endif
@@ -1774,7 +1774,7 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     PyArray_Descr *dtypes[NPY_MAXARGS];
 
     /* Use remapped axes for generalized ufunc */
-    int broadcast_ndim, op_ndim;
+    int broadcast_ndim, iter_ndim;
     int op_axes_arrays[NPY_MAXARGS][NPY_MAXDIMS];
     int *op_axes[NPY_MAXARGS];
 
@@ -1795,9 +1795,11 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     /* The strides which get passed to the inner loop */
     npy_intp *inner_strides = NULL;
 
-    npy_intp *inner_strides_tmp, *ax_strides_tmp[NPY_MAXDIMS];
-    int core_dim_ixs_size, *core_dim_ixs;
+    /* The size of each core dimension, and the shape for the iterator */
+    npy_intp core_dim_sizes[NPY_MAXDIMS], iter_shape[NPY_MAXDIMS];
+    int core_dim_ixs_size, *core_dim_ixs, num_out_core_dims, j;
     int use_maskna = 0;
+    NPY_BEGIN_THREADS_DEF;
 
     /* The __array_prepare__ function to call for each output */
     PyObject *arr_prep[NPY_MAXARGS];
@@ -1857,18 +1859,68 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
             broadcast_ndim = n;
         }
     }
-    op_ndim = broadcast_ndim + ufunc->core_num_dim_ix;
-    if (op_ndim > NPY_MAXDIMS) {
+
+    /*
+     * Find the size of each core dimension. The iterator only sees the
+     * broadcast dimensions and the core dimensions of the outputs, each of
+     * the latter as an axis of its own, so that a dimension may appear
+     * more than once in the signature of an operand, as in "(m,m)".
+     * As before, a core dimension of size one in an input broadcasts.
+     */
+    for (idim = 0; idim < ufunc->core_num_dim_ix; ++idim) {
+        core_dim_sizes[idim] = -1;
+    }
+    num_out_core_dims = 0;
+    core_dim_ixs = ufunc->core_dim_ixs;
+    for (i = 0; i < nop; ++i) {
+        int num_dims = ufunc->core_num_dims[i];
+        int core_start_dim = op[i] ? PyArray_NDIM(op[i]) - num_dims : 0;
+
+        for (idim = 0; op[i] && idim < num_dims; ++idim) {
+            npy_intp *core_size = &core_dim_sizes[core_dim_ixs[idim]];
+            npy_intp size;
+
+            if (core_start_dim + idim < 0) {
+                continue;
+            }
+            size = PyArray_DIM(op[i], core_start_dim + idim);
+            if (*core_size == -1 || (*core_size == 1 && i < nin)) {
+                *core_size = size;
+            }
+            else if (size != *core_size && !(size == 1 && i < nin)) {
+                PyErr_Format(PyExc_ValueError,
+                        "%s: operand %d has a mismatch in its core "
+                        "dimension %d, with gufunc signature %s "
+                        "(size %" NPY_INTP_FMT " is different "
+                        "from %" NPY_INTP_FMT ")",
+                        ufunc_name, i, idim, ufunc->core_signature,
+                        size, *core_size);
+                retval = -1;
+                goto fail;
+            }
+        }
+        if (i >= nin) {
+            num_out_core_dims += num_dims;
+        }
+        core_dim_ixs += num_dims;
+    }
+
+    iter_ndim = broadcast_ndim + num_out_core_dims;
+    if (iter_ndim > NPY_MAXDIMS) {
         PyErr_Format(PyExc_ValueError,
                     "too many dimensions for generalized ufunc %s",
                     ufunc_name);
         retval = -1;
         goto fail;
     }
+    for (idim = 0; idim < broadcast_ndim; ++idim) {
+        iter_shape[idim] = -1;
+    }
 
     /* Fill in op_axes for all the operands */
     core_dim_ixs_size = 0;
     core_dim_ixs = ufunc->core_dim_ixs;
+    j = broadcast_ndim;
     for (i = 0; i < nop; ++i) {
         int n;
         if (op[i]) {
@@ -1890,18 +1942,22 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
                 op_axes_arrays[i][idim] = -1;
             }
         }
-        /* Use the signature information for the rest */
-        for (idim = broadcast_ndim; idim < op_ndim; ++idim) {
+        /* The core dimensions of the outputs are the remaining axes */
+        for (idim = broadcast_ndim; idim < iter_ndim; ++idim) {
             op_axes_arrays[i][idim] = -1;
         }
-        for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim) {
-            if (n + idim >= 0) {
-                op_axes_arrays[i][broadcast_ndim + core_dim_ixs[idim]] =
-                                                                    n + idim;
-            }
-            else {
-                op_axes_arrays[i][broadcast_ndim + core_dim_ixs[idim]] = -1;
+        for (idim = 0; i >= nin && idim < ufunc->core_num_dims[i]; ++idim) {
+            iter_shape[j] = core_dim_sizes[core_dim_ixs[idim]];
+            if (iter_shape[j] == -1) {
+                PyErr_Format(PyExc_ValueError,
+                        "%s: output operand %d has core dimension %d "
+                        "unspecified, with gufunc signature %s",
+                        ufunc_name, i, idim, ufunc->core_signature);
+                retval = -1;
+                goto fail;
             }
+            op_axes_arrays[i][j] = n + idim >= 0 ? n + idim : -1;
+            ++j;
         }
         core_dim_ixs_size += ufunc->core_num_dims[i];
         core_dim_ixs += ufunc->core_num_dims[i];
@@ -2011,12 +2067,21 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
                       NPY_ITER_NO_BROADCAST;
     }
 
+    /* The iterator needs an axis, which may as well have size one */
+    if (iter_ndim == 0) {
+        for (i = 0; i < nop; ++i) {
+            op_axes_arrays[i][0] = -1;
+        }
+        iter_shape[0] = 1;
+        iter_ndim = 1;
+    }
+
     /* Create the iterator */
     iter = NpyIter_AdvancedNew(nop, op, NPY_ITER_MULTI_INDEX|
                                       NPY_ITER_REFS_OK|
                                       NPY_ITER_REDUCE_OK,
                            order, NPY_UNSAFE_CASTING, op_flags,
-                           dtypes, op_ndim, op_axes, NULL, 0);
+                           dtypes, iter_ndim, op_axes, iter_shape, 0);
     if (iter == NULL) {
         retval = -1;
         goto fail;
@@ -2033,40 +2098,41 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
     /*
      * Set up the inner strides array. Because we're not doing
      * buffering, the strides are fixed throughout the looping.
+     * The strides after the first nop are those of the core dimensions
+     * of the arrays the iterator works on, which may be copies.
      */
     inner_strides = (npy_intp *)PyArray_malloc(
                         NPY_SIZEOF_INTP * (nop+core_dim_ixs_size));
-    /* The strides after the first nop match core_dim_ixs */
     core_dim_ixs = ufunc->core_dim_ixs;
-    inner_strides_tmp = inner_strides + nop;
-    for (idim = 0; idim < ufunc->core_num_dim_ix; ++idim) {
-        ax_strides_tmp[idim] = NpyIter_GetAxisStrideArray(iter,
-                                                broadcast_ndim+idim);
-        if (ax_strides_tmp[idim] == NULL) {
-            retval = -1;
-            goto fail;
-        }
-    }
+    j = nop;
     for (i = 0; i < nop; ++i) {
-        for (idim = 0; idim < ufunc->core_num_dims[i]; ++idim) {
-            inner_strides_tmp[idim] = ax_strides_tmp[core_dim_ixs[idim]][i];
+        PyArrayObject *op_it = NpyIter_GetOperandArray(iter)[i];
+        int num_dims = ufunc->core_num_dims[i];
+        int core_start_dim = PyArray_NDIM(op_it) - num_dims;
+
+        for (idim = 0; idim < num_dims; ++idim) {
+            /* Missing and broadcast core dimensions get a zero stride */
+            if (core_start_dim + idim >= 0 &&
+                    PyArray_DIM(op_it, core_start_dim + idim) ==
+                                    core_dim_sizes[core_dim_ixs[idim]]) {
+                inner_strides[j++] = PyArray_STRIDE(op_it,
+                                                    core_start_dim + idim);
+            }
+            else {
+                inner_strides[j++] = 0;
+            }
         }
-
-        core_dim_ixs += ufunc->core_num_dims[i];
-        inner_strides_tmp += ufunc->core_num_dims[i];
+        core_dim_ixs += num_dims;
     }
 
-    /* Set up the inner dimensions array */
-    if (NpyIter_GetShape(iter, inner_dimensions) != NPY_SUCCEED) {
-        retval = -1;
-        goto fail;
+    /* The core dimensions start at the second element */
+    for (idim = 0; idim < ufunc->core_num_dim_ix; ++idim) {
+        inner_dimensions[idim + 1] =
+                    core_dim_sizes[idim] == -1 ? 1 : core_dim_sizes[idim];
     }
-    /* Move the core dimensions to start at the second element */
-    memmove(&inner_dimensions[1], &inner_dimensions[broadcast_ndim],
-                        NPY_SIZEOF_INTP * ufunc->core_num_dim_ix);
 
-    /* Remove all the core dimensions from the iterator */
-    for (i = 0; i < ufunc->core_num_dim_ix; ++i) {
+    /* Remove the core dimensions of the outputs from the iterator */
+    for (i = 0; i < num_out_core_dims; ++i) {
         if (NpyIter_RemoveAxis(iter, broadcast_ndim) != NPY_SUCCEED) {
             retval = -1;
             goto fail;
@@ -2117,10 +2183,20 @@ PyUFunc_GeneralizedFunction(PyUFuncObject *ufunc,
         dataptr = NpyIter_GetDataPtrArray(iter);
         count_ptr = NpyIter_GetInnerLoopSizePtr(iter);
 
+        /* The loop runs over the whole stack, so let other threads run */
+        needs_api |= NpyIter_IterationNeedsAPI(iter);
+        if (!needs_api) {
+            NPY_BEGIN_THREADS;
+        }
+
         do {
             inner_dimensions[0] = *count_ptr;
             innerloop(dataptr, inner_dimensions, inner_strides, innerloopdata);
         } while (iternext(iter));
+
+        if (!needs_api) {
+            NPY_END_THREADS;
+        }
     }
 
     /* Check whether any errors occurred during the loop */
@@ -1,9 +1,12 @@
 from tempfile import NamedTemporaryFile, mktemp
 import os
+import sys
 import warnings
 
 from numpy import memmap
-from numpy import arange, allclose
+from numpy import arange, allclose, concatenate, add, minimum, maximum, \
+        zeros, ndarray, subtract, divide
+from numpy.core.memmap import BLOCK_BYTES
 from numpy.testing import *
 
 class TestMemmap(TestCase):
@@ -86,5 +89,126 @@ class TestMemmap(TestCase):
         fp_base[0] = 6
         assert_equal(fp_base[0], 6)
 
+    def test_advise_prefetch(self):
+        fp = memmap(self.tmpfp, dtype=self.dtype, mode='w+',
+                    shape=self.shape)
+        fp[:] = self.data
+        for advice in ['normal', 'random', 'sequential', 'willneed']:
+            fp.advise(advice)
+            fp.advise(advice, 1, 2)
+        assert_(fp.prefetch() is None)
+        fp.prefetch(1, background=True).join()
+        assert_array_equal(fp, self.data)
+        assert_raises(ValueError, fp.advise, 'never')
+        # Arithmetic results are not in the map
+        for advice in ['willneed', 'dontneed']:
+            assert_raises(ValueError, (fp * 2)[1:2].advise, advice)
+
+    def test_blocks(self):
+        fp = memmap(self.tmpfp, dtype='int64', mode='w+', shape=(1000, 3))
+        fp[:] = arange(3000).reshape(1000, 3)
+        fp.flush()
+        for background in [False, True]:
+            blocks = list(fp.blocks(64, background=background))
+            assert_equal([len(b) for b in blocks], [64]*15 + [40])
+            assert_array_equal(concatenate(blocks), fp)
+        # Every prefetch thread is joined, the first one included
+        import threading
+        before = threading.activeCount()
+        for b in fp.blocks(1000, background=True):
+            pass
+        assert_equal(threading.activeCount(), before)
+        assert_raises(ValueError, list, fp.blocks(64, evict=True))
+        fpr = memmap(self.tmpfp, dtype='int64', mode='r', shape=(1000, 3))
+        total = 0
+        for b in fpr.blocks(100, evict=True):
+            total += b.sum()
+        assert_equal(total, arange(3000).sum())
+        assert_equal(len(list(fpr.blocks())), 1)
+
+    def test_flush_range(self):
+        fp = memmap(self.tmpfp, dtype='uint8', mode='w+', shape=(5, 4096),
+                    offset=100)
+        fp[2:4] = 7
+        fp.flush(2, 4)
+        fp[1:2].flush(0, 1)
+        fp.flush(0, 0)
+        check = memmap(self.tmpfp, dtype='uint8', mode='r', shape=(5, 4096),
+                       offset=100)
+        assert_array_equal(check[2:4], 7)
+        assert_raises(ValueError, (fp + 1).flush, 0, 1)
+
+    def test_reduce(self):
+        data = arange(3000.).reshape(500, 6)
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(500, 6))
+        fp[:] = data
+        fpr = memmap(self.tmpfp, dtype='float64', mode='r', shape=(500, 6))
+        for m in [fp, fpr]:
+            assert_equal(m.reduce(add, rows=64), data.sum())
+            assert_array_equal(m.reduce(add, axis=0, rows=64),
+                               data.sum(axis=0))
+            assert_array_equal(m.reduce(maximum, axis=1, rows=64),
+                               data.max(axis=1))
+            assert_array_equal(m.reduce(minimum, axis=(0, -1), rows=7),
+                               data.min())
+            assert_equal(m.reduce(add, dtype='int32'), data.sum())
+        assert_(type(fpr.reduce(add, axis=0)) is ndarray)
+        assert_equal(fp[:0].reduce(add), 0)
+        assert_raises(ValueError, fp[:0].reduce, maximum)
+
+    def test_reduce_not_reorderable(self):
+        data = arange(1., 3001.).reshape(500, 6)
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(500, 6))
+        fp[:] = data
+        assert_array_equal(fp.reduce(subtract, axis=0, rows=64),
+                           subtract.reduce(data, axis=0))
+        assert_array_equal(fp.reduce(subtract, axis=1, rows=64),
+                           subtract.reduce(data, axis=1))
+        assert_array_equal(fp[:, 0].reduce(subtract, rows=64),
+                           subtract.reduce(data[:, 0]))
+        assert_array_equal(fp.reduce(divide, axis=-2, rows=7),
+                           divide.reduce(data, axis=0))
+        assert_raises(ValueError, fp.reduce, subtract, rows=64)
+
+    def test_reduce_reorderable(self):
+        # Reorderable ufuncs combine the results of the blocks, and never
+        # join the result so far to the next block
+        mm = sys.modules['numpy.core.memmap']
+        data = arange(3000.).reshape(500, 6)
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(500, 6))
+        fp[:] = data
+        joined = []
+        def counting_concatenate(*args, **kwargs):
+            joined.append(args)
+            return concatenate(*args, **kwargs)
+        mm.concatenate = counting_concatenate
+        try:
+            for ufunc in [maximum, minimum, add]:
+                assert_(mm._reorderable(ufunc))
+                assert_array_equal(fp.reduce(ufunc, axis=0, rows=64),
+                                   ufunc.reduce(data, axis=0))
+                assert_equal(fp[:, 0].reduce(ufunc, rows=64),
+                             ufunc.reduce(data[:, 0]))
+            assert_equal(joined, [])
+        finally:
+            mm.concatenate = concatenate
+        assert_(not mm._reorderable(subtract))
+        assert_(not mm._reorderable(divide))
+
+    def test_apply(self):
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(500, 6))
+        fp[:] = arange(3000.).reshape(500, 6)
+        assert_array_equal(fp.apply(lambda b: b.sum(axis=1), rows=64),
+                           fp.sum(axis=1))
+        out = zeros((500, 6))
+        assert_(fp.apply(lambda b: b * 2, out=out, rows=33) is out)
+        assert_array_equal(out, fp * 2)
+
+    def test_block_rows(self):
+        fp = memmap(self.tmpfp, dtype='float64', mode='w+', shape=(10**5, 3))
+        rows = fp._block_rows()
+        assert_equal(rows * 24 % 4096, 0)
+        assert_(rows * 24 <= BLOCK_BYTES)
+
 if __name__ == "__main__":
     run_module_suite()
@@ -334,6 +334,22 @@ class TestCreation(TestCase):
         arr = np.array([], dtype='V')
         assert_equal(arr.dtype.kind, 'V')
 
+    def test_zeros(self):
+        for n in (0, 1, 7, 100, 1000, 10**6):
+            # Leave dirty blocks of the same size behind
+            for dt in (np.int8, np.float64, 'c16'):
+                a = np.empty(n, dtype=dt)
+                a.view(np.int8)[...] = -1
+                del a
+            for dt in (np.int8, np.float64, 'c16', 'S3', 'i4,f8'):
+                a = np.zeros(n, dtype=dt)
+                assert_(not a.view(np.int8).any())
+        a = np.zeros((3, 4), dtype=object)
+        assert_equal(a.tolist(), [[0]*4]*3)
+        a = np.zeros((2, 1000), order='F')
+        assert_(a.flags.f_contiguous)
+        assert_equal(a.sum(), 0)
+
     def test_non_sequence_sequence(self):
         """Should not segfault.
 
@@ -1394,6 +1410,41 @@ class TestIO(object):
     def test_long_sep(self):
         self._check_from('1_x_3_x_4_x_5', [1,3,4,5], sep='_x_')
 
+    def test_large_text(self):
+        # Files are read in blocks, which must not split numbers or
+        # separators
+        x = np.random.random(50000) * 10.0 ** np.arange(-25, 25).repeat(1000)
+        s = ' ;\n'.join(map(repr, x))
+        self._check_from(s, x, sep=';')
+        self._check_from(s, x[:30000], sep=';', count=30000)
+        v = np.arange(100000, dtype=np.int64) * 997
+        self._check_from(' '.join(map(str, v)) + ' \n', v, sep=' ',
+                         dtype=np.int64)
+
+    def test_signed_unsigned(self):
+        # Signs are taken and negative values wrap around, as in the
+        # scanfunc of the unsigned types
+        for dt in (np.uint8, np.uint16, np.uint32, np.uint64):
+            self._check_from('+5,6', [5, 6], sep=',', dtype=dt)
+            self._check_from('-1,2', np.array([-1, 2]).astype(dt), sep=',',
+                             dtype=dt)
+            self._check_from(' +7 , 8 ', [7, 8], sep=',', dtype=dt)
+            self._check_from('3 -4 +5', np.array([3, -4, 5]).astype(dt),
+                             sep=' ', dtype=dt)
+
+    def test_text_file_position(self):
+        # The file is left after the last separator which was used
+        f = open(self.filename, 'wb')
+        f.write(asbytes(','.join(map(str, range(30000))) + ' end'))
+        f.close()
+        f = open(self.filename, 'rb')
+        y = np.fromfile(f, sep=',', dtype=int, count=20000)
+        assert_array_equal(y, np.arange(20000))
+        y = np.fromfile(f, sep=',', dtype=int)
+        assert_array_equal(y, np.arange(20000, 30000))
+        assert_equal(f.read(), asbytes('end'))
+        f.close()
+
     def test_dtype(self):
         v = np.array([1,2,3,4], dtype=np.int_)
         self._check_from('1,2,3,4', v, sep=',', dtype=np.int_)
@@ -1430,6 +1481,26 @@ class TestIO(object):
         f.close()
         assert_equal(s, '1.51,2.00,3.51,4.00')
 
+    def test_tofile_values(self):
+        # Elements are written as str() or the '%' operator does
+        values = [0.5, -0.0, 0.1, 1e20, 1e-5, 1e60, nan, inf, -inf]
+        for dt, items, fmt in [(float, values, ''),
+                               (np.float32, values, ''),
+                               (np.longdouble, values, ''),
+                               (float, values, '%r'),
+                               (float, values, '<%10.3e>'),
+                               (np.int16, [0, -5, 300], ''),
+                               (np.uint64, [0, 2**64 - 1], '%x'),
+                               (np.int8, [-3, 3], '%x'),
+                               (np.bool_, [True, False], '')]:
+            x = np.array(items, dtype=dt)
+            x.tofile(self.filename, sep=', ', format=fmt)
+            f = open(self.filename, 'r')
+            s = f.read()
+            f.close()
+            assert_equal(s, ', '.join([fmt and fmt % v or str(v)
+                                       for v in x.tolist()]))
+
     def test_locale(self):
         in_foreign_locale(self.test_numbers)()
         in_foreign_locale(self.test_nan)()
@@ -1439,6 +1510,7 @@ class TestIO(object):
         in_foreign_locale(self.test_malformed)()
         in_foreign_locale(self.test_tofile_sep)()
         in_foreign_locale(self.test_tofile_format)()
+        in_foreign_locale(self.test_tofile_values)()
 
 
 class TestFromBuffer(object):
@@ -1715,6 +1787,262 @@ class TestChoose(TestCase):
         A = np.choose(self.ind, (self.x, self.y2))
         assert_equal(A, [[2,2,3],[2,2,3]])
 
+class TestWhere(TestCase):
+    def test_basic(self):
+        dts = [np.bool, np.int16, np.int32, np.int64, np.double,
+               np.complex128, np.longdouble, np.clongdouble]
+        for dt in dts:
+            c = np.ones(53, dtype=np.bool)
+            assert_equal(np.where( c, dt(0), dt(1)), dt(0))
+            assert_equal(np.where(~c, dt(0), dt(1)), dt(1))
+            d = np.ones_like(c).astype(dt)
+            e = np.zeros_like(d)
+            r = d.astype(dt)
+            c[7] = False
+            r[7] = e[7]
+            assert_equal(np.where(c, e, e), e)
+            assert_equal(np.where(c, d, e), r)
+            assert_equal(np.where(c, d, e[0]), r)
+            assert_equal(np.where(c, d[0], e), r)
+            assert_equal(np.where(c[::2], d[::2], e[::2]), r[::2])
+            assert_equal(np.where(c[1::2], d[1::2], e[1::2]), r[1::2])
+            assert_equal(np.where(c[::-3], d[::-3], e[::-3]), r[::-3])
+
+    def test_exotic(self):
+        # zero sized and object arrays
+        m = np.array([], dtype=bool).reshape(0, 3)
+        b = np.array([], dtype=np.float64).reshape(0, 3)
+        assert_array_equal(np.where(m, 0, b), np.array([]).reshape(0, 3))
+
+        d = np.array([-1.34, -0.16, -0.54, -0.31, -0.08, -0.95, 0.000, 0.313,
+                      0.547, -0.18, 0.876, 0.236, 1.969, 0.310, 0.699, 1.013,
+                      1.267, 0.229, -1.39, 0.487])
+        nan = float('NaN')
+        e = np.array(['5z', '0l', nan, 'Wz', nan, nan, 'Xq', 'cs', nan, nan,
+                     'QN', nan, nan, 'Fd', nan, nan, 'kp', nan, '36', 'i1'],
+                     dtype=object)
+        m = np.array([0,0,1,0,1,1,0,0,1,1,0,1,1,0,1,1,0,1,0,0], dtype=bool)
+        r = e[:]
+        r[np.where(m)] = d[np.where(m)]
+        assert_array_equal(np.where(m, d, e), r)
+
+        r = e[:]
+        r[np.where(~m)] = d[np.where(~m)]
+        assert_array_equal(np.where(m, e, d), r)
+
+        assert_array_equal(np.where(m, e, e), e)
+
+    def test_ndim(self):
+        c = [True, False]
+        a = np.zeros((2, 25))
+        b = np.ones((2, 25))
+        r = np.where(np.array(c)[:,np.newaxis], a, b)
+        assert_array_equal(r[0], a[0])
+        assert_array_equal(r[1], b[0])
+
+        a = a.T
+        b = b.T
+        r = np.where(c, a, b)
+        assert_array_equal(r[:,0], a[:,0])
+        assert_array_equal(r[:,1], b[:,0])
+
+    def test_dtype_mix(self):
+        c = np.array([False, True, False, False, False, False, True, False,
+                     False, False, True, False])
+        a = np.uint32(1)
+        b = np.array([5., 0., 3., 2., -1., -4., 0., -10., 10., 1., 0., 3.],
+                      dtype=np.float64)
+        r = np.array([5., 1., 3., 2., -1., -4., 1., -10., 10., 1., 1., 3.],
+                     dtype=np.float64)
+        assert_equal(np.where(c, a, b), r)
+
+        a = a.astype(np.float32)
+        b = b.astype(np.int64)
+        assert_equal(np.where(c, a, b), r)
+
+        # non bool mask
+        c = c.astype(np.int)
+        c[c != 0] = 34242324
+        assert_equal(np.where(c, a, b), r)
+        # invert
+        tmpmask = c != 0
+        c[c == 0] = 41247212
+        c[tmpmask] = 0
+        assert_equal(np.where(c, b, a), r)
+
+    def test_result_type(self):
+        # scalars of the kind of the arrays do not upcast them
+        c = np.array([True, False])
+        a = np.array([1, 2], dtype=np.int8)
+        assert_equal(np.where(c, a, 5).dtype, np.int8)
+        assert_equal(np.where(c, a, 500).dtype, np.int8)
+        assert_equal(np.where(c, a, 2.5).dtype, np.float64)
+        assert_equal(np.where(c, a, a.astype(np.int16)).dtype, np.int16)
+
+    def test_subclass(self):
+        c = np.matrix([[True, False]])
+        r = np.where(c, np.matrix([[1, 2]]), 0)
+        assert_(isinstance(r, np.matrix))
+        assert_equal(r, [[1, 0]])
+
+        m = np.ma.array([True, False, True], mask=[False, False, True])
+        assert_equal(np.where(m, 1, 2), np.where(m != 0, 1, 2))
+
+    def test_object_condition(self):
+        # object conditions are compared with zero, as np.choose does
+        c = np.array([0, 1, '', None], dtype=object)
+        assert_equal(np.where(c, 1, 2), np.where(c != 0, 1, 2))
+
+    def test_foreign(self):
+        c = np.array([False, True, False, False, False, False, True, False,
+                     False, False, True, False])
+        r = np.array([5., 1., 3., 2., -1., -4., 1., -10., 10., 1., 1., 3.],
+                     dtype=np.float64)
+        a = np.ones(1, dtype='>i4')
+        b = np.array([5., 0., 3., 2., -1., -4., 0., -10., 10., 1., 0., 3.],
+                     dtype=np.float64)
+        assert_equal(np.where(c, a, b), r)
+
+        b = b.astype('>f8')
+        assert_equal(np.where(c, a, b), r)
+
+        a = a.astype('<i4')
+        assert_equal(np.where(c, a, b), r)
+
+        c = c.astype('>i4')
+        assert_equal(np.where(c, a, b), r)
+
+        # a byteswapped array with a scalar keeps its byte order as the
+        # common type, the result is still computed in native order
+        n = b.astype(np.float64)
+        assert_equal(np.where(c, b, 0), np.where(c, n, 0))
+        assert_equal(np.where(c, 0, b), np.where(c, 0, n))
+        assert_equal(np.where(c, 0, b).dtype, np.float64)
+
+    def test_complex_condition(self):
+        # a complex condition is true if either part is nonzero
+        assert_equal(np.where([1j, 0, 1+0j], 1, 2), [1, 2, 1])
+        c = np.array([0j, 1j, 2+0j, 0j])
+        assert_equal(np.where(c, np.arange(4.), -1.), [-1., 1., 2., -1.])
+
+    def test_error(self):
+        c = [True, True]
+        a = np.ones((4, 5))
+        b = np.ones((5, 5))
+        assert_raises(ValueError, np.where, c, a, a)
+        assert_raises(ValueError, np.where, c[0], a, b)
+        assert_raises(ValueError, np.where, c, a)
+
+    def test_maskna(self):
+        a = np.array([1, 2, 3], maskna=True)
+        assert_equal(np.where([True, False, True], a, 5), [1, 5, 3])
+        a[1] = np.NA
+        assert_raises(ValueError, np.where, [True, True, False], a, 5)
+
+class TestDataAllocator(TestCase):
+    def setUp(self):
+        self.old = np.core.multiarray.set_data_allocator('default')
+
+    def tearDown(self):
+        np.core.multiarray.set_data_allocator(self.old)
+
+    def test_switch(self):
+        mu = np.core.multiarray
+        assert_equal(mu.get_data_allocator(), 'default')
+        assert_equal(mu.set_data_allocator('aligned'), 'default')
+        assert_equal(mu.get_data_allocator(), 'aligned')
+        assert_raises(ValueError, mu.set_data_allocator, 'nonsense')
+        assert_equal(mu.get_data_allocator(), 'aligned')
+
+    def test_aligned(self):
+        np.core.multiarray.set_data_allocator('aligned')
+        for n in (1, 3, 1000, 100001):
+            a = np.arange(n, dtype=np.int8)
+            assert_equal(a.ctypes.data % 64, 0)
+            a.resize(3*n + 5, refcheck=False)
+            assert_equal(a.ctypes.data % 64, 0)
+            assert_equal(a[:n], np.arange(n, dtype=np.int8))
+
+    def test_hugepage(self):
+        np.core.multiarray.set_data_allocator('hugepage')
+        a = np.ones(2**20)
+        assert_equal(a.sum(), 2**20)
+        assert_equal(np.zeros(10).ctypes.data % 64, 0)
+
+    def test_mixed_free(self):
+        # Arrays must survive a change of allocator
+        a = np.arange(1000.)
+        np.core.multiarray.set_data_allocator('hugepage')
+        b = np.arange(10**6)
+        np.core.multiarray.set_data_allocator('default')
+        del a, b
+
+    def test_resize_after_switch(self):
+        # Blocks are resized and freed by the handler which allocated them
+        np.core.multiarray.set_data_allocator('aligned')
+        a = np.arange(1001, dtype=np.int8)
+        np.core.multiarray.set_data_allocator('default')
+        a.resize(10**6, refcheck=False)
+        assert_equal(a.ctypes.data % 64, 0)
+        assert_equal(a[:1001], np.arange(1001, dtype=np.int8))
+        np.core.multiarray.set_data_allocator('hugepage')
+        a.resize(5000, refcheck=False)
+        assert_equal(a[:1001], np.arange(1001, dtype=np.int8))
+        del a
+
+    def test_zeros(self):
+        for name in ('aligned', 'hugepage'):
+            np.core.multiarray.set_data_allocator(name)
+            for n in (10, 5000, 10**6):
+                a = np.zeros(n)
+                assert_equal(a.ctypes.data % 64, 0)
+                assert_(not a.any())
+
+class TestAllocCache(TestCase):
+    def setUp(self):
+        self.old = np.core.multiarray.set_alloc_cache_size(8)
+
+    def tearDown(self):
+        np.core.multiarray.set_alloc_cache_size(self.old)
+
+    def test_reuse(self):
+        mu = np.core.multiarray
+        a = np.ones((3, 4))
+        del a
+        mu.alloc_cache_stats(True)
+        for i in range(100):
+            a = np.ones((3, 4)) + 1
+            assert_equal(a, 2)
+            del a
+        stats = mu.alloc_cache_stats()
+        assert_(stats['data_hits'] >= 100)
+        assert_(stats['dim_hits'] >= 100)
+        assert_(stats['data_misses'] < 10)
+        assert_(stats['data_cached'] > 0)
+
+    def test_size(self):
+        mu = np.core.multiarray
+        assert_equal(mu.set_alloc_cache_size(0), 8)
+        a = np.zeros(10)
+        del a
+        stats = mu.alloc_cache_stats()
+        assert_equal(stats['size'], 0)
+        assert_equal(stats['data_cached'], 0)
+        assert_equal(stats['dim_cached'], 0)
+        assert_raises(ValueError, mu.set_alloc_cache_size, -1)
+        assert_raises(ValueError, mu.set_alloc_cache_size, 1000)
+
+    def test_resized_and_reshaped(self):
+        # Blocks whose size changed after allocation go back correctly
+        a = np.arange(10.)
+        a.resize(20, refcheck=False)
+        a.shape = (2, 2, 5)
+        del a
+        b = np.arange(20.).reshape(2, 2, 5).copy()
+        assert_equal(b.sum(), 190)
+        c = np.ones((2, 2, 5)) * np.arange(5)
+        assert_equal(c.sum(), 40)
+
 def can_use_decimal():
     try:
         from decimal import Decimal
@@ -1,6 +1,7 @@
 from numpy.testing import *
+import numpy as np
 from numpy.core import array, atleast_1d, atleast_2d, atleast_3d, vstack, \
-        hstack, newaxis
+        hstack, newaxis, concatenate, arange
 
 class TestAtleast1d(TestCase):
     def test_0D_array(self):
@@ -141,5 +142,76 @@ class TestVstack(TestCase):
         desired = array([[1,2],[1,2]])
         assert_array_equal(res,desired)
 
+class TestConcatenate(TestCase):
+    def test_axes(self):
+        a = arange(24).reshape(2, 3, 4)
+        for axis in range(3):
+            res = concatenate([a, a, a], axis=axis)
+            for p in np.split(res, 3, axis=axis):
+                assert_array_equal(p, a)
+            for b in (a, a.copy(order='F'), a[:, ::-1], a.transpose(1, 0, 2)):
+                res = concatenate([b, b], axis=axis)
+                assert_array_equal(np.split(res, 2, axis=axis)[0], b)
+                assert_array_equal(np.split(res, 2, axis=axis)[1], b)
+
+    def test_mixed_inputs(self):
+        # A mix of inputs which can and can't be copied as raw blocks
+        a = arange(10, dtype='<i4')
+        b = arange(10, 20, dtype='>i4')
+        c = arange(40, dtype='<i4')[::2]
+        d = arange(5, dtype=np.int8)
+        res = concatenate([a, b, c, d, a])
+        assert_equal(res.dtype, np.dtype('i4'))
+        assert_array_equal(res, np.r_[arange(20), arange(0, 40, 2),
+                                      arange(5), arange(10)])
+
+    def test_fortran(self):
+        a = arange(12.).reshape(3, 4).copy(order='F')
+        b = (arange(8.) + 100).reshape(2, 4).copy(order='F')
+        res = concatenate([a, b], axis=0)
+        assert_array_equal(res[:3], a)
+        assert_array_equal(res[3:], b)
+        res = concatenate([a.T, b.T], axis=1)
+        assert_(res.flags.c_contiguous)
+        assert_array_equal(res, np.c_[a.T, b.T])
+        c = (arange(8.) + 100).reshape(4, 2).copy(order='F')
+        res = concatenate([a.T.copy(order='F'), c], axis=1)
+        assert_(res.flags.f_contiguous)
+        assert_array_equal(res[:, :3], a.T)
+        assert_array_equal(res[:, 3:], c)
+
+    def test_large(self):
+        # Large enough to use non-temporal stores, with pieces whose
+        # starts in the result aren't aligned
+        a = arange(3000001, dtype=np.int8)
+        b = arange(1000003, dtype=np.int8)
+        res = concatenate([a, b, a, b])
+        n = a.size + b.size
+        assert_array_equal(res[:a.size], a)
+        assert_array_equal(res[a.size:n], b)
+        assert_array_equal(res[n:n + a.size], a)
+        assert_array_equal(res[n + a.size:], b)
+
+    def test_threads(self):
+        # The parts of the threads split the inputs at odd offsets
+        a = arange(3000001, dtype=np.int8)
+        b = arange(1000003, dtype=np.int16)
+        c = arange(10, dtype=np.int16)[::2]
+        for nthreads in (1, 2, 3, 7, 100):
+            res = concatenate([a, b, c, b], nthreads=nthreads)
+            assert_array_equal(res, np.r_[a, b, c, b])
+        x = arange(600000.).reshape(2, -1)
+        assert_array_equal(vstack([x, x], nthreads=4), np.r_[x, x])
+        assert_array_equal(hstack([x, x], nthreads=4), np.c_[x, x])
+        assert_array_equal(np.column_stack([x[0], x[1]], nthreads=4), x.T)
+        assert_array_equal(concatenate([a], nthreads=0), a)
+
+    def test_subclass_and_objects(self):
+        a = np.matrix([[1, 2]])
+        assert_(isinstance(concatenate([a, a]), np.matrix))
+        o = np.array([None, 'x', 1], dtype=object)
+        res = concatenate([o, o])
+        assert_equal(list(res), [None, 'x', 1] * 2)
+
 if __name__ == "__main__":
     run_module_suite()
@@ -102,7 +102,9 @@ format. It is an ASCII string which contains a Python literal expression
 of a dictionary. It is terminated by a newline (``\\n``) and padded with
 spaces (``\\x20``) to make the total length of
 ``magic string + 4 + HEADER_LEN`` be evenly divisible by 16 for alignment
-purposes.
+purposes. For arrays with at least `PAGE_ALIGN_THRESHOLD` bytes of data,
+NumPy pads the total length to a multiple of `PAGE_ALIGN` instead, so
+that the data of a memory-mapped file starts on a page boundary.
 
 The dictionary contains three keys:
 
@@ -128,6 +130,38 @@ Consumers can figure out the number of bytes by multiplying the number
 of elements given by the shape (noting that ``shape=()`` means there is
 1 element) by ``dtype.itemsize``.
 
+Format Version 2.0
+------------------
+
+Version 2.0 stores the array data compressed, in chunks of consecutive
+rows (along the first axis) which are compressed independently, so that
+a slice of rows can be read without decompressing the rest of the file,
+and different chunks can be decompressed in parallel. Arrays with Python
+objects can't be stored in this version.
+
+The magic string is followed by a 4-byte little-endian unsigned int: the
+length of the header data HEADER_LEN. The header is padded as in version
+1.0 and is a dictionary with the keys:
+
+    "descr" : dtype.descr
+      As in version 1.0.
+    "shape" : tuple of int
+      As in version 1.0. The data is always in C order.
+    "chunk_rows" : int
+      The number of rows in each chunk. The last chunk may have fewer.
+      The rows of an array of shape ``()`` are its single element.
+    "compression" : str
+      The codec of the chunks. Only ``'zlib'`` is defined.
+    "shuffle" : bool
+      Whether the bytes of each chunk were reordered before compression,
+      so that the first bytes of all elements come first, then all the
+      second bytes, and so on. This groups bytes which vary slowly and
+      usually makes numerical data compress much better.
+
+The header is followed by the chunk index: one little-endian 8-byte
+unsigned int per chunk, giving the number of compressed bytes of that
+chunk. The compressed chunks follow the index, in order.
+
 Notes
 -----
 The ``.npy`` format, including reasons for creating it and a comparison of
@@ -139,12 +173,24 @@ import cPickle
 
 import numpy
 import sys
+import zlib
 from numpy.lib.utils import safe_eval
 from numpy.compat import asbytes, isfileobj
 
 MAGIC_PREFIX = asbytes('\x93NUMPY')
 MAGIC_LEN = len(MAGIC_PREFIX) + 2
 
+# Bytes of array data in each chunk of a version 2.0 file
+CHUNK_BYTES = 2**20
+
+# The header of arrays with at least PAGE_ALIGN_THRESHOLD bytes of data is
+# padded to a multiple of PAGE_ALIGN bytes, instead of 16
+PAGE_ALIGN = 4096
+PAGE_ALIGN_THRESHOLD = 2**20
+
+# Bytes read at a time into the array from file-like objects
+READ_BLOCK = 2**24
+
 def magic(major, minor):
     """ Return the magic string for the given file format version.
 
@@ -255,16 +301,12 @@ def header_data_from_array_1_0(array):
     d['descr'] = dtype_to_descr(array.dtype)
     return d
 
-def write_array_header_1_0(fp, d):
-    """ Write the header for an array using the 1.0 format.
+def _header_alignment(nbytes):
+    if nbytes >= PAGE_ALIGN_THRESHOLD:
+        return PAGE_ALIGN
+    return 16
 
-    Parameters
-    ----------
-    fp : filelike object
-    d : dict
-        This has the appropriate entries for writing its string representation
-        to the header of the file.
-    """
+def _write_array_header(fp, d, version, alignment=16):
     import struct
     header = ["{"]
     for key, value in sorted(d.items()):
@@ -272,19 +314,48 @@ def write_array_header_1_0(fp, d):
         header.append("'%s': %s, " % (key, repr(value)))
     header.append("}")
     header = "".join(header)
+    if version == (1, 0):
+        fmt, limit = '<H', 256*256
+    else:
+        fmt, limit = '<I', 2**32
     # Pad the header with spaces and a final newline such that the magic
-    # string, the header-length short and the header are aligned on a 16-byte
-    # boundary.  Hopefully, some system, possibly memory-mapping, can take
-    # advantage of our premature optimization.
-    current_header_len = MAGIC_LEN + 2 + len(header) + 1  # 1 for the newline
-    topad = 16 - (current_header_len % 16)
+    # string, the header-length and the header are aligned on a 16-byte
+    # boundary, or a page boundary for large arrays, which lets the data
+    # of a memory map start on a page.
+    hlen = struct.calcsize(fmt)
+    current_header_len = MAGIC_LEN + hlen + len(header) + 1  # 1 for the newline
+    topad = alignment - (current_header_len % alignment)
     header = asbytes(header + ' '*topad + '\n')
-    if len(header) >= (256*256):
-        raise ValueError("header does not fit inside %s bytes" % (256*256))
-    header_len_str = struct.pack('<H', len(header))
+    if len(header) >= limit:
+        raise ValueError("header does not fit inside %s bytes" % limit)
+    header_len_str = struct.pack(fmt, len(header))
     fp.write(header_len_str)
     fp.write(header)
 
+def write_array_header_1_0(fp, d):
+    """ Write the header for an array using the 1.0 format.
+
+    Parameters
+    ----------
+    fp : filelike object
+    d : dict
+        This has the appropriate entries for writing its string representation
+        to the header of the file.
+    """
+    _write_array_header(fp, d, (1, 0))
+
+def write_array_header_2_0(fp, d):
+    """ Write the header for an array using the 2.0 format.
+
+    Parameters
+    ----------
+    fp : filelike object
+    d : dict
+        This has the appropriate entries for writing its string representation
+        to the header of the file.
+    """
+    _write_array_header(fp, d, (2, 0))
+
 def read_array_header_1_0(fp):
     """
     Read an array header from a filelike object using the 1.0 file format
@@ -314,14 +385,72 @@ def read_array_header_1_0(fp):
         If the data is invalid.
 
     """
-    # Read an unsigned, little-endian short int which has the length of the
-    # header.
+    d = _read_array_header(fp, (1, 0))
+    if not isinstance(d['fortran_order'], bool):
+        msg = "fortran_order is not a valid bool: %r"
+        raise ValueError(msg % (d['fortran_order'],))
+    return d['shape'], d['fortran_order'], d['descr']
+
+def read_array_header_2_0(fp):
+    """
+    Read an array header from a filelike object using the 2.0 file format
+    version.
+
+    This will leave the file object located just after the header, at the
+    start of the chunk index.
+
+    Parameters
+    ----------
+    fp : filelike object
+        A file object or something with a `.read()` method like a file.
+
+    Returns
+    -------
+    shape : tuple of int
+        The shape of the array.
+    dtype : dtype
+        The dtype of the file's data.
+    chunk_rows : int
+        The number of rows along the first axis in each chunk.
+    compression : str
+        The codec of the chunks.
+    shuffle : bool
+        Whether the bytes of the elements were shuffled before compression.
+
+    Raises
+    ------
+    ValueError :
+        If the data is invalid.
+
+    """
+    d = _read_array_header(fp, (2, 0))
+    if not isinstance(d['chunk_rows'], (int, long)) or d['chunk_rows'] < 1:
+        msg = "chunk_rows is not valid: %r"
+        raise ValueError(msg % (d['chunk_rows'],))
+    if d['compression'] != 'zlib':
+        msg = "compression is not supported: %r"
+        raise ValueError(msg % (d['compression'],))
+    if not isinstance(d['shuffle'], bool):
+        msg = "shuffle is not a valid bool: %r"
+        raise ValueError(msg % (d['shuffle'],))
+    return (d['shape'], d['descr'], d['chunk_rows'], d['compression'],
+            d['shuffle'])
+
+def _read_array_header(fp, version):
+    # Read an unsigned, little-endian int which has the length of the
+    # header; a short in version 1.0.
     import struct
-    hlength_str = fp.read(2)
-    if len(hlength_str) != 2:
+    if version == (1, 0):
+        fmt, expected_keys = '<H', ['descr', 'fortran_order', 'shape']
+    else:
+        fmt, expected_keys = '<I', ['chunk_rows', 'compression', 'descr',
+                                    'shape', 'shuffle']
+    hlen = struct.calcsize(fmt)
+    hlength_str = fp.read(hlen)
+    if len(hlength_str) != hlen:
         msg = "EOF at %s before reading array header length"
         raise ValueError(msg % fp.tell())
-    header_length = struct.unpack('<H', hlength_str)[0]
+    header_length = struct.unpack(fmt, hlength_str)[0]
     header = fp.read(header_length)
     if len(header) != header_length:
         raise ValueError("EOF at %s before reading array header" % fp.tell())
@@ -342,7 +471,7 @@ def read_array_header_1_0(fp):
         raise ValueError(msg % d)
     keys = d.keys()
     keys.sort()
-    if keys != ['descr', 'fortran_order', 'shape']:
+    if keys != expected_keys:
         msg = "Header does not contain the correct keys: %r"
         raise ValueError(msg % (keys,))
 
@@ -351,18 +480,14 @@ def read_array_header_1_0(fp):
         not numpy.all([isinstance(x, (int,long)) for x in d['shape']])):
         msg = "shape is not valid: %r"
         raise ValueError(msg % (d['shape'],))
-    if not isinstance(d['fortran_order'], bool):
-        msg = "fortran_order is not a valid bool: %r"
-        raise ValueError(msg % (d['fortran_order'],))
     try:
-        dtype = numpy.dtype(d['descr'])
+        d['descr'] = numpy.dtype(d['descr'])
     except TypeError, e:
         msg = "descr is not a valid dtype descriptor: %r"
         raise ValueError(msg % (d['descr'],))
+    return d
 
-    return d['shape'], d['fortran_order'], dtype
-
-def write_array(fp, array, version=(1,0)):
+def write_array(fp, array, version=(1,0), chunksize=None):
     """
     Write an array to an NPY file, including a header.
 
@@ -378,7 +503,11 @@ def write_array(fp, array, version=(1,0)):
     array : ndarray
         The array to write to disk.
     version : (int, int), optional
-        The version number of the format.  Default: (1, 0)
+        The version number of the format.  Default: (1, 0). Version (2, 0)
+        compresses the data in chunks.
+    chunksize : int, optional
+        For version (2, 0), the number of bytes of array data in each
+        chunk, rounded to whole rows. Default: `CHUNK_BYTES`.
 
     Raises
     ------
@@ -390,11 +519,19 @@ def write_array(fp, array, version=(1,0)):
         are not picklable.
 
     """
+    if version == (2, 0):
+        _write_chunked_array(fp, array, chunksize)
+        return
     if version != (1, 0):
-        msg = "we only support format version (1,0), not %s"
+        msg = "we only support format versions (1,0) and (2,0), not %s"
         raise ValueError(msg % (version,))
     fp.write(magic(*version))
-    write_array_header_1_0(fp, header_data_from_array_1_0(array))
+    if array.dtype.hasobject:
+        alignment = 16
+    else:
+        alignment = _header_alignment(array.nbytes)
+    _write_array_header(fp, header_data_from_array_1_0(array), version,
+                        alignment)
     if array.dtype.hasobject:
         # We contain Python objects so we cannot write out the data directly.
         # Instead, we will pickle it out with version 2 of the pickle protocol.
@@ -412,6 +549,47 @@ def write_array(fp, array, version=(1,0)):
             # arrayterator.
             fp.write(array.tostring('C'))
 
+def _array_blocks(array, blocksize=READ_BLOCK):
+    """
+    Return the magic string and header which `write_array` writes for
+    `array` in version (1, 0), and an iterator over its data as buffer
+    objects of about `blocksize` bytes, which refer to the array's memory
+    when it is contiguous.
+    """
+    if array.dtype.hasobject:
+        raise ValueError("Arrays with Python objects can't be written "
+                         "in blocks")
+    if sys.version_info[0] >= 3:
+        from io import BytesIO
+    else:
+        from cStringIO import StringIO as BytesIO
+    header = BytesIO()
+    header.write(magic(1, 0))
+    _write_array_header(header, header_data_from_array_1_0(array), (1, 0),
+                        _header_alignment(array.nbytes))
+    if array.flags.f_contiguous and not array.flags.c_contiguous:
+        array = array.T
+    return header.getvalue(), _iter_blocks(array, blocksize)
+
+def _iter_blocks(array, blocksize):
+    if sys.version_info[0] >= 3:
+        view = memoryview
+    else:
+        view = buffer
+    if array.size == 0:
+        return
+    if array.flags.c_contiguous:
+        buf = array.reshape(-1).view(numpy.uint8)
+        for pos in range(0, len(buf), blocksize):
+            yield view(buf[pos:pos + blocksize])
+        return
+    # Copy whole rows at a time
+    rowbytes = array[0].nbytes
+    rows = max(1, blocksize // max(1, rowbytes))
+    for i in range(0, len(array), rows):
+        block = numpy.ascontiguousarray(array[i:i + rows])
+        yield view(block.reshape(-1).view(numpy.uint8))
+
 def read_array(fp):
     """
     Read an array from an NPY file.
@@ -434,8 +612,10 @@ def read_array(fp):
 
     """
     version = read_magic(fp)
+    if version == (2, 0):
+        return _read_chunked_array(fp)
     if version != (1, 0):
-        msg = "only support version (1,0) of file format, not %r"
+        msg = "only support versions (1,0) and (2,0) of file format, not %r"
         raise ValueError(msg % (version,))
     shape, fortran_order, dtype = read_array_header_1_0(fp)
     if len(shape) == 0:
@@ -452,11 +632,10 @@ def read_array(fp):
             # We can use the fast fromfile() function.
             array = numpy.fromfile(fp, dtype=dtype, count=count)
         else:
-            # This is not a real file. We have to read it the memory-intensive
-            # way.
-            # XXX: we can probably chunk this to avoid the memory hit.
-            data = fp.read(int(count * dtype.itemsize))
-            array = numpy.fromstring(data, dtype=dtype, count=count)
+            # This is not a real file, so read it straight into the array
+            # a block at a time.
+            array = numpy.empty(count, dtype=dtype)
+            _read_into(fp, array)
 
         if fortran_order:
             array.shape = shape[::-1]
@@ -466,9 +645,324 @@ def read_array(fp):
 
     return array
 
+def _read_into(fp, array):
+    """
+    Fill the contiguous `array` with bytes from the file-like `fp`, using
+    its ``readinto`` method if it has one, and otherwise reading blocks of
+    at most `READ_BLOCK` bytes and copying them.
+    """
+    buf = array.reshape(-1).view(numpy.uint8)
+    readinto = getattr(fp, 'readinto', None)
+    pos = 0
+    while pos < len(buf):
+        n = min(len(buf) - pos, READ_BLOCK)
+        got = None
+        if readinto is not None:
+            try:
+                got = readinto(buf[pos:pos + n])
+            except TypeError:
+                # The buffer interface of arrays isn't accepted
+                readinto = None
+        if readinto is None:
+            data = fp.read(n)
+            got = len(data)
+            buf[pos:pos + got] = numpy.frombuffer(data, dtype=numpy.uint8)
+        if not got:
+            msg = "EOF: reading array data, expected %d bytes got %d"
+            raise ValueError(msg % (len(buf), pos))
+        pos += got
+
+def _chunk_layout(shape, dtype, chunk_rows=None, chunksize=None):
+    """
+    Return the number of rows, the number of elements in a chunk and the
+    number of chunks of an array stored in version 2.0. If `chunk_rows`
+    is None it is chosen from `chunksize`, and returned as well.
+    """
+    if len(shape) == 0:
+        nrows, rowsize = 1, 1
+    else:
+        nrows = shape[0]
+        rowsize = int(numpy.multiply.reduce(shape[1:]))
+    if chunk_rows is None:
+        if chunksize is None:
+            chunksize = CHUNK_BYTES
+        chunk_rows = max(1, chunksize // max(1, rowsize * dtype.itemsize))
+    nchunks = (nrows + chunk_rows - 1) // chunk_rows
+    return nrows, chunk_rows, chunk_rows * rowsize, nchunks
+
+def _compress_chunk(chunk, shuffle):
+    if shuffle:
+        # Transposing the bytes of the elements groups their first bytes,
+        # their second bytes, and so on.
+        data = chunk.view(numpy.uint8).reshape(-1, chunk.itemsize).T.tostring()
+    else:
+        data = chunk.tostring()
+    return zlib.compress(data, 1)
+
+def _decompress_chunk(data, out, shuffle):
+    raw = numpy.frombuffer(zlib.decompress(data), dtype=numpy.uint8)
+    if len(raw) != out.nbytes:
+        raise ValueError("chunk has %d bytes instead of %d"
+                         % (len(raw), out.nbytes))
+    if shuffle:
+        out.view(numpy.uint8).reshape(-1, out.itemsize)[...] = \
+                raw.reshape(out.itemsize, -1).T
+    else:
+        out.view(numpy.uint8)[...] = raw
+
+def _read_chunks(fp, sizes, out, chunk_items, shuffle, nthreads=1):
+    """
+    Read the chunks with the compressed `sizes` from `fp` and decompress
+    them into consecutive parts of `chunk_items` elements of the flat
+    array `out`.
+
+    With several threads, batches of chunks are read and then
+    decompressed concurrently; zlib releases the GIL while it works.
+    """
+    batch = max(1, nthreads) * 4
+    for first in range(0, len(sizes), batch):
+        jobs = []
+        for k in range(first, min(first + batch, len(sizes))):
+            data = fp.read(int(sizes[k]))
+            if len(data) != sizes[k]:
+                raise ValueError("EOF at %s before reading chunk %d"
+                                 % (fp.tell(), k))
+            jobs.append((data, out[k*chunk_items:(k+1)*chunk_items]))
+        if nthreads <= 1 or len(jobs) == 1:
+            for data, part in jobs:
+                _decompress_chunk(data, part, shuffle)
+        else:
+            _decompress_parallel(jobs, shuffle, nthreads)
+
+def _decompress_parallel(jobs, shuffle, nthreads):
+    import threading
+    errors = []
+    def work(jobs):
+        try:
+            for data, part in jobs:
+                _decompress_chunk(data, part, shuffle)
+        except Exception, e:
+            errors.append(e)
+    threads = [threading.Thread(target=work, args=(jobs[i::nthreads],))
+               for i in range(min(nthreads, len(jobs)))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    if errors:
+        raise errors[0]
+
+def _write_chunked_array(fp, array, chunksize=None):
+    if array.dtype.hasobject:
+        raise ValueError("Arrays with Python objects can't be stored in "
+                         "format version (2,0)")
+    array = numpy.array(array, copy=False, order='C')
+    nrows, chunk_rows, chunk_items, nchunks = _chunk_layout(
+                                array.shape, array.dtype, chunksize=chunksize)
+    flat = array.reshape(-1)
+    # Shuffling helps integers and smooth data a lot, but can hurt noisy
+    # floats, so keep whichever compresses the first chunk better.
+    first = None
+    shuffle = False
+    if array.dtype.itemsize > 1 and nchunks > 0:
+        first = _compress_chunk(flat[:chunk_items], False)
+        shuffled = _compress_chunk(flat[:chunk_items], True)
+        if len(shuffled) < len(first):
+            first, shuffle = shuffled, True
+    d = {'descr': dtype_to_descr(array.dtype),
+         'shape': array.shape,
+         'chunk_rows': chunk_rows,
+         'compression': 'zlib',
+         'shuffle': shuffle}
+    fp.write(magic(2, 0))
+    write_array_header_2_0(fp, d)
+
+    sizes = numpy.zeros(nchunks, dtype='<u8')
+    def compress(k):
+        if k == 0 and first is not None:
+            return first
+        return _compress_chunk(flat[k*chunk_items:(k+1)*chunk_items], shuffle)
+    try:
+        index_pos = fp.tell()
+        fp.seek(index_pos)
+    except (AttributeError, IOError):
+        # Not seekable, so the index has to be known before the chunks
+        chunks = []
+        for k in range(nchunks):
+            data = compress(k)
+            sizes[k] = len(data)
+            chunks.append(data)
+        fp.write(sizes.tostring())
+        for data in chunks:
+            fp.write(data)
+        return
+    # Leave room for the index, and fill it in once the chunks are written
+    fp.write(sizes.tostring())
+    for k in range(nchunks):
+        data = compress(k)
+        sizes[k] = len(data)
+        fp.write(data)
+    end = fp.tell()
+    fp.seek(index_pos)
+    fp.write(sizes.tostring())
+    fp.seek(end)
+
+def _read_chunk_index(fp, nchunks):
+    data = fp.read(8 * nchunks)
+    if len(data) != 8 * nchunks:
+        raise ValueError("EOF at %s before reading chunk index" % fp.tell())
+    return numpy.fromstring(data, dtype='<u8').astype(numpy.int64)
+
+def _read_chunked_array(fp, nthreads=1):
+    shape, dtype, chunk_rows, compression, shuffle = read_array_header_2_0(fp)
+    nrows, chunk_rows, chunk_items, nchunks = _chunk_layout(shape, dtype,
+                                                            chunk_rows)
+    sizes = _read_chunk_index(fp, nchunks)
+    array = numpy.empty(shape, dtype=dtype)
+    _read_chunks(fp, sizes, array.reshape(-1), chunk_items, shuffle, nthreads)
+    return array
+
+
+class ChunkedArray(object):
+    """
+    Read access to an array stored in a version 2.0 ``.npy`` file, which
+    only decompresses the chunks holding the rows that are indexed.
+
+    Indexing with an integer or a slice along the first axis, possibly
+    followed by further indices, reads just the chunks holding those rows.
+    Any other index reads the whole array first.
+
+    Parameters
+    ----------
+    file : str or file
+        The file name, or an open file object supporting ``seek()``,
+        which is left open by `close`.
+    nthreads : int, optional
+        The number of threads which decompress chunks concurrently.
+
+    Attributes
+    ----------
+    shape, dtype, ndim, size : as for ndarray
+    chunk_rows : int
+        The number of rows along the first axis in each chunk.
+
+    """
+    def __init__(self, file, nthreads=1):
+        if isinstance(file, basestring):
+            self._fp = open(file, 'rb')
+            self._own_fp = True
+        else:
+            self._fp = file
+            self._own_fp = False
+        self.nthreads = nthreads
+        try:
+            version = read_magic(self._fp)
+            if version != (2, 0):
+                msg = "only version (2,0) files are chunked, not %r"
+                raise ValueError(msg % (version,))
+            (self.shape, self.dtype, chunk_rows, compression,
+             self._shuffle) = read_array_header_2_0(self._fp)
+            (self._nrows, self.chunk_rows, self._chunk_items,
+             nchunks) = _chunk_layout(self.shape, self.dtype, chunk_rows)
+            self._sizes = _read_chunk_index(self._fp, nchunks)
+            self._offsets = numpy.empty(nchunks + 1, dtype=numpy.int64)
+            self._offsets[0] = self._fp.tell()
+            numpy.cumsum(self._sizes, out=self._offsets[1:])
+            self._offsets[1:] += self._offsets[0]
+        except:
+            self.close()
+            raise
+        self.ndim = len(self.shape)
+        self.size = int(numpy.multiply.reduce(self.shape))
+
+    def close(self):
+        """Close the file if it was opened by name."""
+        if self._own_fp and self._fp is not None:
+            self._fp.close()
+        self._fp = None
+
+    def __len__(self):
+        if self.ndim == 0:
+            raise TypeError("len() of unsized object")
+        return self.shape[0]
+
+    def __array__(self, dtype=None):
+        array = self._read_rows(0, self._nrows).reshape(self.shape)
+        if dtype is not None:
+            array = array.astype(dtype)
+        return array
+
+    def _read_rows(self, lo, hi):
+        """Read the rows lo to hi along the first axis."""
+        rowshape = self.shape[1:]
+        if hi <= lo:
+            return numpy.empty((0,) + rowshape, dtype=self.dtype)
+        c0 = lo // self.chunk_rows
+        c1 = (hi + self.chunk_rows - 1) // self.chunk_rows
+        first = c0 * self.chunk_rows
+        block = numpy.empty((min(c1 * self.chunk_rows, self._nrows) - first,)
+                            + rowshape, dtype=self.dtype)
+        self._fp.seek(self._offsets[c0])
+        _read_chunks(self._fp, self._sizes[c0:c1], block.reshape(-1),
+                     self._chunk_items, self._shuffle, self.nthreads)
+        return block[lo - first:hi - first]
+
+    def __getitem__(self, index):
+        if not isinstance(index, tuple):
+            index = (index,)
+        if (self.ndim == 0 or len(index) == 0 or isinstance(index[0], bool)
+                or not isinstance(index[0], (int, long, numpy.integer,
+                                             slice))):
+            return numpy.asarray(self)[index]
+        first, rest = index[0], index[1:]
+        n = self._nrows
+        if isinstance(first, slice):
+            start, stop, step = first.indices(n)
+            if step > 0:
+                block = self._read_rows(start, stop)[::step]
+            elif start > stop:
+                block = self._read_rows(stop + 1, start + 1)[::step]
+            else:
+                block = self._read_rows(0, 0)
+            rest = (slice(None),) + rest
+        else:
+            first = int(first)
+            if first < 0:
+                first += n
+            if not 0 <= first < n:
+                raise IndexError("index out of bounds")
+            block = self._read_rows(first, first + 1)
+            rest = (0,) + rest
+        return block[rest]
+
+def open_chunked(file, nthreads=1):
+    """
+    Open a version 2.0 ``.npy`` file for reading parts of the array.
+
+    Parameters
+    ----------
+    file : str or file
+        The file name, or an open file object supporting ``seek()``.
+    nthreads : int, optional
+        The number of threads which decompress chunks concurrently.
+
+    Returns
+    -------
+    carray : ChunkedArray
+        Indexing it returns arrays, decompressing only the chunks which
+        hold the requested rows.
+
+    Raises
+    ------
+    ValueError
+        If the file is not a valid version 2.0 file.
+
+    """
+    return ChunkedArray(file, nthreads)
+
 
 def open_memmap(filename, mode='r+', dtype=None, shape=None,
-                fortran_order=False, version=(1,0)):
+                fortran_order=False, version=(1,0), advice=None):
     """
     Open a .npy file as a memory-mapped array.
 
@@ -498,6 +992,12 @@ def open_memmap(filename, mode='r+', dtype=None, shape=None,
     version : tuple of int (major, minor)
         If the mode is a "write" mode, then this is the version of the file
         format used to create the file.  Default: (1,0)
+    advice : str, optional
+        How the data will be accessed, passed on to the kernel with
+        ``madvise`` where it is available: 'sequential' makes it read ahead
+        aggressively and drop pages once read, 'willneed' starts reading
+        the whole array in the background, 'random' turns read-ahead off,
+        and 'normal' restores the default.
 
     Returns
     -------
@@ -538,10 +1038,11 @@ def open_memmap(filename, mode='r+', dtype=None, shape=None,
             shape=shape,
         )
         # If we got here, then it should be safe to create the file.
+        nbytes = dtype.itemsize * int(numpy.prod(shape))
         fp = open(filename, mode+'b')
         try:
             fp.write(magic(*version))
-            write_array_header_1_0(fp, d)
+            _write_array_header(fp, d, version, _header_alignment(nbytes))
             offset = fp.tell()
         finally:
             fp.close()
@@ -550,6 +1051,10 @@ def open_memmap(filename, mode='r+', dtype=None, shape=None,
         fp = open(filename, 'rb')
         try:
             version = read_magic(fp)
+            if version == (2, 0):
+                msg = ("Array can't be memory-mapped: the data is compressed."
+                       " Use open_chunked instead.")
+                raise ValueError(msg)
             if version != (1, 0):
                 msg = "only support version (1,0) of file format, not %r"
                 raise ValueError(msg % (version,))
@@ -573,5 +1078,7 @@ def open_memmap(filename, mode='r+', dtype=None, shape=None,
 
     marray = numpy.memmap(filename, dtype=dtype, shape=shape, order=order,
         mode=mode, offset=offset)
+    if advice is not None:
+        numpy.core.multiarray._madvise(marray, advice)
 
     return marray
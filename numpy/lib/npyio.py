@@ -1,4 +1,4 @@
-__all__ = ['savetxt', 'loadtxt', 'genfromtxt', 'ndfromtxt', 'mafromtxt',
+__all__ = ['savetxt', 'loadtxt', 'loadtxt_chunks', 'genfromtxt', 'ndfromtxt', 'mafromtxt',
            'recfromtxt', 'recfromcsv', 'load', 'loads', 'save', 'savez',
            'savez_compressed', 'packbits', 'unpackbits', 'fromregex', 'DataSource']
 
@@ -217,14 +217,6 @@ class NpzFile(object):
         self.close()
 
     def __getitem__(self, key):
-        # FIXME: This seems like it will copy strings around
-        #   more than is strictly necessary.  The zipfile
-        #   will read the string and then
-        #   the format.read_array will copy the string
-        #   to another place in memory.
-        #   It would be better if the zipfile could read
-        #   (or at least uncompress) the data
-        #   directly into the array memory.
         member = 0
         if key in self._files:
             member = 1
@@ -232,6 +224,21 @@ class NpzFile(object):
             member = 1
             key += '.npy'
         if member:
+            if hasattr(self.zip, 'open'):
+                # Check the magic string, and then decompress the member
+                # again from the start straight into the array.
+                fid = self.zip.open(key)
+                try:
+                    magic = fid.read(len(format.MAGIC_PREFIX))
+                    if magic != format.MAGIC_PREFIX:
+                        return magic + fid.read()
+                finally:
+                    fid.close()
+                fid = self.zip.open(key)
+                try:
+                    return format.read_array(fid)
+                finally:
+                    fid.close()
             bytes = self.zip.read(key)
             if bytes.startswith(format.MAGIC_PREFIX):
                 value = BytesIO(bytes)
@@ -269,7 +276,7 @@ class NpzFile(object):
         return self.files.__contains__(key)
 
 
-def load(file, mmap_mode=None):
+def load(file, mmap_mode=None, advice=None):
     """
     Load a pickled, ``.npy``, or ``.npz`` binary file.
 
@@ -281,12 +288,17 @@ def load(file, mmap_mode=None):
     mmap_mode: {None, 'r+', 'r', 'w+', 'c'}, optional
         If not None, then memory-map the file, using the given mode
         (see `numpy.memmap`).  The mode has no effect for pickled or
-        zipped files.
+        zipped files. A ``.npy`` file saved with ``compress=True`` can
+        only be opened with mode 'r', which returns a `format.ChunkedArray`
+        that decompresses just the parts of the array which are indexed.
         A memory-mapped array is stored on disk, and not directly loaded
         into memory.  However, it can be accessed and sliced like any
         ndarray.  Memory mapping is especially useful for accessing
         small fragments of large files without reading the entire file
         into memory.
+    advice : {None, 'sequential', 'willneed', 'random', 'normal'}, optional
+        With `mmap_mode`, tells the operating system how the array will be
+        accessed, see `format.open_memmap`.
 
     Returns
     -------
@@ -371,7 +383,12 @@ def load(file, mmap_mode=None):
             return NpzFile(fid, own_fid=True)
         elif magic == format.MAGIC_PREFIX: # .npy file
             if mmap_mode:
-                return format.open_memmap(file, mode=mmap_mode)
+                version = format.read_magic(fid)
+                fid.seek(-format.MAGIC_LEN, 1)
+                if version == (2, 0) and mmap_mode == 'r':
+                    return format.open_chunked(file)
+                return format.open_memmap(file, mode=mmap_mode,
+                                          advice=advice)
             else:
                 return format.read_array(fid)
         else:  # Try a pickle
@@ -384,7 +401,7 @@ def load(file, mmap_mode=None):
         if own_fid:
             fid.close()
 
-def save(file, arr):
+def save(file, arr, compress=False):
     """
     Save an array to a binary file in NumPy ``.npy`` format.
 
@@ -397,6 +414,10 @@ def save(file, arr):
         have one.
     arr : array_like
         Array data to be saved.
+    compress : bool, optional
+        If True, the data is compressed in chunks of rows which can be
+        read independently, using version 2.0 of the format. Arrays with
+        Python objects can't be compressed.
 
     See Also
     --------
@@ -431,7 +452,10 @@ def save(file, arr):
 
     try:
         arr = np.asanyarray(arr)
-        format.write_array(fid, arr)
+        if compress:
+            format.write_array(fid, arr, version=(2, 0))
+        else:
+            format.write_array(fid, arr)
     finally:
         if own_fid:
             fid.close()
@@ -565,6 +589,12 @@ def _savez(file, args, kwds, compress):
 
     zip = zipfile_factory(file, mode="w", compression=compression)
 
+    if _can_stream_members(zip):
+        for key, val in namedict.iteritems():
+            _write_member(zip, key + '.npy', np.asanyarray(val), compress)
+        zip.close()
+        return
+
     # Stage arrays in a temporary file on disk, before writing to zip.
     fd, tmpfile = tempfile.mkstemp(suffix='-numpy.npy')
     os.close(fd)
@@ -585,6 +615,148 @@ def _savez(file, args, kwds, compress):
 
     zip.close()
 
+# Size of the pieces of a member which are compressed concurrently.
+_DEFLATE_PIECE = 2**22
+
+def _can_stream_members(zip):
+    """
+    Whether `_write_member` can add members to `zip`, which needs the
+    internals that ``ZipFile.write`` uses in Python 2.7 and 3.x.
+    """
+    return (sys.version_info >= (2, 7) and
+            hasattr(zip, '_writecheck') and hasattr(zip, 'NameToInfo') and
+            hasattr(zip.fp, 'seek'))
+
+def _deflate_threads():
+    try:
+        import multiprocessing
+        return min(multiprocessing.cpu_count(), 8)
+    except (ImportError, NotImplementedError):
+        return 1
+
+def _deflate_piece(piece, last):
+    # Each piece gets a compressor of its own. A sync flush ends the
+    # deflate data on a byte boundary without marking the last block, so
+    # that the pieces can be joined into a single stream.
+    import zlib
+    c = zlib.compressobj(zlib.Z_DEFAULT_COMPRESSION, zlib.DEFLATED, -15)
+    if last:
+        return c.compress(piece) + c.flush(zlib.Z_FINISH)
+    return c.compress(piece) + c.flush(zlib.Z_SYNC_FLUSH)
+
+def _ordered_map(func, items, nthreads):
+    """
+    Yield ``func(*item)`` for each of `items` in order, computing up to
+    twice `nthreads` results ahead on threads of their own.
+    """
+    if nthreads <= 1:
+        for item in items:
+            yield func(*item)
+        return
+    import threading
+    from collections import deque
+    def work(item, result):
+        try:
+            result.append(func(*item))
+        except Exception, e:
+            result.append(e)
+    pending = deque()
+    items = iter(items)
+    exhausted = False
+    while True:
+        while not exhausted and len(pending) < 2*nthreads:
+            try:
+                item = items.next()
+            except StopIteration:
+                exhausted = True
+                break
+            result = []
+            t = threading.Thread(target=work, args=(item, result))
+            t.start()
+            pending.append((t, result))
+        if not pending:
+            return
+        t, result = pending.popleft()
+        t.join()
+        if isinstance(result[0], Exception):
+            raise result[0]
+        yield result[0]
+
+def _write_member(zip, name, array, compress):
+    """
+    Add `array` in ``.npy`` format to `zip` as the member `name`. The data
+    is taken from the memory of the array a block at a time, and with
+    `compress` the blocks are compressed on several threads.
+    """
+    import zipfile
+    import zlib
+    import time
+
+    if array.dtype.hasobject:
+        out = BytesIO()
+        format.write_array(out, array)
+        blocks = [out.getvalue()]
+        size = len(blocks[0])
+    else:
+        header, blocks = format._array_blocks(array, _DEFLATE_PIECE)
+        size = len(header) + array.nbytes
+        blocks = itertools.chain([header], blocks)
+
+    zinfo = zipfile.ZipInfo(name, time.localtime(time.time())[:6])
+    zinfo.compress_type = zip.compression
+    zinfo.external_attr = 0600 << 16L
+    zinfo.file_size = size
+    zinfo.flag_bits = 0x00
+    zinfo.header_offset = zip.fp.tell()
+    zip._writecheck(zinfo)
+    zip._didModify = True
+    zinfo.CRC = 0
+    zinfo.compress_size = 0
+    zip64 = zip._allowZip64 and size * 1.05 > zipfile.ZIP64_LIMIT
+    zip.fp.write(zinfo.FileHeader(zip64))
+
+    crc = 0
+    compress_size = 0
+    if compress:
+        pieces = _pieces_with_last(blocks)
+        for piece, data in _ordered_map(
+                lambda piece, last: (piece, _deflate_piece(piece, last)),
+                pieces, _deflate_threads()):
+            crc = zlib.crc32(piece, crc)
+            zip.fp.write(data)
+            compress_size += len(data)
+    else:
+        for piece in blocks:
+            crc = zlib.crc32(piece, crc)
+            zip.fp.write(piece)
+            compress_size += len(piece)
+    zinfo.CRC = crc & 0xffffffff
+    zinfo.compress_size = compress_size
+    if not zip64 and max(size, compress_size) > zipfile.ZIP64_LIMIT:
+        raise RuntimeError('Compressed size larger than uncompressed size')
+
+    # Go back and write the header with the final CRC and sizes.
+    position = zip.fp.tell()
+    zip.fp.seek(zinfo.header_offset, 0)
+    zip.fp.write(zinfo.FileHeader(zip64))
+    zip.fp.seek(position, 0)
+    zip.filelist.append(zinfo)
+    zip.NameToInfo[zinfo.filename] = zinfo
+    if hasattr(zip, 'start_dir'):
+        zip.start_dir = position
+
+def _pieces_with_last(blocks):
+    """Yield (block, is_last) for each of `blocks`."""
+    blocks = iter(blocks)
+    try:
+        prev = blocks.next()
+    except StopIteration:
+        return
+    for block in blocks:
+        yield prev, False
+        prev = block
+    yield prev, True
+
 # Adapted from matplotlib
 
 def _getconv(dtype):
@@ -608,9 +780,171 @@ def _getconv(dtype):
 
 
 
+def _text_engine_supports(dtype):
+    """Whether the compiled text reader can convert to `dtype`."""
+    if dtype.names is not None:
+        return all(_text_engine_supports(dtype.fields[name][0]) and
+                   dtype.fields[name][0].names is None
+                   for name in dtype.names)
+    if dtype.shape != ():
+        return False
+    return (dtype.kind in 'biuf' or
+            (dtype.kind == 'S' and dtype.itemsize > 0))
+
+
+def _text_chunks(fh, chunksize=2**20):
+    """Yield the text of a file, or of an iterable of lines, as bytes."""
+    if hasattr(fh, 'read'):
+        while True:
+            chunk = fh.read(chunksize)
+            if not chunk:
+                break
+            yield asbytes(chunk)
+    else:
+        newline = asbytes('\n')
+        for line in fh:
+            # Each item is a line, even without a newline at the end
+            line = asbytes(line)
+            if not line.endswith(newline):
+                line += newline
+            yield line
+
+
+def _text_blocks(fh, blocksize, quotechar=None):
+    """
+    Yield the text of a file as bytes blocks of about `blocksize` bytes,
+    each made of complete rows, that is, ending after a newline which
+    isn't inside quotes.
+    """
+    newline = asbytes('\n')
+    rest = asbytes('')
+    for chunk in _text_chunks(fh, blocksize):
+        block = rest + chunk
+        end = block.rfind(newline)
+        if quotechar is not None:
+            # A newline ends a row if it follows an even number of quotes
+            nquotes = block.count(quotechar, 0, end)
+            while end >= 0 and nquotes % 2:
+                prev = block.rfind(newline, 0, end)
+                nquotes -= block.count(quotechar, prev + 1, end)
+                end = prev
+        rest = block[end + 1:]
+        if end >= 0:
+            yield block[:end + 1]
+    if rest:
+        yield rest
+
+
+def _loadtxt_parallel(fh, dtype, nthreads, skiprows, usecols, **options):
+    """
+    Parse the text of the file `fh` with `nthreads` threads.
+
+    The file is read in blocks of complete rows, one at a time, and the
+    blocks are parsed concurrently by the compiled reader, which runs
+    without the GIL, before the results are joined in order.
+    """
+    import threading
+
+    _loadtxt = np.core.multiarray._loadtxt
+    newline = asbytes('\n')
+    for i in xrange(skiprows):
+        fh.readline()
+    blocks = _text_blocks(fh, 2**22, options['quotechar'])
+    state = {'line': 1 + skiprows}
+    results = []
+    errors = []
+    lock = threading.Lock()
+
+    def next_block():
+        """Return the next block with its index and first line, or None."""
+        lock.acquire()
+        try:
+            if errors:
+                return None
+            try:
+                block = blocks.next()
+            except StopIteration:
+                return None
+            except Exception, e:
+                errors.append((len(results), e))
+                return None
+            results.append(None)
+            line = state['line']
+            state['line'] += block.count(newline)
+            return len(results) - 1, block, line
+        finally:
+            lock.release()
+
+    def parse(index, block, line, usecols):
+        try:
+            results[index] = _loadtxt([block], dtype, usecols=usecols,
+                                      firstline=line, **options)
+        except Exception, e:
+            lock.acquire()
+            errors.append((index, e))
+            lock.release()
+
+    # Parse up to the first row here, to fix the number of columns
+    while not errors:
+        task = next_block()
+        if task is None:
+            break
+        index, block, line = task
+        parse(index, block, line, usecols)
+        X = results[index]
+        if X is not None and len(X) > 0:
+            if usecols is None and X.ndim == 2:
+                usecols = range(X.shape[1])
+            break
+
+    def work():
+        while True:
+            task = next_block()
+            if task is None:
+                break
+            index, block, line = task
+            parse(index, block, line, usecols)
+
+    threads = [threading.Thread(target=work) for i in xrange(nthreads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    if errors:
+        # Raise the error found first in the file
+        raise min(errors)[1]
+    results = [X for X in results if len(X) > 0]
+    if len(results) == 0:
+        return np.array([], dtype)
+    elif len(results) == 1:
+        return results[0]
+    return np.concatenate(results)
+
+
+def _open_text(fname):
+    """
+    Return an iterator over the lines of `fname`, and whether it was
+    opened here and needs closing.
+    """
+    try:
+        if _is_string_like(fname):
+            if fname.endswith('.gz'):
+                return iter(seek_gzip_factory(fname)), True
+            elif fname.endswith('.bz2'):
+                import bz2
+                return iter(bz2.BZ2File(fname)), True
+            else:
+                return iter(open(fname, 'U')), True
+        else:
+            return iter(fname), False
+    except TypeError:
+        raise ValueError('fname must be a string, file handle, or generator')
+
+
 def loadtxt(fname, dtype=float, comments='#', delimiter=None,
             converters=None, skiprows=0, usecols=None, unpack=False,
-            ndmin=0):
+            ndmin=0, quotechar=None, twopass=False, nthreads=1):
     """
     Load data from a text file.
 
@@ -655,6 +989,25 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         Otherwise mono-dimensional axes will be squeezed.
         Legal values: 0 (default), 1 or 2.
         .. versionadded:: 1.6.0
+    quotechar : str, optional
+        The character used to quote fields, which may then contain the
+        delimiter, comment characters and newlines. A quote character
+        inside a quoted field is written twice. Quoting is not supported
+        together with `converters`. Default: None, no quoting.
+        .. versionadded:: 2.0.0
+    twopass : bool, optional
+        If True, and the file is seekable, first count the rows and then
+        read them straight into an array of the final size. This takes
+        two passes over the file, but needs no memory beyond the result.
+        Default is False.
+        .. versionadded:: 2.0.0
+    nthreads : int, optional
+        The number of threads parsing a file, which is read in blocks
+        of complete rows. Default is 1. This applies to files, not
+        generators, and only where the compiled reader is used; see the
+        notes. With `quotechar`, quote characters must not appear in
+        comments. `twopass` is ignored when more than one thread is used.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -664,6 +1017,7 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
     See Also
     --------
     load, fromstring, fromregex
+    loadtxt_chunks : Iterate over the rows of a file, a block at a time.
     genfromtxt : Load data with missing values handled as specified.
     scipy.io.loadmat : reads MATLAB data files
 
@@ -673,6 +1027,13 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
     `genfromtxt` function provides more sophisticated handling of, e.g.,
     lines with missing values.
 
+    Without `converters`, a single character `delimiter`, and a dtype
+    made of booleans, integers, floats or byte strings, the text is
+    parsed by a compiled reader straight into the result array. The
+    array is grown as the rows come in, so that reading takes up to one
+    and a half times the memory of the result, or just the result with
+    `twopass`.
+
     Examples
     --------
     >>> from StringIO import StringIO   # StringIO behaves like a file object
@@ -700,24 +1061,14 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
     user_converters = converters
     if delimiter is not None:
         delimiter = asbytes(delimiter)
+    if quotechar is not None:
+        quotechar = asbytes(quotechar)
     if usecols is not None:
         usecols = list(usecols)
+    # Make sure we're dealing with a proper dtype
+    dtype = np.dtype(dtype)
 
-    fown = False
-    try:
-        if _is_string_like(fname):
-            fown = True
-            if fname.endswith('.gz'):
-                fh = iter(seek_gzip_factory(fname))
-            elif fname.endswith('.bz2'):
-                import bz2
-                fh = iter(bz2.BZ2File(fname))
-            else:
-                fh = iter(open(fname, 'U'))
-        else:
-            fh = iter(fname)
-    except TypeError:
-        raise ValueError('fname must be a string, file handle, or generator')
+    fh, fown = _open_text(fname)
     X = []
 
     def flatten_dtype(dt):
@@ -773,9 +1124,45 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         else:
             return []
 
+    if (not user_converters and comments and
+            (delimiter is None or len(delimiter) == 1) and
+            _text_engine_supports(dtype)):
+        options = dict(delimiter=delimiter, comments=comments,
+                       quotechar=quotechar, skiprows=skiprows,
+                       usecols=usecols)
+        try:
+            if nthreads > 1 and hasattr(fh, 'read'):
+                X = _loadtxt_parallel(fh, dtype, nthreads, **options)
+            elif twopass and hasattr(fh, 'seek') and hasattr(fh, 'tell'):
+                start = fh.tell()
+                nrows, ncols = np.core.multiarray._loadtxt(
+                                _text_chunks(fh), dtype, count=True,
+                                **options)
+                fh.seek(start)
+                if dtype.names is None:
+                    X = np.empty((nrows, ncols), dtype)
+                else:
+                    X = np.empty(nrows, dtype)
+                if nrows > 0:
+                    X = np.core.multiarray._loadtxt(_text_chunks(fh),
+                                dtype, out=X, **options)
+            else:
+                X = np.core.multiarray._loadtxt(_text_chunks(fh), dtype,
+                                **options)
+        finally:
+            if fown:
+                fh.close()
+        if len(X) == 0:
+            warnings.warn('loadtxt: Empty input file: "%s"' % fname)
+            X = np.array([], dtype)
+        split_fields = dtype.names is not None and len(dtype.names) > 1
+        return _loadtxt_shape(X, dtype, ndmin, unpack, split_fields)
+    elif quotechar is not None:
+        raise ValueError("quotechar is only supported without converters, "
+                         "with a single character delimiter, and with "
+                         "boolean, integer, float or byte string dtypes")
+
     try:
-        # Make sure we're dealing with a proper dtype
-        dtype = np.dtype(dtype)
         defconv = _getconv(dtype)
 
         # Skip the first `skiprows` lines
@@ -839,6 +1226,112 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
     if X.ndim == 3 and X.shape[:2] == (1, 1):
         X.shape = (1, -1)
 
+    return _loadtxt_shape(X, dtype, ndmin, unpack, len(dtype_types) > 1)
+
+
+def loadtxt_chunks(fname, chunksize=65536, dtype=float, comments='#',
+                   delimiter=None, skiprows=0, usecols=None,
+                   quotechar=None):
+    """
+    Iterate over the rows of a text file, `chunksize` rows at a time.
+
+    The file is read in blocks, and each block of rows is parsed
+    straight into a new array, so that the memory used stays bounded
+    by the size of a block, however large the file is.
+
+    Parameters
+    ----------
+    fname : file or str
+        File, filename, or generator to read, as for `loadtxt`.
+    chunksize : int, optional
+        The largest number of rows in each array; default: 65536.
+    dtype : data-type, optional
+        Data-type of the arrays; default: float. It must consist of
+        booleans, integers, floats or byte strings. If this is a record
+        data-type, the arrays are 1-dimensional, with one element per row.
+    comments : str or None, optional
+        The character used to indicate the start of a comment;
+        default: '#'. None means no comments.
+    delimiter : str, optional
+        The character used to separate values.  By default, this is any
+        whitespace.
+    skiprows : int, optional
+        Skip the first `skiprows` lines; default: 0.
+    usecols : sequence, optional
+        Which columns to read, with 0 being the first. The default, None,
+        results in all the columns of the first row being read.
+    quotechar : str, optional
+        The character used to quote fields, as for `loadtxt`.
+        Default: None, no quoting.
+
+    Returns
+    -------
+    chunks : generator
+        Yields arrays of shape ``(n, ncolumns)``, or ``(n,)`` for record
+        data-types, where ``n`` is `chunksize` except for the last one.
+
+    See Also
+    --------
+    loadtxt
+
+    Notes
+    -----
+    .. versionadded:: 2.0.0
+
+    Examples
+    --------
+    >>> from StringIO import StringIO
+    >>> c = StringIO("0 1\\n2 3\\n4 5")
+    >>> for block in np.loadtxt_chunks(c, chunksize=2):
+    ...     print block.sum(axis=0)
+    [ 2.  4.]
+    [ 4.  5.]
+
+    """
+    chunksize = int(chunksize)
+    if chunksize < 1:
+        raise ValueError("chunksize must be at least 1")
+    if comments is not None:
+        comments = asbytes(comments)
+    if delimiter is not None:
+        delimiter = asbytes(delimiter)
+    if quotechar is not None:
+        quotechar = asbytes(quotechar)
+    if usecols is not None:
+        usecols = list(usecols)
+    dtype = np.dtype(dtype)
+    if not _text_engine_supports(dtype):
+        raise TypeError("the dtype must consist of booleans, integers, "
+                        "floats or byte strings")
+
+    fh, fown = _open_text(fname)
+    try:
+        chunks = _text_chunks(fh)
+        rest = asbytes('')
+        line = 1
+        while True:
+            X, rest, line = np.core.multiarray._loadtxt(
+                                itertools.chain([rest], chunks), dtype,
+                                delimiter=delimiter, comments=comments,
+                                quotechar=quotechar, skiprows=skiprows,
+                                usecols=usecols, max_rows=chunksize,
+                                firstline=line)
+            if len(X) > 0:
+                yield X
+            if len(X) < chunksize:
+                break
+            # Later blocks have the columns of the first one
+            skiprows = 0
+            if usecols is None and X.ndim == 2:
+                usecols = range(X.shape[1])
+    finally:
+        if fown:
+            fh.close()
+
+
+def _loadtxt_shape(X, dtype, ndmin, unpack, split_fields):
+    """Apply the `ndmin` and `unpack` arguments of loadtxt to `X`."""
+
     # Verify that the array has at least dimensions `ndmin`.
     # Check correctness of the values of `ndmin`
     if not ndmin in [0, 1, 2]:
@@ -855,7 +1348,7 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
             X = np.atleast_2d(X).T
 
     if unpack:
-        if len(dtype_types) > 1:
+        if split_fields:
             # For structured arrays, return an array for each field.
             return [X[field] for field in dtype.names]
         else:
@@ -942,6 +1435,8 @@ def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n', header='',
 
         ``o`` : signed octal
 
+        ``r`` : the shortest text which reads back to the same float
+
         ``s`` : string of characters
 
         ``u`` : unsigned decimal integer
@@ -951,6 +1446,13 @@ def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n', header='',
     This explanation of ``fmt`` is not complete, for an exhaustive
     specification see [1]_.
 
+    Booleans, integers and floats are formatted in compiled code, a block
+    of rows at a time. Except for ``%r``, the results are the same as those
+    of Python's ``%`` operator. ``%r`` writes the shortest text which reads
+    back to the same float64, where ``%`` on a NumPy float64 scalar would
+    give 17 significant digits. Float32 and half columns keep the ``repr``
+    of their scalars.
+
     References
     ----------
     .. [1] `Format Specification Mini-Language
@@ -1022,8 +1524,20 @@ def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n', header='',
         if len(header) > 0:
             header = header.replace('\n', '\n' + comments)
             fh.write(asbytes(comments + header + newline))
-        for row in X:
-            fh.write(asbytes(format % tuple(row) + newline))
+        # Numbers are formatted in C, a block of rows at a time, which
+        # gives the same text as the '%' operator except for the shortest
+        # float64 repr of '%r'
+        blocksize = max(2**16 // max(ncol, 1), 1)
+        text = np.core.multiarray._format_rows(X[:blocksize], format,
+                                               newline)
+        if text is not None:
+            fh.write(text)
+            for start in xrange(blocksize, len(X), blocksize):
+                fh.write(np.core.multiarray._format_rows(
+                            X[start:start + blocksize], format, newline))
+        else:
+            for row in X:
+                fh.write(asbytes(format % tuple(row) + newline))
         if len(footer) > 0:
             footer = footer.replace('\n', '\n' + comments)
             fh.write(asbytes(comments + footer + newline))
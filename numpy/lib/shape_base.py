@@ -250,7 +250,7 @@ def expand_dims(a, axis):
 
 row_stack = vstack
 
-def column_stack(tup):
+def column_stack(tup, nthreads=1):
     """
     Stack 1-D arrays as columns into a 2-D array.
 
@@ -263,6 +263,10 @@ def column_stack(tup):
     ----------
     tup : sequence of 1-D or 2-D arrays.
         Arrays to stack. All of them must have the same first dimension.
+    nthreads : int, optional
+        The number of threads copying the arrays, see `concatenate`.
+        Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -293,7 +297,7 @@ def column_stack(tup):
         if arr.ndim < 2:
             arr = array(arr,copy=False,subok=True,ndmin=2).T
         arrays.append(arr)
-    return _nx.concatenate(arrays,1)
+    return _nx.concatenate(arrays, 1, nthreads)
 
 def dstack(tup):
     """
@@ -466,6 +466,172 @@ def test_memmap_roundtrip():
             del ma
 
 
+def roundtrip_chunked(arr, chunksize):
+    f = StringIO()
+    format.write_array(f, arr, version=(2, 0), chunksize=chunksize)
+    f2 = StringIO(f.getvalue())
+    arr2 = format.read_array(f2)
+    return arr2
+
+def assert_same(arr, arr2):
+    assert_array_equal(arr, arr2)
+    assert_(arr.dtype == arr2.dtype)
+    assert_(arr.shape == arr2.shape)
+
+def test_roundtrip_chunked():
+    for arr in basic_arrays + record_arrays:
+        if arr.dtype.hasobject:
+            continue
+        for chunksize in [1, 40, None]:
+            arr2 = roundtrip_chunked(arr, chunksize)
+            yield assert_same, arr, arr2
+
+class OnlyWrite(object):
+    def __init__(self):
+        self.data = []
+    def write(self, s):
+        self.data.append(s)
+
+def test_write_chunked_unseekable():
+    arr = np.arange(1000.).reshape(100, 10)
+    f = OnlyWrite()
+    format.write_array(f, arr, version=(2, 0), chunksize=800)
+    f2 = StringIO(asbytes('').join(f.data))
+    assert_same(arr, format.read_array(f2))
+
+def test_write_chunked_object():
+    arr = np.array([1, 'a'], dtype=object)
+    assert_raises(ValueError, format.write_array, StringIO(), arr, (2, 0))
+
+def test_chunked_compresses():
+    arr = np.arange(100000, dtype='<i8')
+    f = StringIO()
+    format.write_array(f, arr, version=(2, 0))
+    assert_(len(f.getvalue()) < arr.nbytes // 10)
+
+def test_open_chunked():
+    arr = np.arange(24000.).reshape(2000, 3, 4)
+    fname = os.path.join(tempdir, 'chunked.npy')
+    fp = open(fname, 'wb')
+    try:
+        format.write_array(fp, arr, version=(2, 0), chunksize=1000)
+    finally:
+        fp.close()
+    indices = [0, -1, 1999, np.int32(57), slice(None), slice(100, 300),
+               slice(5, 1900, 37), slice(None, None, -1), slice(300, 10, -7),
+               slice(50, 10), (slice(3, 700), 1), (10, 2, 3), Ellipsis,
+               (Ellipsis, 0), [3, 1, 2], arr[:, 0, 0] > 1000]
+    for nthreads in [1, 3]:
+        carr = format.open_chunked(fname, nthreads=nthreads)
+        try:
+            assert_(carr.shape == arr.shape)
+            assert_(carr.dtype == arr.dtype)
+            assert_(len(carr) == len(arr))
+            assert_(carr.chunk_rows == 10)
+            for index in indices:
+                yield assert_array_equal, carr[index], arr[index]
+            yield assert_array_equal, np.asarray(carr), arr
+            assert_raises(IndexError, carr.__getitem__, 2000)
+        finally:
+            carr.close()
+
+def test_open_chunked_scalars():
+    # indexing a 1-d array with an integer gives a scalar, of any dtype
+    fname = os.path.join(tempdir, 'chunked.npy')
+    for arr in [np.array(['abc', 'de', '', 'fghij'] * 50, dtype='S5'),
+                np.array([(i, i / 2.) for i in range(200)],
+                         dtype=[('a', '<i4'), ('b', '<f8')])]:
+        fp = open(fname, 'wb')
+        try:
+            format.write_array(fp, arr, version=(2, 0), chunksize=64)
+        finally:
+            fp.close()
+        carr = np.load(fname, mmap_mode='r')
+        try:
+            for index in [0, 3, -1, 117, (5,)]:
+                yield assert_equal, carr[index], arr[index]
+                yield assert_equal, type(carr[index]), type(arr[index])
+        finally:
+            carr.close()
+
+def test_open_memmap_chunked():
+    fname = os.path.join(tempdir, 'chunked.npy')
+    fp = open(fname, 'wb')
+    try:
+        format.write_array(fp, np.arange(10), version=(2, 0))
+    finally:
+        fp.close()
+    assert_raises(ValueError, format.open_memmap, fname, mode='r')
+
+def test_page_aligned_header():
+    arr = np.arange(2**18, dtype=np.float64)
+    f = StringIO()
+    format.write_array(f, arr)
+    data = f.getvalue()
+    assert_(len(data) - arr.nbytes == format.PAGE_ALIGN)
+    assert_array_equal(format.read_array(StringIO(data)), arr)
+
+    # open_memmap lays out a new file the same way
+    mfn = os.path.join(tempdir, 'aligned.npy')
+    ma = format.open_memmap(mfn, mode='w+', dtype=arr.dtype, shape=arr.shape)
+    ma[...] = arr
+    del ma
+    fp = open(mfn, 'rb')
+    try:
+        assert_equal(fp.read(), data)
+    finally:
+        fp.close()
+    for advice in ['sequential', 'willneed', 'random', 'normal']:
+        ma = format.open_memmap(mfn, mode='r', advice=advice)
+        assert_array_equal(ma, arr)
+        del ma
+    assert_raises(ValueError, format.open_memmap, mfn, mode='r',
+                  advice='later')
+
+def test_madvise_bounds():
+    madvise = np.core.multiarray._madvise
+    # 'dontneed' would throw away heap memory around the array
+    a = np.arange(4096.)
+    b = np.arange(10.)
+    for arr in [a, a[1000:1001], b, b[3:4]]:
+        assert_raises(ValueError, madvise, arr, 'dontneed')
+        for advice in ['normal', 'random', 'sequential', 'willneed']:
+            madvise(arr, advice)
+    assert_array_equal(a, np.arange(4096.))
+    assert_array_equal(b, np.arange(10.))
+
+    # It is fine for a mapped file, whose pages are read back
+    mfn = os.path.join(tempdir, 'dontneed.npy')
+    ma = format.open_memmap(mfn, mode='w+', dtype=a.dtype, shape=a.shape)
+    ma[...] = a
+    ma.flush()
+    madvise(ma[1000:1001], 'dontneed')
+    madvise(ma, 'dontneed')
+    assert_array_equal(ma, a)
+    del ma
+
+class ShortReads(object):
+    def __init__(self, data, readinto):
+        self.f = StringIO(data)
+        if readinto:
+            self.readinto = self._readinto
+    def read(self, n):
+        return self.f.read(min(n, 1000))
+    def _readinto(self, buf):
+        data = self.read(len(buf))
+        buf[:len(data)] = np.frombuffer(data, dtype=np.uint8)
+        return len(data)
+
+def test_read_short_reads():
+    arr = np.arange(10000, dtype='>i4').reshape(100, 100)
+    f = StringIO()
+    format.write_array(f, arr)
+    data = f.getvalue()
+    for readinto in [False, True]:
+        assert_array_equal(format.read_array(ShortReads(data, readinto)), arr)
+        assert_raises(ValueError, format.read_array,
+                      ShortReads(data[:-1], readinto))
+
 def test_write_version_1_0():
     f = StringIO()
     arr = np.arange(1)
@@ -478,8 +644,8 @@ def test_write_version_1_0():
         (1, 1),
         (0, 0),
         (0, 1),
-        (2, 0),
-        (2, 2),
+        (2, 1),
+        (3, 0),
         (255, 255),
     ]
     for version in bad_versions:
@@ -495,8 +661,8 @@ bad_version_magic = asbytes_nested([
     '\x93NUMPY\x01\x01',
     '\x93NUMPY\x00\x00',
     '\x93NUMPY\x00\x01',
-    '\x93NUMPY\x02\x00',
     '\x93NUMPY\x02\x02',
+    '\x93NUMPY\x03\x00',
     '\x93NUMPY\xff\xff',
 ])
 malformed_magic = asbytes_nested([
@@ -534,6 +700,12 @@ def test_large_header():
     d = {'a':1,'b':2,'c':'x'*256*256}
     assert_raises(ValueError, format.write_array_header_1_0, s, d)
 
+def test_large_header_2_0():
+    s = StringIO()
+    d = {'a':1,'b':2,'c':'x'*256*256}
+    format.write_array_header_2_0(s,d)
+    assert_(len(s.getvalue()) % 16 == 8)
+
 def test_bad_header():
     # header of length less than 2 should fail
     s = StringIO()
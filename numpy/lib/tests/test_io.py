@@ -117,6 +117,19 @@ class TestSaveLoad(RoundtripTest, TestCase):
         RoundtripTest.roundtrip(self, np.save, *args, **kwargs)
         assert_equal(self.arr[0], self.arr_reloaded)
 
+class TestSaveLoadCompressed(RoundtripTest, TestCase):
+    def roundtrip(self, *args, **kwargs):
+        kwargs['save_kwds'] = {'compress': True}
+        RoundtripTest.roundtrip(self, np.save, *args, **kwargs)
+        assert_equal(self.arr[0], self.arr_reloaded)
+
+    def test_mmap(self):
+        a = np.arange(1000.).reshape(100, 10)
+        self.roundtrip(a, file_on_disk=True, load_kwds={'mmap_mode': 'r'})
+        assert_(isinstance(self.arr_reloaded, np.lib.format.ChunkedArray))
+        assert_equal(self.arr_reloaded[10:20, 3], a[10:20, 3])
+        self.arr_reloaded.close()
+
 class TestSavezLoad(RoundtripTest, TestCase):
     def roundtrip(self, *args, **kwargs):
         RoundtripTest.roundtrip(self, np.savez, *args, **kwargs)
@@ -165,6 +178,40 @@ class TestSavezLoad(RoundtripTest, TestCase):
         if errors:
             raise AssertionError(errors)
 
+    def test_members_in_pieces(self):
+        import zipfile
+        from numpy.lib import npyio
+        arrays = dict(c=np.arange(3000.).reshape(100, 30),
+                      f=np.asfortranarray(np.arange(3000).reshape(30, 100)),
+                      s=np.arange(6000)[::2].reshape(100, 30),
+                      r=np.array([(1, 2.)] * 700, 'i4,f8'),
+                      z=np.array(3.5), e=np.zeros((0, 3)),
+                      o=np.array([None, 'a', 1], object))
+        piece = npyio._DEFLATE_PIECE
+        npyio._DEFLATE_PIECE = 1000
+        try:
+            for save in (np.savez, np.savez_compressed):
+                c = StringIO()
+                save(c, **arrays)
+                c.seek(0)
+                assert_(zipfile.ZipFile(c).testzip() is None)
+                c.seek(0)
+                l = np.load(c)
+                for key, arr in arrays.items():
+                    assert_equal(arr, l[key])
+                assert_(l['f'].flags.f_contiguous)
+        finally:
+            npyio._DEFLATE_PIECE = piece
+
+    def test_non_npy_member(self):
+        import zipfile
+        c = StringIO()
+        zip = zipfile.ZipFile(c, 'w')
+        zip.writestr('notes.txt', asbytes('some text'))
+        zip.close()
+        c.seek(0)
+        assert_equal(np.load(c)['notes.txt'], asbytes('some text'))
+
 class TestSaveTxt(TestCase):
     def test_array(self):
         a = np.array([[1, 2], [3, 4]], float)
@@ -273,6 +320,58 @@ class TestSaveTxt(TestCase):
         finally:
             os.unlink(name)
 
+    def test_format_like_python(self):
+        # The numbers are formatted in C, with the same results as '%'
+        values = [0., -0., 1.5, -2.5, 0.1, 1e-300, 5e-324, 1e49, 1e50,
+                  -1e60, 9.3e18, np.nan, -np.nan, np.inf, -np.inf]
+        formats = ['%d', '%+5i', '%-4u', '%x', '%o', '%.18e', '%10.3E',
+                   '%-12.4f', '%#.0f', '%g', '%010.2G', '%lf']
+        for dt in ['f8', 'f4', '>f8', 'f2', 'g']:
+            for fmt in formats:
+                a = np.array([values], dtype=dt)
+                if fmt[-1] in 'diuxo':
+                    # Python can't convert nan and inf to integers
+                    a = a[np.isfinite(a)].reshape(1, -1)
+                row = ' '.join([fmt] * a.shape[1])
+                c = StringIO()
+                np.savetxt(c, a, fmt=fmt)
+                assert_equal(c.getvalue(), asbytes(row % tuple(a[0]) + '\n'))
+        for dt in ['i1', 'u1', '>i4', 'i8', 'u8', '?']:
+            a = np.array([[0, 1, 127]], dtype=dt)
+            if dt != '?':
+                a = np.r_[a, np.array([np.iinfo(dt).min, np.iinfo(dt).max,
+                                       -1], dtype=dt).reshape(1, -1)]
+            for fmt in ['%d', '%5x', '%-3X', '%o', '%.3e', '%f']:
+                row = ' '.join([fmt] * 3)
+                c = StringIO()
+                np.savetxt(c, a, fmt=fmt)
+                assert_equal(c.getvalue(), asbytes(''.join(
+                                row % tuple(r) + '\n' for r in a)))
+
+    def test_format_record(self):
+        dt = [('a', '>i4'), ('b', '<f4'), ('c', '?'), ('d', 'S2')]
+        a = np.array([(1, 2.5, True, 'x'), (-3, np.nan, False, 'yz')], dt)
+        c = StringIO()
+        np.savetxt(c, a[['a', 'b', 'c']], fmt='%d;%.3e <%r>')
+        assert_equal(c.getvalue(), asbytes('1;2.500e+00 <True>\n'
+                                           '-3;nan <False>\n'))
+        # Byte strings are formatted by Python
+        c = StringIO()
+        np.savetxt(c, a, fmt='%d %.1f %d %s')
+        assert_equal(c.getvalue(), asbytes('1 2.5 1 x\n-3 nan 0 yz\n'))
+
+    def test_shortest_repr(self):
+        # %r writes the shortest text which reads back the same
+        a = np.r_[np.random.randn(1000) * 10.0**np.random.randint(-300,
+                                                                  300, 1000),
+                  0.1, -0.0, 5e-324, 1e16, 1e15, 1e-4, 1e-5]
+        c = StringIO()
+        np.savetxt(c, a, fmt='%r')
+        lines = c.getvalue().split()
+        assert_equal(lines, [asbytes(repr(float(x))) for x in a])
+        c.seek(0)
+        assert_array_equal(np.loadtxt(c), a)
+
 
 class TestLoadTxt(TestCase):
     def test_record(self):
@@ -557,6 +656,174 @@ class TestLoadTxt(TestCase):
         res = np.loadtxt(count())
         assert_array_equal(res, np.arange(10))
 
+    def test_quotechar(self):
+        c = StringIO(asbytes('"1,5",2\n"a""b",3\n'))
+        x = np.loadtxt(c, dtype='S4,i4', delimiter=',', quotechar='"')
+        assert_equal(x['f0'], asbytes_nested(['1,5', 'a"b']))
+        assert_equal(x['f1'], [2, 3])
+        c = StringIO(asbytes('"1.5" "2\n#3" #x\n4 5'))
+        x = np.loadtxt(c, dtype='S4', quotechar='"')
+        assert_equal(x, asbytes_nested([['1.5', '2\n#3'], ['4', '5']]))
+        c = StringIO(asbytes('1 2'))
+        assert_raises(ValueError, np.loadtxt, c, quotechar='"',
+                      converters={0: float})
+
+    def test_line_endings_and_comments(self):
+        c = StringIO(asbytes('# head\r\n1,2 # one\r\n\r\n   \r3,4\n5,6'))
+        x = np.loadtxt(c, delimiter=',')
+        assert_array_equal(x, [[1, 2], [3, 4], [5, 6]])
+        c = StringIO(asbytes('1 2 // x\n3 4'))
+        x = np.loadtxt(c, comments='//')
+        assert_array_equal(x, [[1, 2], [3, 4]])
+
+    def test_integer_conversion(self):
+        c = StringIO(asbytes('17 -2.5 3e2\n18446744073709551615 0 +7'))
+        x = np.loadtxt(c, dtype=np.uint64, usecols=(0,))
+        assert_array_equal(x, np.array([17, 18446744073709551615],
+                                       dtype=np.uint64))
+        c.seek(0)
+        x = np.loadtxt(c, dtype='>i2', usecols=(1, 2))
+        assert_equal(x.dtype, np.dtype('>i2'))
+        assert_array_equal(x, [[-2, 300], [0, 7]])
+        c = StringIO(asbytes('1 x'))
+        assert_raises(ValueError, np.loadtxt, c, dtype=int)
+        c = StringIO(asbytes('99999999999999999999'))
+        assert_raises(OverflowError, np.loadtxt, c, dtype=np.int64)
+        c = StringIO(asbytes('1 2\n3'))
+        assert_raises(ValueError, np.loadtxt, c)
+
+    def test_strict_integer_conversion(self):
+        # Booleans and 64 bit integers don't accept floating point text
+        for dt in (bool, np.int64, np.uint64, 'i8,i8'):
+            for text in ('1.5', '1e3', '0.5'):
+                c = StringIO(asbytes(text + ' 1'))
+                assert_raises(ValueError, np.loadtxt, c, dtype=dt)
+        c = StringIO(asbytes('-1 0 +7 99999999999999999999'))
+        assert_array_equal(np.loadtxt(c, dtype=bool),
+                           [True, False, True, True])
+
+    def test_float_round_trip(self):
+        rng = np.random.RandomState(0)
+        a = np.concatenate([rng.standard_normal(2000) * 10.0**e
+                            for e in range(-30, 31, 5)])
+        c = StringIO(asbytes('\n'.join(repr(v) for v in a) + '\n'))
+        assert_array_equal(np.loadtxt(c), a)
+        c = StringIO(asbytes('nan -inf Infinity 1e-320 .5'))
+        x = np.loadtxt(c)
+        assert_(np.isnan(x[0]))
+        assert_array_equal(x[1:], [-np.inf, np.inf, 1e-320, 0.5])
+
+    def test_large_file(self):
+        # Rows span the chunks the file is read in
+        data = np.arange(600000, dtype=float).reshape(-1, 3) / 7.
+        f, name = mkstemp(suffix='.txt')
+        os.close(f)
+        try:
+            np.savetxt(name, data, fmt='%r')
+            x = np.loadtxt(name, skiprows=1)
+            assert_array_equal(x, data[1:])
+            x = np.loadtxt(name, skiprows=1, nthreads=4)
+            assert_array_equal(x, data[1:])
+        finally:
+            os.remove(name)
+
+    def test_twopass(self):
+        c = StringIO(asbytes('# header\n1 2 3\n\n4 5 6\n7 8 9\n'))
+        x = np.loadtxt(c, twopass=True)
+        assert_array_equal(x, [[1, 2, 3], [4, 5, 6], [7, 8, 9]])
+        c = StringIO(asbytes('1,a\n2,b\n'))
+        dt = [('x', 'i4'), ('y', 'S1')]
+        x = np.loadtxt(c, dtype=dt, delimiter=',', twopass=True)
+        assert_array_equal(x, np.array([(1, 'a'), (2, 'b')], dt))
+        c = StringIO(asbytes('1 2 3\n4 5 6\n'))
+        x = np.loadtxt(c, usecols=(2, 0), twopass=True, ndmin=2)
+        assert_array_equal(x, [[3, 1], [6, 4]])
+        # Not seekable, read in one pass
+        x = np.loadtxt(iter([asbytes('1 2'), asbytes('3 4')]), twopass=True)
+        assert_array_equal(x, [[1, 2], [3, 4]])
+
+    def test_nthreads(self):
+        c = StringIO(asbytes('# a b\n1 2\n3 4\n\n5 6\n'))
+        x = np.loadtxt(c, nthreads=3, skiprows=1, usecols=(1,))
+        assert_array_equal(x, [2, 4, 6])
+        c = StringIO(asbytes('1 2\n3 x\n'))
+        try:
+            np.loadtxt(c, nthreads=2)
+        except ValueError, e:
+            assert_('line 2' in str(e))
+        else:
+            raise AssertionError("no error for a bad value")
+        c = StringIO(asbytes('# nothing\n'))
+        x = np.loadtxt(c, nthreads=2)
+        assert_equal(x.shape, (0,))
+
+    def test_text_blocks(self):
+        # Blocks end at newlines outside quotes
+        text = asbytes('1,"a\nb"\n2,"c"\n3,"d\n\n""e"\n4,f')
+        c = StringIO(text)
+        blocks = list(np.lib.npyio._text_blocks(c, 3, asbytes('"')))
+        assert_equal(asbytes('').join(blocks), text)
+        assert_equal(blocks, [asbytes(x) for x in
+                        ('1,"a\nb"\n', '2,"c"\n', '3,"d\n\n""e"\n', '4,f')])
+        c = StringIO(text)
+        x = np.loadtxt(c, dtype='S8', delimiter=',', quotechar='"',
+                       nthreads=2)
+        assert_array_equal(x[:, 1], ['a\nb', 'c', 'd\n\n"e', 'f'])
+
+
+class TestLoadTxtChunks(TestCase):
+    def test_chunks(self):
+        data = np.arange(3000).reshape(-1, 3)
+        c = StringIO()
+        np.savetxt(c, data, fmt='%d', header='a b c')
+        for n in (1, 7, 500, 1000, 5000):
+            c.seek(0)
+            chunks = list(np.loadtxt_chunks(c, chunksize=n, dtype=int))
+            assert_equal(len(chunks), (1000 + n - 1) // n)
+            assert_(all(len(x) == n for x in chunks[:-1]))
+            assert_array_equal(np.concatenate(chunks), data)
+
+    def test_options(self):
+        c = StringIO(asbytes('skip\n1,"a,b",3\n# comment\n4,"c",6\n'
+                             '7,"d"\n'))
+        chunks = np.loadtxt_chunks(c, chunksize=1, dtype='S3',
+                                   delimiter=',', skiprows=1,
+                                   usecols=(1, 0), quotechar='"')
+        assert_array_equal(np.concatenate(list(chunks)),
+                           [['a,b', '1'], ['c', '4'], ['d', '7']])
+        dt = [('x', 'i4'), ('y', 'f8')]
+        c = StringIO(asbytes('1 2.5\n3 4.5\n5 6.5'))
+        chunks = list(np.loadtxt_chunks(c, chunksize=2, dtype=dt))
+        assert_equal([len(x) for x in chunks], [2, 1])
+        assert_array_equal(chunks[1], np.array([(5, 6.5)], dt))
+
+    def test_no_comments(self):
+        c = StringIO(asbytes('#1 None\nNone #2\n'))
+        chunks = np.loadtxt_chunks(c, chunksize=5, dtype='S4',
+                                   comments=None)
+        assert_array_equal(np.concatenate(list(chunks)),
+                           [['#1', 'None'], ['None', '#2']])
+
+    def test_errors(self):
+        # Line numbers count from the start of the file
+        c = StringIO(asbytes('1 2\n3 4\n5 x\n'))
+        chunks = np.loadtxt_chunks(c, chunksize=1)
+        assert_array_equal(chunks.next(), [[1, 2]])
+        assert_array_equal(chunks.next(), [[3, 4]])
+        try:
+            chunks.next()
+        except ValueError, e:
+            assert_('line 3' in str(e))
+        else:
+            raise AssertionError("no error for a bad value")
+        # Later rows have the columns of the first one
+        c = StringIO(asbytes('1 2\n3\n'))
+        chunks = np.loadtxt_chunks(c, chunksize=1)
+        chunks.next()
+        assert_raises(ValueError, chunks.next)
+        assert_raises(ValueError, list, np.loadtxt_chunks(c, chunksize=0))
+        assert_raises(TypeError, list, np.loadtxt_chunks(c, dtype=object))
+
 class Testfromregex(TestCase):
     def test_record(self):
         c = StringIO()
@@ -18,9 +18,10 @@ from numpy.core import array, asarray, zeros, empty, transpose, \
         intc, single, double, csingle, cdouble, inexact, complexfloating, \
         newaxis, ravel, all, Inf, dot, add, multiply, identity, sqrt, \
         maximum, flatnonzero, diagonal, arange, fastCopyAndTranspose, sum, \
-        isfinite, size, finfo, absolute, log, exp
+        isfinite, size, finfo, absolute, log, exp, concatenate
+from numpy.core.umath import UFUNC_BUFSIZE_DEFAULT, ERR_CALL, SHIFT_INVALID
 from numpy.lib import triu
-from numpy.linalg import lapack_lite
+from numpy.linalg import lapack_lite, _umath_linalg
 from numpy.matrixlib.defmatrix import matrix_power
 from numpy.compat import asbytes
 
@@ -154,11 +155,22 @@ def _assertRank2(*arrays):
             raise LinAlgError('%d-dimensional array given. Array must be '
                     'two-dimensional' % len(a.shape))
 
+def _assertRankAtLeast2(*arrays):
+    for a in arrays:
+        if len(a.shape) < 2:
+            raise LinAlgError('%d-dimensional array given. Array must be '
+                    'at least two-dimensional' % len(a.shape))
+
 def _assertSquareness(*arrays):
     for a in arrays:
         if max(a.shape) != min(a.shape):
             raise LinAlgError('Array must be square')
 
+def _assertNdSquareness(*arrays):
+    for a in arrays:
+        if max(a.shape[-2:]) != min(a.shape[-2:]):
+            raise LinAlgError('Last 2 dimensions of the array must be square')
+
 def _assertFinite(*arrays):
     for a in arrays:
         if not (isfinite(a).all()):
@@ -169,6 +181,81 @@ def _assertNonEmpty(*arrays):
         if size(a) == 0:
             raise LinAlgError("Arrays cannot be empty")
 
+# Stacks of matrices
+
+def _linalgErrorExtobj(message):
+    """
+    The `extobj` of a gufunc in _umath_linalg which raises a LinAlgError
+    with `message` when a matrix of the stack cannot be factored. The
+    gufuncs signal this with the invalid floating point flag.
+    """
+    def callback(err, flag):
+        raise LinAlgError(message)
+    return [UFUNC_BUFSIZE_DEFAULT, ERR_CALL << SHIFT_INVALID, callback]
+
+_singular_extobj = _linalgErrorExtobj('Singular matrix')
+_cholesky_extobj = _linalgErrorExtobj('Matrix is not positive definite - '
+                                      'Cholesky decomposition cannot be '
+                                      'computed')
+_eigh_extobj = _linalgErrorExtobj('Eigenvalues did not converge')
+_svd_extobj = _linalgErrorExtobj('SVD did not converge')
+
+def _castResult(a, result_t):
+    if a.dtype.type is not result_t:
+        a = a.astype(result_t)
+    return a
+
+def _stacked(gufunc, args, cores, nthreads, extobj=None):
+    """
+    Call the gufunc `gufunc` on the stacks of matrices `args`, the last
+    ``cores[i]`` axes of ``args[i]`` holding its matrices or vectors.
+
+    The gufunc runs its loop over the stack without the GIL, so with more
+    than one of `nthreads` the stack is split along its first axis between
+    that many threads, and their results are joined. Empty stacks and
+    empty matrices raise a LinAlgError, as the gufuncs cannot loop over
+    them.
+    """
+    _assertNonEmpty(*args)
+    kwargs = {}
+    if extobj is not None:
+        kwargs['extobj'] = extobj
+    nstack = max([a.ndim - c for a, c in zip(args, cores)])
+    n = max([a.shape[0] for a, c in zip(args, cores) if a.ndim - c == nstack])
+    if nthreads <= 1 or n < 2:
+        return gufunc(*args, **kwargs)
+
+    import threading
+    nthreads = min(nthreads, n)
+    bounds = [n*i // nthreads for i in range(nthreads + 1)]
+    results = [None] * nthreads
+
+    def work(i):
+        lo, hi = bounds[i], bounds[i + 1]
+        chunk = []
+        for a, c in zip(args, cores):
+            # The arguments with fewer axes broadcast against each chunk
+            if a.ndim - c == nstack and a.shape[0] == n:
+                a = a[lo:hi]
+            chunk.append(a)
+        try:
+            results[i] = gufunc(*chunk, **kwargs)
+        except Exception, e:
+            results[i] = e
+
+    threads = [threading.Thread(target=work, args=(i,))
+               for i in range(nthreads)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    for r in results:
+        if isinstance(r, Exception):
+            raise r
+    if isinstance(results[0], tuple):
+        return tuple([concatenate(r) for r in zip(*results)])
+    return concatenate(results)
+
 
 # Linear equations
 
@@ -241,7 +328,7 @@ def tensorsolve(a, b, axes=None):
     res.shape = oldshape
     return res
 
-def solve(a, b):
+def solve(a, b, nthreads=1):
     """
     Solve a linear matrix equation, or system of linear scalar equations.
 
@@ -250,14 +337,20 @@ def solve(a, b):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Coefficient matrix.
-    b : array_like, shape (M,) or (M, N)
-        Ordinate or "dependent variable" values.
+    a : array_like, shape (..., M, M)
+        Coefficient matrix, or a stack of them in the last two axes.
+    b : array_like, shape (..., M) or (..., M, N)
+        Ordinate or "dependent variable" values. `b` is a vector, or a
+        stack of them, when it has one dimension or one less than `a`.
+        The stacks of `a` and `b` are broadcast against each other.
+    nthreads : int, optional
+        The number of threads solving a stack of systems, each of them
+        working on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
-    x : ndarray, shape (M,) or (M, N) depending on b
+    x : ndarray, shape (..., M) or (..., M, N) depending on b
         Solution to the system a x = b
 
     Raises
@@ -305,6 +398,20 @@ def solve(a, b):
     """
     a, _ = _makearray(a)
     b, wrap = _makearray(b)
+    if a.ndim > 2 or b.ndim > 2:
+        _assertRankAtLeast2(a)
+        _assertNdSquareness(a)
+        one_eq = b.ndim == 1 or b.ndim == a.ndim - 1
+        if one_eq:
+            gufunc, b_core, m = _umath_linalg.solve1, 1, b.shape[-1]
+        else:
+            gufunc, b_core, m = _umath_linalg.solve, 2, b.shape[-2]
+        if m != a.shape[-1]:
+            raise LinAlgError('Incompatible dimensions')
+        t, result_t = _commonType(a, b)
+        x = _stacked(gufunc, (asarray(a, t), asarray(b, t)), (2, b_core),
+                     nthreads, _singular_extobj)
+        return wrap(_castResult(x, result_t))
     one_eq = len(b.shape) == 1
     if one_eq:
         b = b[:, newaxis]
@@ -401,7 +508,7 @@ def tensorinv(a, ind=2):
 
 # Matrix inversion
 
-def inv(a):
+def inv(a, nthreads=1):
     """
     Compute the (multiplicative) inverse of a matrix.
 
@@ -410,12 +517,16 @@ def inv(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Matrix to be inverted.
+    a : array_like, shape (..., M, M)
+        Matrix to be inverted, or a stack of them in the last two axes.
+    nthreads : int, optional
+        The number of threads inverting a stack of matrices, each of them
+        working on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
-    ainv : ndarray or matrix, shape (M, M)
+    ainv : ndarray or matrix, shape (..., M, M)
         (Multiplicative) inverse of the matrix `a`.
 
     Raises
@@ -440,14 +551,29 @@ def inv(a):
     matrix([[-2. ,  1. ],
             [ 1.5, -0.5]])
 
+    Stacks of matrices are inverted in one call:
+
+    >>> a = np.array([[[1., 2.], [3., 4.]], [[1, 3], [3, 5]]])
+    >>> LA.inv(a)
+    array([[[-2.  ,  1.  ],
+            [ 1.5 , -0.5 ]],
+           [[-1.25,  0.75],
+            [ 0.75, -0.25]]])
+
     """
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        ainv = _stacked(_umath_linalg.inv, (asarray(a, t),), (2,), nthreads,
+                        _singular_extobj)
+        return wrap(_castResult(ainv, result_t))
     return wrap(solve(a, identity(a.shape[0], dtype=a.dtype)))
 
 
 # Cholesky decomposition
 
-def cholesky(a):
+def cholesky(a, nthreads=1):
     """
     Cholesky decomposition.
 
@@ -459,13 +585,17 @@ def cholesky(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
+    a : array_like, shape (..., M, M)
         Hermitian (symmetric if all elements are real), positive-definite
-        input matrix.
+        input matrix, or a stack of them in the last two axes.
+    nthreads : int, optional
+        The number of threads factoring a stack of matrices, each of them
+        working on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
-    L : ndarray, or matrix object if `a` is, shape (M, M)
+    L : ndarray, or matrix object if `a` is, shape (..., M, M)
         Lower-triangular Cholesky factor of a.
 
     Raises
@@ -514,6 +644,12 @@ def cholesky(a):
 
     """
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        L = _stacked(_umath_linalg.cholesky_lo, (asarray(a, t),), (2,),
+                     nthreads, _cholesky_extobj)
+        return wrap(_castResult(L, result_t))
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1067,7 +1203,7 @@ def eig(a):
     return w.astype(result_t), wrap(vt)
 
 
-def eigh(a, UPLO='L'):
+def eigh(a, UPLO='L', nthreads=1):
     """
     Return the eigenvalues and eigenvectors of a Hermitian or symmetric matrix.
 
@@ -1077,17 +1213,22 @@ def eigh(a, UPLO='L'):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        A complex Hermitian or real symmetric matrix.
+    a : array_like, shape (..., M, M)
+        A complex Hermitian or real symmetric matrix, or a stack of them
+        in the last two axes.
     UPLO : {'L', 'U'}, optional
         Specifies whether the calculation is done with the lower triangular
         part of `a` ('L', default) or the upper triangular part ('U').
+    nthreads : int, optional
+        The number of threads working on a stack of matrices, each of them
+        on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
-    w : ndarray, shape (M,)
+    w : ndarray, shape (..., M)
         The eigenvalues, not necessarily ordered.
-    v : ndarray, or matrix object if `a` is, shape (M, M)
+    v : ndarray, or matrix object if `a` is, shape (..., M, M)
         The column ``v[:, i]`` is the normalized eigenvector corresponding
         to the eigenvalue ``w[i]``.
 
@@ -1149,6 +1290,19 @@ def eigh(a, UPLO='L'):
     """
     UPLO = asbytes(UPLO)
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        if UPLO.upper() == _L:
+            gufunc = _umath_linalg.eigh_lo
+        elif UPLO.upper() == asbytes('U'):
+            gufunc = _umath_linalg.eigh_up
+        else:
+            raise ValueError("UPLO argument must be 'L' or 'U'")
+        t, result_t = _commonType(a)
+        w, v = _stacked(gufunc, (asarray(a, t),), (2,), nthreads,
+                        _eigh_extobj)
+        return (_castResult(w, _realType(result_t)),
+                wrap(_castResult(v, result_t)))
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1192,7 +1346,7 @@ def eigh(a, UPLO='L'):
 
 # Singular value decomposition
 
-def svd(a, full_matrices=1, compute_uv=1):
+def svd(a, full_matrices=1, compute_uv=1, nthreads=1):
     """
     Singular Value Decomposition.
 
@@ -1202,7 +1356,8 @@ def svd(a, full_matrices=1, compute_uv=1):
     Parameters
     ----------
     a : array_like
-        A real or complex matrix of shape (`M`, `N`) .
+        A real or complex matrix of shape (`M`, `N`), or a stack of them
+        of shape (..., `M`, `N`), which gives stacks of the results.
     full_matrices : bool, optional
         If True (default), `u` and `v` have the shapes (`M`, `M`) and
         (`N`, `N`), respectively.  Otherwise, the shapes are (`M`, `K`)
@@ -1210,6 +1365,10 @@ def svd(a, full_matrices=1, compute_uv=1):
     compute_uv : bool, optional
         Whether or not to compute `u` and `v` in addition to `s`.  True
         by default.
+    nthreads : int, optional
+        The number of threads decomposing a stack of matrices, each of
+        them working on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -1269,6 +1428,24 @@ def svd(a, full_matrices=1, compute_uv=1):
 
     """
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        t, result_t = _commonType(a)
+        m, n = a.shape[-2:]
+        # The gufuncs differ in the number of singular values, min(m, n)
+        if not compute_uv:
+            gufunc = m <= n and _umath_linalg.svd_m or _umath_linalg.svd_n
+        elif full_matrices:
+            gufunc = m <= n and _umath_linalg.svd_m_f or _umath_linalg.svd_n_f
+        else:
+            gufunc = m <= n and _umath_linalg.svd_m_s or _umath_linalg.svd_n_s
+        results = _stacked(gufunc, (asarray(a, t),), (2,), nthreads,
+                           _svd_extobj)
+        if not compute_uv:
+            return _castResult(results, _realType(result_t))
+        u, s, vt = results
+        return (wrap(_castResult(u, result_t)),
+                _castResult(s, _realType(result_t)),
+                wrap(_castResult(vt, result_t)))
     _assertRank2(a)
     _assertNonEmpty(a)
     m, n = a.shape
@@ -1558,7 +1735,7 @@ def pinv(a, rcond=1e-15 ):
 
 # Determinant
 
-def slogdet(a):
+def slogdet(a, nthreads=1):
     """
     Compute the sign and (natural) logarithm of the determinant of an array.
 
@@ -1570,15 +1747,20 @@ def slogdet(a):
     Parameters
     ----------
     a : array_like
-        Input array, has to be a square 2-D array.
+        Input array, has to be a square 2-D array, or a stack of them of
+        shape (..., M, M).
+    nthreads : int, optional
+        The number of threads working on a stack of matrices, each of them
+        on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
-    sign : float or complex
+    sign : float or complex, or an array of them for a stack
         A number representing the sign of the determinant. For a real matrix,
         this is 1, 0, or -1. For a complex matrix, this is a complex number
         with absolute value 1 (i.e., it is on the unit circle), or else 0.
-    logdet : float
+    logdet : float, or an array of them for a stack
         The natural log of the absolute value of the determinant.
 
     If the determinant is zero, then `sign` will be 0 and `logdet` will be
@@ -1615,6 +1797,11 @@ def slogdet(a):
 
     """
     a = asarray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        return _stacked(_umath_linalg.slogdet, (asarray(a, t),), (2,),
+                        nthreads)
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1640,14 +1827,18 @@ def slogdet(a):
     logdet = add.reduce(absd, axis=-1)
     return sign, logdet
 
-def det(a):
+def det(a, nthreads=1):
     """
     Compute the determinant of an array.
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Input array.
+    a : array_like, shape (..., M, M)
+        Input array, or a stack of them in the last two axes.
+    nthreads : int, optional
+        The number of threads working on a stack of matrices, each of them
+        on a part of the first axis. Default is 1.
+        .. versionadded:: 2.0.0
 
     Returns
     -------
@@ -1673,6 +1864,11 @@ def det(a):
       for large matrices where underflow/overflow may occur.
 
     """
+    a = asarray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        return _stacked(_umath_linalg.det, (asarray(a, t),), (2,), nthreads)
     sign, logdet = slogdet(a)
     return sign * exp(logdet)
 
@@ -32,6 +32,15 @@ int xerbla_(char *srname, integer *info)
                 len--;
 
         snprintf(buf, sizeof(buf), format, len, srname, *info);
+#ifdef WITH_THREAD
+        /* The gufuncs in _umath_linalg call LAPACK without the GIL */
+        {
+                PyGILState_STATE save = PyGILState_Ensure();
+                PyErr_SetString(PyExc_ValueError, buf);
+                PyGILState_Release(save);
+        }
+#else
         PyErr_SetString(PyExc_ValueError, buf);
+#endif
         return 0;
 }
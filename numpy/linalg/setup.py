@@ -13,21 +13,45 @@ def configuration(parent_package='',top_path=None):
     def get_lapack_lite_sources(ext, build_dir):
         if not lapack_info:
             print("### Warning:  Using unoptimized lapack ###")
-            return ext.depends[:-1]
-        else:
-            if sys.platform=='win32':
-                print("### Warning:  python_xerbla.c is disabled ###")
-                return ext.depends[:1]
-            return ext.depends[:2]
+        elif sys.platform=='win32':
+            print("### Warning:  python_xerbla.c is disabled ###")
+            return ext.depends[:1]
+        return ext.depends[:2]
+
+    # The f2c translated lapack is compiled once into a library which is
+    # linked into both extensions; it is created for the build but it is
+    # not installed
+    f2c_lapack_src = ['zlapack_lite.c', 'dlapack_lite.c',
+                      'blas_lite.c', 'dlamch.c',
+                      'f2c_lite.c']
+    if lapack_info:
+        lapack_lite_libs = []
+    else:
+        config.add_library('npylapacklite',
+                           sources = f2c_lapack_src,
+                           depends = ['f2c.h'])
+        lapack_lite_libs = ['npylapacklite']
 
     config.add_extension('lapack_lite',
                          sources = [get_lapack_lite_sources],
-                         depends=  ['lapack_litemodule.c',
-                                    'python_xerbla.c',
-                                    'zlapack_lite.c', 'dlapack_lite.c',
-                                    'blas_lite.c', 'dlamch.c',
-                                    'f2c_lite.c','f2c.h'],
-                         extra_info = lapack_info
+                         depends=  ['lapack_litemodule.c', 'python_xerbla.c',
+                                    'f2c.h'],
+                         extra_info = lapack_info,
+                         libraries = lapack_lite_libs
+                         )
+
+    # The gufuncs over stacks of matrices, which use the same lapack
+    if lapack_info:
+        umath_linalg_macros = []
+    else:
+        umath_linalg_macros = [('LAPACK_LITE', None)]
+    config.add_extension('_umath_linalg',
+                         sources = [get_lapack_lite_sources],
+                         depends=  ['umath_linalg.c.src', 'python_xerbla.c',
+                                    'f2c.h'],
+                         extra_info = lapack_info,
+                         define_macros = umath_linalg_macros,
+                         libraries = lapack_lite_libs + ['npymath']
                          )
 
     return config
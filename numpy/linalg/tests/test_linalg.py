@@ -456,5 +456,95 @@ class TestQR(TestCase):
         self.assertRaises(linalg.LinAlgError, linalg.qr, a)
 
 
+class TestStacked(TestCase):
+    def setUp(self):
+        rs = np.random.RandomState(1234)
+        self.a = rs.randn(3, 2, 4, 4) + 1j*rs.randn(3, 2, 4, 4)
+        self.b = rs.randn(3, 2, 4, 2)
+        self.h = np.array([[dot(x, x.conj().T) + 4*identity(4)
+                            for x in y] for y in self.a])
+
+    def each(self, f, *args):
+        return [[f(*[x[i, j] for x in args]) for j in range(2)]
+                for i in range(3)]
+
+    def test_inv_det(self):
+        for a in (self.a, self.a.real, self.a.astype(csingle)):
+            for nthreads in (1, 2):
+                r = linalg.inv(a, nthreads=nthreads)
+                assert_equal(r.dtype, linalg.inv(a[0, 0]).dtype)
+                assert_almost_equal(r, self.each(linalg.inv, a))
+                assert_almost_equal(linalg.det(a, nthreads=nthreads),
+                                    self.each(linalg.det, a))
+        s, l = linalg.slogdet(self.a)
+        assert_almost_equal(s*np.exp(l), self.each(linalg.det, self.a))
+
+    def test_solve(self):
+        a, b = self.a, self.b
+        assert_almost_equal(linalg.solve(a, b, nthreads=2),
+                            self.each(linalg.solve, a, b))
+        assert_almost_equal(linalg.solve(a, b[..., 0]),
+                            self.each(linalg.solve, a, b[..., 0]))
+        # a single matrix broadcasts against the stack of right hand sides
+        assert_almost_equal(linalg.solve(a[0, 0], b),
+                    [[linalg.solve(a[0, 0], y) for y in x] for x in b])
+
+    def test_noncontiguous(self):
+        a = np.repeat(self.a, 2, axis=-1)[..., ::2]
+        assert_almost_equal(linalg.inv(a), self.each(linalg.inv, a))
+
+    def test_cholesky_eigh(self):
+        h = self.h
+        assert_almost_equal(linalg.cholesky(h, nthreads=2),
+                            self.each(linalg.cholesky, h))
+        for uplo in ('L', 'U'):
+            w, v = linalg.eigh(h, uplo)
+            assert_almost_equal(w, self.each(linalg.eigvalsh, h))
+            assert_almost_equal(np.einsum('...ij,...j,...kj', v, w, v.conj()),
+                                h)
+
+    def test_svd(self):
+        for a in (self.a, self.a[..., :3], self.a[..., :3, :]):
+            k = min(a.shape[-2:])
+            assert_almost_equal(linalg.svd(a, compute_uv=0, nthreads=2),
+                                self.each(lambda x: linalg.svd(x, 0, 0), a))
+            for full_matrices in (1, 0):
+                u, s, vt = linalg.svd(a, full_matrices)
+                assert_almost_equal(np.einsum('...ij,...j,...jk', u[..., :k],
+                                              s, vt[..., :k, :]), a)
+
+    def test_singular(self):
+        a = self.a.real.copy()
+        a[1, 0] = 0
+        for nthreads in (1, 2):
+            self.assertRaises(linalg.LinAlgError, linalg.inv, a,
+                              nthreads=nthreads)
+            self.assertRaises(linalg.LinAlgError, linalg.cholesky, a)
+            d = linalg.det(a, nthreads=nthreads)
+            assert_equal(d[1, 0], 0)
+            assert_(np.all(d[0] != 0))
+        # the error state of the user is left alone
+        old = np.seterr(invalid='ignore')
+        try:
+            self.assertRaises(linalg.LinAlgError, linalg.inv, a)
+            assert_equal(np.geterr()['invalid'], 'ignore')
+        finally:
+            np.seterr(**old)
+
+    def test_bad_shape(self):
+        self.assertRaises(linalg.LinAlgError, linalg.inv, self.a[..., :3])
+        self.assertRaises(linalg.LinAlgError, linalg.solve, self.a,
+                          self.b[..., :3, :])
+
+    def test_empty(self):
+        for shape in ((0, 3, 3), (2, 0, 0)):
+            a = np.zeros(shape)
+            for f in (linalg.inv, linalg.det, linalg.slogdet, linalg.cholesky,
+                      linalg.eigh, linalg.svd):
+                self.assertRaises(linalg.LinAlgError, f, a)
+            self.assertRaises(linalg.LinAlgError, linalg.solve, a,
+                              np.zeros(shape[:-1]))
+
+
 if __name__ == "__main__":
     run_module_suite()
@@ -8,6 +8,7 @@ Utility functions
 ==============================================================================
 random               Uniformly distributed values of a given shape.
 bytes                Uniformly distributed random bytes.
+choice               Random sample from a given 1-D array.
 random_integers      Uniformly distributed integers in a given range.
 random_sample        Uniformly distributed floats in a given range.
 permutation          Randomly permute a sequence / generate a random sequence.
@@ -8,6 +8,7 @@ Utility functions
 ==============================================================================
 random               Uniformly distributed values of a given shape.
 bytes                Uniformly distributed random bytes.
+choice               Random sample from a given 1-D array.
 random_integers      Uniformly distributed integers in a given range.
 random_sample        Uniformly distributed floats in a given range.
 permutation          Randomly permute a sequence / generate a random sequence.
@@ -62,6 +63,7 @@ Multivariate distributions
 dirichlet            Multivariate generalization of Beta distribution.
 multinomial          Multivariate generalization of the binomial distribution.
 multivariate_normal  Multivariate generalization of the normal distribution.
+MultivariateNormal   Multivariate normal distribution, for repeated sampling.
 ==================== =========================================================
 
 ==================== =========================================================
@@ -89,6 +91,7 @@ __all__ = [
     'beta',
     'binomial',
     'bytes',
+    'choice',
     'chisquare',
     'exponential',
     'f',
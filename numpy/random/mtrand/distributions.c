@@ -43,6 +43,7 @@
 
 #include <math.h>
 #include "distributions.h"
+#include "ziggurat.h"
 #include <stdio.h>
 
 #ifndef min
@@ -120,21 +121,251 @@ double rk_uniform(rk_state *state, double loc, double scale)
     return loc + scale*rk_double(state);
 }
 
-double rk_standard_gamma(rk_state *state, double shape)
+/*
+ * The ziggurat samplers take the layer from the top 8 bits of one value,
+ * and a 52 bit integer j, as an exact double, from the rest of it and the
+ * next value. The tables are in ziggurat.h. For single precision, j has
+ * only the 23 low bits of the one value, scaled to 52 bits.
+ *
+ * Every draw takes the same number of values, either for j or for a
+ * uniform double, and every sample needs at least one more draw. The values
+ * for n samples are therefore fetched n draws at a time with
+ * rk_fill_uint32, which never takes more values than n calls to the scalar
+ * sampler would.
+ */
+typedef struct {
+    rk_state *state;
+    int words;
+    unsigned int buf[512];
+    size_t pos, len;
+} zig_source;
+
+static void
+zig_init(zig_source *src, int words, rk_state *state)
+{
+    src->state = state;
+    src->words = words;
+    src->pos = src->len = 0;
+}
+
+static unsigned long
+zig_word(zig_source *src, size_t samples)
+{
+    if (src->pos == src->len) {
+        src->len = src->words*samples < 512 ? src->words*samples : 512;
+        src->pos = 0;
+        rk_fill_uint32(src->buf, src->len, src->state);
+    }
+    return src->buf[src->pos++];
+}
+
+/* The integer j of a draw, with the layer and sign in hi */
+static double
+zig_draw(zig_source *src, size_t samples, unsigned long *hi)
+{
+    *hi = zig_word(src, samples);
+    if (src->words == 1) {
+        return (long)(*hi & 0x7fffffUL)*536870912.0;
+    }
+    return (long)(*hi & 0xfffffUL)*4294967296.0 + (long)zig_word(src, samples);
+}
+
+/* A uniform double in [0, 1), as rk_double or rk_float would draw it */
+static double
+zig_double(zig_source *src, size_t samples)
+{
+    long a, b;
+
+    if (src->words == 1) {
+        return (long)(zig_word(src, samples) >> 8)/16777216.0;
+    }
+    a = (long)(zig_word(src, samples) >> 5);
+    b = (long)(zig_word(src, samples) >> 6);
+    return (a*67108864.0 + b)/9007199254740992.0;
+}
+
+static double
+zig_gauss(zig_source *src, size_t samples)
+{
+    unsigned long hi;
+    int idx;
+    double j, x, xx, yy;
+
+    for (;;)
+    {
+        j = zig_draw(src, samples, &hi);
+        idx = (int)(hi >> 24) & 0xff;
+        /* Without a branch on the sign, which is mispredicted half the time */
+        x = (1.0 - (double)((hi >> 22) & 2))*j*rk_zig_wi[idx];
+        if (j < rk_zig_ki[idx])
+        {
+            return x;
+        }
+        if (idx == 0)
+        {
+            /* The tail beyond r, by Marsaglia's method */
+            for (;;)
+            {
+                xx = -log(1.0 - zig_double(src, samples))/RK_ZIG_NORMAL_R;
+                yy = -log(1.0 - zig_double(src, samples));
+                if (yy + yy > xx*xx)
+                {
+                    return (hi & 0x800000UL) ? -(RK_ZIG_NORMAL_R + xx)
+                                             : RK_ZIG_NORMAL_R + xx;
+                }
+            }
+        }
+        if ((rk_zig_fi[idx-1] - rk_zig_fi[idx])*zig_double(src, samples)
+                + rk_zig_fi[idx] < exp(-0.5*x*x))
+        {
+            return x;
+        }
+    }
+}
+
+static double
+zig_exponential(zig_source *src, size_t samples)
+{
+    unsigned long hi;
+    int idx;
+    double j, x;
+
+    for (;;)
+    {
+        j = zig_draw(src, samples, &hi);
+        idx = (int)(hi >> 24) & 0xff;
+        x = j*rk_zig_we[idx];
+        if (j < rk_zig_ke[idx])
+        {
+            return x;
+        }
+        if (idx == 0)
+        {
+            /* The tail is r plus a standard exponential */
+            return RK_ZIG_EXPONENTIAL_R - log(1.0 - zig_double(src, samples));
+        }
+        if ((rk_zig_fe[idx-1] - rk_zig_fe[idx])*zig_double(src, samples)
+                + rk_zig_fe[idx] < exp(-x))
+        {
+            return x;
+        }
+    }
+}
+
+void rk_fill_gauss_zig(double *out, size_t n, rk_state *state)
+{
+    zig_source src;
+    size_t i;
+
+    zig_init(&src, 2, state);
+    for (i = 0; i < n; i++)
+    {
+        out[i] = zig_gauss(&src, n - i);
+    }
+}
+
+void rk_fill_standard_exponential_zig(double *out, size_t n, rk_state *state)
+{
+    zig_source src;
+    size_t i;
+
+    zig_init(&src, 2, state);
+    for (i = 0; i < n; i++)
+    {
+        out[i] = zig_exponential(&src, n - i);
+    }
+}
+
+void rk_fill_gauss_float(float *out, size_t n, rk_state *state)
+{
+    zig_source src;
+    size_t i;
+
+    zig_init(&src, 1, state);
+    for (i = 0; i < n; i++)
+    {
+        out[i] = (float)zig_gauss(&src, n - i);
+    }
+}
+
+void rk_fill_standard_exponential_float(float *out, size_t n,
+                                        rk_state *state)
+{
+    zig_source src;
+    size_t i;
+
+    zig_init(&src, 1, state);
+    for (i = 0; i < n; i++)
+    {
+        out[i] = (float)zig_exponential(&src, n - i);
+    }
+}
+
+double rk_gauss_zig(rk_state *state)
+{
+    zig_source src;
+
+    zig_init(&src, 2, state);
+    return zig_gauss(&src, 1);
+}
+
+double rk_standard_exponential_zig(rk_state *state)
+{
+    zig_source src;
+
+    zig_init(&src, 2, state);
+    return zig_exponential(&src, 1);
+}
+
+static double gauss_float(rk_state *state)
+{
+    zig_source src;
+
+    zig_init(&src, 1, state);
+    return zig_gauss(&src, 1);
+}
+
+static double standard_exponential_float(rk_state *state)
+{
+    zig_source src;
+
+    zig_init(&src, 1, state);
+    return zig_exponential(&src, 1);
+}
+
+static double uniform_float(rk_state *state)
+{
+    return rk_float(state);
+}
+
+double rk_normal_zig(rk_state *state, double loc, double scale)
+{
+    return loc + scale*rk_gauss_zig(state);
+}
+
+double rk_exponential_zig(rk_state *state, double scale)
+{
+    return scale * rk_standard_exponential_zig(state);
+}
+
+static double standard_gamma(rk_state *state, double shape,
+                             double (*uniform)(rk_state *state),
+                             double (*gauss)(rk_state *state),
+                             double (*exponential)(rk_state *state))
 {
     double b, c;
     double U, V, X, Y;
 
     if (shape == 1.0)
     {
-        return rk_standard_exponential(state);
+        return exponential(state);
     }
     else if (shape < 1.0)
     {
         for (;;)
         {
-            U = rk_double(state);
-            V = rk_standard_exponential(state);
+            U = uniform(state);
+            V = exponential(state);
             if (U <= 1.0 - shape)
             {
                 X = pow(U, 1./shape);
@@ -162,23 +393,46 @@ double rk_standard_gamma(rk_state *state, double shape)
         {
             do
             {
-                X = rk_gauss(state); 
+                X = gauss(state);
                 V = 1.0 + c*X;
             } while (V <= 0.0);
 
             V = V*V*V;
-            U = rk_double(state);
+            U = uniform(state);
             if (U < 1.0 - 0.0331*(X*X)*(X*X)) return (b*V);
             if (log(U) < 0.5*X*X + b*(1. - V + log(V))) return (b*V);
         }
     }
 }
 
+double rk_standard_gamma(rk_state *state, double shape)
+{
+    return standard_gamma(state, shape, rk_double, rk_gauss,
+                          rk_standard_exponential);
+}
+
+double rk_standard_gamma_zig(rk_state *state, double shape)
+{
+    return standard_gamma(state, shape, rk_double, rk_gauss_zig,
+                          rk_standard_exponential_zig);
+}
+
+double rk_standard_gamma_float(rk_state *state, double shape)
+{
+    return (float)standard_gamma(state, shape, uniform_float, gauss_float,
+                                 standard_exponential_float);
+}
+
 double rk_gamma(rk_state *state, double shape, double scale)
 {
     return scale * rk_standard_gamma(state, shape);
 }
 
+double rk_gamma_zig(rk_state *state, double shape, double scale)
+{
+    return scale * rk_standard_gamma_zig(state, shape);
+}
+
 double rk_beta(rk_state *state, double a, double b)
 {
     double Ga, Gb;
@@ -45,6 +45,9 @@ extern "C" {
  * Marsaglia, G. and Tsang, W. W. A Simple Method for Generating Gamma 
  * Variables. ACM Transactions on Mathematical Software, Vol. 26, No. 3,
  * September 2000, Pages 363–372.
+ *
+ * Marsaglia, G. and Tsang, W. W. The Ziggurat Method for Generating Random
+ * Variables. Journal of Statistical Software, Vol. 5, No. 8, 2000.
  */
  
 /* Normal distribution with mean=loc and standard deviation=scale. */
@@ -57,6 +60,24 @@ extern double rk_standard_exponential(rk_state *state);
 /* Exponential distribution with mean=scale. */
 extern double rk_exponential(rk_state *state, double scale);
 
+/* Standard normal and exponential distributions by the ziggurat method of
+ * (Marsaglia and Tsang 2000), which needs no logarithm for all but about
+ * 1% of the samples. These and the functions using them draw a different
+ * stream of values than rk_gauss and rk_standard_exponential. */
+extern double rk_gauss_zig(rk_state *state);
+extern double rk_standard_exponential_zig(rk_state *state);
+extern void rk_fill_gauss_zig(double *out, size_t n, rk_state *state);
+extern void rk_fill_standard_exponential_zig(double *out, size_t n,
+                                             rk_state *state);
+
+/* Single precision standard normal and exponential samples by the ziggurat
+ * method, from one 32 bit value each but for about 1% of them. */
+extern void rk_fill_gauss_float(float *out, size_t n, rk_state *state);
+extern void rk_fill_standard_exponential_float(float *out, size_t n,
+                                               rk_state *state);
+extern double rk_normal_zig(rk_state *state, double loc, double scale);
+extern double rk_exponential_zig(rk_state *state, double scale);
+
 /* Uniform distribution on interval [loc, loc+scale). */
 extern double rk_uniform(rk_state *state, double loc, double scale);
 
@@ -71,6 +92,15 @@ extern double rk_standard_gamma(rk_state *state, double shape);
 /* Gamma distribution with shape and scale. */
 extern double rk_gamma(rk_state *state, double shape, double scale);
 
+/* The gamma distributions with the ziggurat normal and exponential
+ * samplers. */
+extern double rk_standard_gamma_zig(rk_state *state, double shape);
+
+/* A standard gamma sample rounded to single precision, made from single
+ * precision uniform, normal and exponential samples. */
+extern double rk_standard_gamma_float(rk_state *state, double shape);
+extern double rk_gamma_zig(rk_state *state, double shape, double scale);
+
 /* Beta distribution computed by combining two gamma variates (Devroye p. 432).
  */
 extern double rk_beta(rk_state *state, double a, double b);
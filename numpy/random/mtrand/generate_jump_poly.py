@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+"""Write randomkit_jump.h, the polynomial which jumps the Mersenne Twister.
+
+The characteristic polynomial phi of the MT19937 recurrence is found with
+the Berlekamp-Massey algorithm from a bit of its output. Jumping ahead by
+2**128 values is then the polynomial x**(2**128) mod phi, evaluated at the
+transition of the generator, see rk_jump in randomkit.c and
+
+    H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and P. L'Ecuyer,
+    "Efficient jump ahead for F2-linear random number generators",
+    INFORMS Journal on Computing, Vol. 20, No. 3, pp. 385-390, 2008.
+
+Polynomials over GF(2) are Python integers, bit i holding the coefficient
+of x**i.
+"""
+import sys
+
+N, M = 624, 397
+UPPER, LOWER, MATRIX_A = 0x80000000, 0x7fffffff, 0x9908b0df
+JUMP_LOG2 = 128
+
+
+def raw_words(count, seed=5489):
+    """The untempered output of MT19937 seeded with init_genrand"""
+    x = [seed]
+    for i in range(1, N):
+        x.append((1812433253 * (x[-1] ^ (x[-1] >> 30)) + i) & 0xffffffff)
+    for k in range(count):
+        y = (x[k] & UPPER) | (x[k + 1] & LOWER)
+        x.append(x[k + M] ^ (y >> 1) ^ (MATRIX_A if y & 1 else 0))
+    return x[N:]
+
+
+def parity(x):
+    return bin(x).count('1') & 1
+
+
+def berlekamp_massey(bits):
+    """The connection polynomial and linear complexity of a bit sequence"""
+    C, B, L, m, window = 1, 1, 0, 1, 0
+    for i, b in enumerate(bits):
+        window = (window << 1) | b
+        if not parity(C & window):
+            m += 1
+        elif 2 * L <= i:
+            C, B = C ^ (B << m), C
+            L = i + 1 - L
+            m = 1
+        else:
+            C ^= B << m
+            m += 1
+    return C, L
+
+
+def reduce(a, phi, degree):
+    while a.bit_length() > degree:
+        a ^= phi << (a.bit_length() - 1 - degree)
+    return a
+
+
+def square(a):
+    # Squaring over GF(2) spreads the bits out: hex digit d becomes a byte
+    spread = [int(''.join('0' + c for c in bin(d)[2:].zfill(4)), 2)
+              for d in range(16)]
+    digits = '%x' % a
+    return int(''.join('%02x' % spread[int(d, 16)] for d in digits), 16)
+
+
+def jump_polynomial():
+    bits = [w & 1 for w in raw_words(2 * 19937 + 64)]
+    C, degree = berlekamp_massey(bits)
+    if degree != 19937:
+        raise RuntimeError("unexpected linear complexity %d" % degree)
+    # The characteristic polynomial is the reverse of the connection one
+    phi = int(bin(C)[2:].zfill(degree + 1)[::-1], 2)
+    p = 2
+    for i in range(JUMP_LOG2):
+        p = reduce(square(p), phi, degree)
+    return p
+
+
+if __name__ == '__main__':
+    p = jump_polynomial()
+    words = [(p >> (32 * i)) & 0xffffffff for i in range(N)]
+    out = open('randomkit_jump.h', 'w')
+    out.write("/* x**(2**%d) mod the characteristic polynomial of MT19937, "
+              "the coefficient\n * of x**i in bit i %% 32 of word i / 32.\n"
+              " *\n * Generated by generate_jump_poly.py, do not edit.\n */\n"
+              "static const unsigned long rk_jump_poly[%d] = {\n"
+              % (JUMP_LOG2, N))
+    for i in range(0, N, 5):
+        out.write('    ' + ' '.join('0x%08xUL,' % w for w in words[i:i + 5])
+                  + '\n')
+    out.write('};\n')
+    out.close()
@@ -0,0 +1,70 @@
+#!/usr/bin/env python
+"""Write ziggurat.h, the tables of the ziggurat normal and exponential samplers.
+
+The density is covered by 256 layers of equal area: layer 0 is the base
+rectangle of width r together with the tail beyond it, and layer i > 0 is
+the rectangle of width x[i] between f(x[i]) and f(x[i-1]), with x[0] = 0
+and x[255] = r. See
+
+    G. Marsaglia and W. W. Tsang, "The ziggurat method for generating random
+    variables", Journal of Statistical Software, Vol. 5, No. 8, 2000.
+
+A sample draws a layer and a 52 bit integer j, and returns x = j*w[i] when
+j < k[i], that is, when x is inside the layer below. The tables are
+written out so that every platform draws the same values.
+"""
+from math import exp, log, sqrt
+
+LAYERS = 256
+SCALE = 2.0**52
+
+# The width of the base and the area of a layer
+NORMAL_R = 3.6541528853610088
+NORMAL_V = 4.92867323399e-3
+EXPONENTIAL_R = 7.69711747013104972
+EXPONENTIAL_V = 3.949659822581572e-3
+
+
+def tables(f, finv, r, v):
+    k, w, fx = [0.0] * LAYERS, [0.0] * LAYERS, [0.0] * LAYERS
+    q = v / f(r)
+    k[0] = float(int(r / q * SCALE))
+    k[1] = 0.0
+    w[0] = q / SCALE
+    w[LAYERS - 1] = r / SCALE
+    fx[0] = 1.0
+    fx[LAYERS - 1] = f(r)
+    x = r
+    for i in range(LAYERS - 2, 0, -1):
+        prev = x
+        x = finv(v / x + f(x))
+        k[i + 1] = float(int(x / prev * SCALE))
+        fx[i] = f(x)
+        w[i] = x / SCALE
+    return k, w, fx
+
+
+def write(out, name, values):
+    out.write('static const double %s[%d] = {\n' % (name, len(values)))
+    for i in range(0, len(values), 3):
+        out.write('    ' + ' '.join('%s,' % repr(float(v))
+                                    for v in values[i:i + 3]) + '\n')
+    out.write('};\n\n')
+
+
+if __name__ == '__main__':
+    normal = tables(lambda x: exp(-0.5 * x * x),
+                    lambda y: sqrt(-2.0 * log(y)), NORMAL_R, NORMAL_V)
+    exponential = tables(lambda x: exp(-x), lambda y: -log(y),
+                         EXPONENTIAL_R, EXPONENTIAL_V)
+    out = open('ziggurat.h', 'w')
+    out.write('/*\n * Tables of the ziggurat samplers in distributions.c.\n'
+              ' *\n * Generated by generate_ziggurat.py, do not edit.\n */\n'
+              '#define RK_ZIG_NORMAL_R %r\n#define RK_ZIG_EXPONENTIAL_R %r\n\n'
+              % (NORMAL_R, EXPONENTIAL_R))
+    for name, values in zip(['rk_zig_ki', 'rk_zig_wi', 'rk_zig_fi'], normal):
+        write(out, name, values)
+    for name, values in zip(['rk_zig_ke', 'rk_zig_we', 'rk_zig_fe'],
+                            exponential):
+        write(out, name, values)
+    out.close()
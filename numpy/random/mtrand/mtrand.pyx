@@ -36,11 +36,21 @@ cdef extern from "mtrand_py_helper.h":
 
 cdef extern from "randomkit.h":
 
+    ctypedef enum rk_brng:
+        RK_MT19937 = 0
+        RK_PHILOX = 1
+
+    ctypedef unsigned long long rk_uint64
+
     ctypedef struct rk_state:
         unsigned long key[624]
         int pos
         int has_gauss
         double gauss
+        rk_brng brng
+        unsigned int philox_key[2]
+        unsigned int philox_ctr[4]
+        int philox_pos
 
     ctypedef enum rk_error:
         RK_NOERR = 0
@@ -54,66 +64,95 @@ cdef extern from "randomkit.h":
 
     void rk_seed(unsigned long seed, rk_state *state)
     rk_error rk_randomseed(rk_state *state)
-    unsigned long rk_random(rk_state *state)
-    long rk_long(rk_state *state)
-    unsigned long rk_ulong(rk_state *state)
-    unsigned long rk_interval(unsigned long max, rk_state *state)
-    double rk_double(rk_state *state)
-    void rk_fill(void *buffer, size_t size, rk_state *state)
+    unsigned long rk_random(rk_state *state) nogil
+    long rk_long(rk_state *state) nogil
+    unsigned long rk_ulong(rk_state *state) nogil
+    unsigned long rk_interval(unsigned long max, rk_state *state) nogil
+    double rk_double(rk_state *state) nogil
+    void rk_fill(void *buffer, size_t size, rk_state *state) nogil
+    void rk_fill_uint32(unsigned int *out, size_t n, rk_state *state) nogil
+    void rk_fill_doubles(double *out, size_t n, rk_state *state) nogil
+    void rk_fill_floats(float *out, size_t n, rk_state *state) nogil
+    void rk_jump(rk_state *state) nogil
+    void rk_fill_interval(rk_uint64 off, rk_uint64 rng, void *out,
+                          size_t itemsize, size_t n, rk_state *state) nogil
+    void rk_fill_bounded(rk_uint64 off, rk_uint64 rng, void *out,
+                         size_t itemsize, size_t n, rk_state *state) nogil
+    void rk_shuffle(char *data, size_t n, npy_intp stride, size_t itemsize,
+                    char *buf, rk_state *state) nogil
     rk_error rk_devfill(void *buffer, size_t size, int strong)
     rk_error rk_altfill(void *buffer, size_t size, int strong,
             rk_state *state)
-    double rk_gauss(rk_state *state)
+    double rk_gauss(rk_state *state) nogil
+    void rk_philox_seed(unsigned int *key, unsigned int *stream,
+                        rk_state *state)
+    void rk_philox_advance(unsigned int *delta, rk_state *state)
+    void rk_philox_fill(unsigned int *out, size_t n, rk_state *state) nogil
 
 cdef extern from "distributions.h":
 
-    double rk_normal(rk_state *state, double loc, double scale)
-    double rk_standard_exponential(rk_state *state)
-    double rk_exponential(rk_state *state, double scale)
-    double rk_uniform(rk_state *state, double loc, double scale)
-    double rk_standard_gamma(rk_state *state, double shape)
-    double rk_gamma(rk_state *state, double shape, double scale)
-    double rk_beta(rk_state *state, double a, double b)
-    double rk_chisquare(rk_state *state, double df)
-    double rk_noncentral_chisquare(rk_state *state, double df, double nonc)
-    double rk_f(rk_state *state, double dfnum, double dfden)
-    double rk_noncentral_f(rk_state *state, double dfnum, double dfden, double nonc)
-    double rk_standard_cauchy(rk_state *state)
-    double rk_standard_t(rk_state *state, double df)
-    double rk_vonmises(rk_state *state, double mu, double kappa)
-    double rk_pareto(rk_state *state, double a)
-    double rk_weibull(rk_state *state, double a)
-    double rk_power(rk_state *state, double a)
-    double rk_laplace(rk_state *state, double loc, double scale)
-    double rk_gumbel(rk_state *state, double loc, double scale)
-    double rk_logistic(rk_state *state, double loc, double scale)
-    double rk_lognormal(rk_state *state, double mode, double sigma)
-    double rk_rayleigh(rk_state *state, double mode)
-    double rk_wald(rk_state *state, double mean, double scale)
-    double rk_triangular(rk_state *state, double left, double mode, double right)
-
-    long rk_binomial(rk_state *state, long n, double p)
-    long rk_binomial_btpe(rk_state *state, long n, double p)
-    long rk_binomial_inversion(rk_state *state, long n, double p)
-    long rk_negative_binomial(rk_state *state, double n, double p)
-    long rk_poisson(rk_state *state, double lam)
-    long rk_poisson_mult(rk_state *state, double lam)
-    long rk_poisson_ptrs(rk_state *state, double lam)
-    long rk_zipf(rk_state *state, double a)
-    long rk_geometric(rk_state *state, double p)
-    long rk_hypergeometric(rk_state *state, long good, long bad, long sample)
-    long rk_logseries(rk_state *state, double p)
-
-ctypedef double (* rk_cont0)(rk_state *state)
-ctypedef double (* rk_cont1)(rk_state *state, double a)
-ctypedef double (* rk_cont2)(rk_state *state, double a, double b)
-ctypedef double (* rk_cont3)(rk_state *state, double a, double b, double c)
-
-ctypedef long (* rk_disc0)(rk_state *state)
-ctypedef long (* rk_discnp)(rk_state *state, long n, double p)
-ctypedef long (* rk_discdd)(rk_state *state, double n, double p)
-ctypedef long (* rk_discnmN)(rk_state *state, long n, long m, long N)
-ctypedef long (* rk_discd)(rk_state *state, double a)
+    double rk_normal(rk_state *state, double loc, double scale) nogil
+    double rk_standard_exponential(rk_state *state) nogil
+    double rk_exponential(rk_state *state, double scale) nogil
+    double rk_uniform(rk_state *state, double loc, double scale) nogil
+    double rk_standard_gamma(rk_state *state, double shape) nogil
+    double rk_gamma(rk_state *state, double shape, double scale) nogil
+    double rk_gauss_zig(rk_state *state) nogil
+    double rk_normal_zig(rk_state *state, double loc, double scale) nogil
+    double rk_standard_exponential_zig(rk_state *state) nogil
+    double rk_exponential_zig(rk_state *state, double scale) nogil
+    double rk_standard_gamma_zig(rk_state *state, double shape) nogil
+    double rk_gamma_zig(rk_state *state, double shape, double scale) nogil
+    void rk_fill_gauss_zig(double *out, size_t n, rk_state *state) nogil
+    void rk_fill_standard_exponential_zig(double *out, size_t n,
+                                          rk_state *state) nogil
+    void rk_fill_gauss_float(float *out, size_t n, rk_state *state) nogil
+    void rk_fill_standard_exponential_float(float *out, size_t n,
+                                            rk_state *state) nogil
+    double rk_standard_gamma_float(rk_state *state, double shape) nogil
+    double rk_beta(rk_state *state, double a, double b) nogil
+    double rk_chisquare(rk_state *state, double df) nogil
+    double rk_noncentral_chisquare(rk_state *state, double df, double nonc) nogil
+    double rk_f(rk_state *state, double dfnum, double dfden) nogil
+    double rk_noncentral_f(rk_state *state, double dfnum, double dfden, double nonc) nogil
+    double rk_standard_cauchy(rk_state *state) nogil
+    double rk_standard_t(rk_state *state, double df) nogil
+    double rk_vonmises(rk_state *state, double mu, double kappa) nogil
+    double rk_pareto(rk_state *state, double a) nogil
+    double rk_weibull(rk_state *state, double a) nogil
+    double rk_power(rk_state *state, double a) nogil
+    double rk_laplace(rk_state *state, double loc, double scale) nogil
+    double rk_gumbel(rk_state *state, double loc, double scale) nogil
+    double rk_logistic(rk_state *state, double loc, double scale) nogil
+    double rk_lognormal(rk_state *state, double mode, double sigma) nogil
+    double rk_rayleigh(rk_state *state, double mode) nogil
+    double rk_wald(rk_state *state, double mean, double scale) nogil
+    double rk_triangular(rk_state *state, double left, double mode, double right) nogil
+
+    long rk_binomial(rk_state *state, long n, double p) nogil
+    long rk_binomial_btpe(rk_state *state, long n, double p) nogil
+    long rk_binomial_inversion(rk_state *state, long n, double p) nogil
+    long rk_negative_binomial(rk_state *state, double n, double p) nogil
+    long rk_poisson(rk_state *state, double lam) nogil
+    long rk_poisson_mult(rk_state *state, double lam) nogil
+    long rk_poisson_ptrs(rk_state *state, double lam) nogil
+    long rk_zipf(rk_state *state, double a) nogil
+    long rk_geometric(rk_state *state, double p) nogil
+    long rk_hypergeometric(rk_state *state, long good, long bad, long sample) nogil
+    long rk_logseries(rk_state *state, double p) nogil
+
+ctypedef double (* rk_cont0)(rk_state *state) nogil
+ctypedef void (* rk_fill0)(double *out, size_t n, rk_state *state) nogil
+ctypedef void (* rk_fillf)(float *out, size_t n, rk_state *state) nogil
+ctypedef double (* rk_cont1)(rk_state *state, double a) nogil
+ctypedef double (* rk_cont2)(rk_state *state, double a, double b) nogil
+ctypedef double (* rk_cont3)(rk_state *state, double a, double b, double c) nogil
+
+ctypedef long (* rk_disc0)(rk_state *state) nogil
+ctypedef long (* rk_discnp)(rk_state *state, long n, double p) nogil
+ctypedef long (* rk_discdd)(rk_state *state, double n, double p) nogil
+ctypedef long (* rk_discnmN)(rk_state *state, long n, long m, long N) nogil
+ctypedef long (* rk_discd)(rk_state *state, double a) nogil
 
 
 cdef extern from "initarray.h":
@@ -124,41 +163,180 @@ cdef extern from "initarray.h":
 import_array()
 
 import numpy as np
+import operator
+try:
+    from threading import Lock
+except ImportError:
+    from dummy_threading import Lock
+
+cdef object cont0_array(rk_state *state, rk_cont0 func, object size, object lock):
+    cdef double *array_data
+    cdef ndarray array "arrayObject"
+    cdef long length
+    cdef long i
+
+    if size is None:
+        with lock:
+            return func(state)
+    else:
+        array = <ndarray>np.empty(size, np.float64)
+        length = PyArray_SIZE(array)
+        array_data = <double *>array.data
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state)
+        return array
 
-cdef object cont0_array(rk_state *state, rk_cont0 func, object size):
+
+cdef object fill_array_sc(rk_state *state, rk_cont0 func, rk_fill0 fill,
+                          object size, double loc, double scale, object lock):
+    # The values of loc + scale*func, with the array filled by fill
     cdef double *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state)
+        with lock:
+            return loc + scale*func(state)
     else:
         array = <ndarray>np.empty(size, np.float64)
         length = PyArray_SIZE(array)
         array_data = <double *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state)
+        with lock:
+            with nogil:
+                fill(array_data, length, state)
+        if loc != 0.0 or scale != 1.0:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = loc + scale*array_data[i]
         return array
 
 
-cdef object cont1_array_sc(rk_state *state, rk_cont1 func, object size, double a):
+cdef int ziggurat(object method) except -1:
+    if method is None:
+        return 0
+    if method == 'ziggurat':
+        return 1
+    raise ValueError("method must be None or 'ziggurat'")
+
+
+cdef int lemire(object method) except -1:
+    if method is None:
+        return 0
+    if method == 'lemire':
+        return 1
+    raise ValueError("method must be None or 'lemire'")
+
+
+cdef npy_intp row_bytes(ndarray arr):
+    # The size of the rows along the first axis of arr, or -1 when they are
+    # not contiguous blocks of memory
+    cdef npy_intp size = arr.descr.elsize
+    cdef int k
+    for k from arr.nd > k >= 1:
+        if arr.dimensions[k] != 1 and arr.strides[k] != size:
+            return -1
+        size = size * arr.dimensions[k]
+    return size
+
+
+cdef object shuffle_rows(rk_state *state, ndarray arr, npy_intp size,
+                         object lock):
+    # Shuffle the rows of arr in place, which are blocks of size bytes
+    cdef ndarray buf = <ndarray>np.empty(size, np.uint8)
+    cdef char *data = arr.data
+    cdef char *buf_data = buf.data
+    cdef npy_intp n = arr.dimensions[0], stride = arr.strides[0]
+
+    if arr.dtype.hasobject:
+        # Swapping the references keeps their counts, but other threads
+        # must not see the array meanwhile
+        with lock:
+            rk_shuffle(data, n, stride, size, buf_data, state)
+    else:
+        with lock:
+            with nogil:
+                rk_shuffle(data, n, stride, size, buf_data, state)
+
+
+cdef int is_float32(object dtype) except -1:
+    dtype = np.dtype(dtype)
+    if dtype == np.float64:
+        return 0
+    if dtype == np.float32:
+        return 1
+    raise ValueError("dtype must be float64 or float32")
+
+
+cdef object float_fill_array(rk_state *state, rk_fillf fill, object size,
+                             object lock):
+    # Single precision samples, a float32 scalar if size is None
+    cdef ndarray array "arrayObject"
+    cdef npy_intp length
+
+    if size is None:
+        array = <ndarray>np.empty((), np.float32)
+    else:
+        array = <ndarray>np.empty(size, np.float32)
+    length = PyArray_SIZE(array)
+    with lock:
+        with nogil:
+            fill(<float *>array.data, length, state)
+    if size is None:
+        return array[()]
+    return array
+
+
+cdef object cont1_float_array(rk_state *state, rk_cont1 func, object size,
+                              ndarray oa, object lock):
+    # The values of func rounded to single precision
+    cdef float *array_data
+    cdef double *oa_data
+    cdef ndarray array "arrayObject"
+    cdef npy_intp i
+    cdef broadcast multi
+
+    if size is None:
+        array = <ndarray>PyArray_SimpleNew(oa.nd, oa.dimensions, NPY_FLOAT)
+    else:
+        array = <ndarray>np.empty(size, np.float32)
+    array_data = <float *>array.data
+    multi = <broadcast>PyArray_MultiIterNew(2, <void *>array, <void *>oa)
+    if (multi.size != PyArray_SIZE(array)):
+        raise ValueError("size is not compatible with inputs")
+    with lock:
+        with nogil:
+            for i from 0 <= i < multi.size:
+                oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                array_data[i] = <float>func(state, oa_data[0])
+                PyArray_MultiIter_NEXTi(multi, 1)
+    if size is None and oa.nd == 0:
+        return array[()]
+    return array
+
+
+cdef object cont1_array_sc(rk_state *state, rk_cont1 func, object size, double a, object lock):
     cdef double *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, a)
+        with lock:
+            return func(state, a)
     else:
         array = <ndarray>np.empty(size, np.float64)
         length = PyArray_SIZE(array)
         array_data = <double *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, a)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, a)
         return array
 
-cdef object cont1_array(rk_state *state, rk_cont1 func, object size, ndarray oa):
+cdef object cont1_array(rk_state *state, rk_cont1 func, object size, ndarray oa, object lock):
     cdef double *array_data
     cdef double *oa_data
     cdef ndarray array "arrayObject"
@@ -172,9 +350,11 @@ cdef object cont1_array(rk_state *state, rk_cont1 func, object size, ndarray oa)
         length = PyArray_SIZE(array)
         array_data = <double *>array.data
         itera = <flatiter>PyArray_IterNew(<object>oa)
-        for i from 0 <= i < length:
-            array_data[i] = func(state, (<double *>(itera.dataptr))[0])
-            PyArray_ITER_NEXT(itera)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, (<double *>(itera.dataptr))[0])
+                    PyArray_ITER_NEXT(itera)
     else:
         array = <ndarray>np.empty(size, np.float64)
         array_data = <double *>array.data
@@ -182,32 +362,37 @@ cdef object cont1_array(rk_state *state, rk_cont1 func, object size, ndarray oa)
                                                 <void *>oa)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            array_data[i] = func(state, oa_data[0])
-            PyArray_MultiIter_NEXTi(multi, 1)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    array_data[i] = func(state, oa_data[0])
+                    PyArray_MultiIter_NEXTi(multi, 1)
     return array
 
 cdef object cont2_array_sc(rk_state *state, rk_cont2 func, object size, double a,
-                           double b):
+                           double b, object lock):
     cdef double *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, a, b)
+        with lock:
+            return func(state, a, b)
     else:
         array = <ndarray>np.empty(size, np.float64)
         length = PyArray_SIZE(array)
         array_data = <double *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, a, b)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, a, b)
         return array
 
 
 cdef object cont2_array(rk_state *state, rk_cont2 func, object size,
-                        ndarray oa, ndarray ob):
+                        ndarray oa, ndarray ob, object lock):
     cdef double *array_data
     cdef double *oa_data
     cdef double *ob_data
@@ -220,27 +405,31 @@ cdef object cont2_array(rk_state *state, rk_cont2 func, object size,
         multi = <broadcast> PyArray_MultiIterNew(2, <void *>oa, <void *>ob)
         array = <ndarray> PyArray_SimpleNew(multi.nd, multi.dimensions, NPY_DOUBLE)
         array_data = <double *>array.data
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 0)
-            ob_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            array_data[i] = func(state, oa_data[0], ob_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 0)
+                    ob_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    array_data[i] = func(state, oa_data[0], ob_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     else:
         array = <ndarray>np.empty(size, np.float64)
         array_data = <double *>array.data
         multi = <broadcast>PyArray_MultiIterNew(3, <void*>array, <void *>oa, <void *>ob)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            ob_data = <double *>PyArray_MultiIter_DATA(multi, 2)
-            array_data[i] = func(state, oa_data[0], ob_data[0])
-            PyArray_MultiIter_NEXTi(multi, 1)
-            PyArray_MultiIter_NEXTi(multi, 2)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    ob_data = <double *>PyArray_MultiIter_DATA(multi, 2)
+                    array_data[i] = func(state, oa_data[0], ob_data[0])
+                    PyArray_MultiIter_NEXTi(multi, 1)
+                    PyArray_MultiIter_NEXTi(multi, 2)
     return array
 
 cdef object cont3_array_sc(rk_state *state, rk_cont3 func, object size, double a,
-                           double b, double c):
+                           double b, double c, object lock):
 
     cdef double *array_data
     cdef ndarray array "arrayObject"
@@ -248,17 +437,20 @@ cdef object cont3_array_sc(rk_state *state, rk_cont3 func, object size, double a
     cdef long i
 
     if size is None:
-        return func(state, a, b, c)
+        with lock:
+            return func(state, a, b, c)
     else:
         array = <ndarray>np.empty(size, np.float64)
         length = PyArray_SIZE(array)
         array_data = <double *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, a, b, c)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, a, b, c)
         return array
 
 cdef object cont3_array(rk_state *state, rk_cont3 func, object size, ndarray oa,
-    ndarray ob, ndarray oc):
+    ndarray ob, ndarray oc, object lock):
 
     cdef double *array_data
     cdef double *oa_data
@@ -273,12 +465,14 @@ cdef object cont3_array(rk_state *state, rk_cont3 func, object size, ndarray oa,
         multi = <broadcast> PyArray_MultiIterNew(3, <void *>oa, <void *>ob, <void *>oc)
         array = <ndarray> PyArray_SimpleNew(multi.nd, multi.dimensions, NPY_DOUBLE)
         array_data = <double *>array.data
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 0)
-            ob_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            oc_data = <double *>PyArray_MultiIter_DATA(multi, 2)
-            array_data[i] = func(state, oa_data[0], ob_data[0], oc_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 0)
+                    ob_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    oc_data = <double *>PyArray_MultiIter_DATA(multi, 2)
+                    array_data[i] = func(state, oa_data[0], ob_data[0], oc_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     else:
         array = <ndarray>np.empty(size, np.float64)
         array_data = <double *>array.data
@@ -286,47 +480,55 @@ cdef object cont3_array(rk_state *state, rk_cont3 func, object size, ndarray oa,
                                                 <void *>ob, <void *>oc)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            ob_data = <double *>PyArray_MultiIter_DATA(multi, 2)
-            oc_data = <double *>PyArray_MultiIter_DATA(multi, 3)
-            array_data[i] = func(state, oa_data[0], ob_data[0], oc_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    ob_data = <double *>PyArray_MultiIter_DATA(multi, 2)
+                    oc_data = <double *>PyArray_MultiIter_DATA(multi, 3)
+                    array_data[i] = func(state, oa_data[0], ob_data[0], oc_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     return array
 
-cdef object disc0_array(rk_state *state, rk_disc0 func, object size):
+cdef object disc0_array(rk_state *state, rk_disc0 func, object size, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state)
+        with lock:
+            return func(state)
     else:
         array = <ndarray>np.empty(size, int)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state)
         return array
 
-cdef object discnp_array_sc(rk_state *state, rk_discnp func, object size, long n, double p):
+cdef object discnp_array_sc(rk_state *state, rk_discnp func, object size, long n, double p, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, n, p)
+        with lock:
+            return func(state, n, p)
     else:
         array = <ndarray>np.empty(size, int)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, n, p)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, n, p)
         return array
 
-cdef object discnp_array(rk_state *state, rk_discnp func, object size, ndarray on, ndarray op):
+cdef object discnp_array(rk_state *state, rk_discnp func, object size, ndarray on, ndarray op, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef npy_intp length
@@ -339,43 +541,50 @@ cdef object discnp_array(rk_state *state, rk_discnp func, object size, ndarray o
         multi = <broadcast> PyArray_MultiIterNew(2, <void *>on, <void *>op)
         array = <ndarray> PyArray_SimpleNew(multi.nd, multi.dimensions, NPY_LONG)
         array_data = <long *>array.data
-        for i from 0 <= i < multi.size:
-            on_data = <long *>PyArray_MultiIter_DATA(multi, 0)
-            op_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            array_data[i] = func(state, on_data[0], op_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <long *>PyArray_MultiIter_DATA(multi, 0)
+                    op_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    array_data[i] = func(state, on_data[0], op_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     else:
         array = <ndarray>np.empty(size, int)
         array_data = <long *>array.data
         multi = <broadcast>PyArray_MultiIterNew(3, <void*>array, <void *>on, <void *>op)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            on_data = <long *>PyArray_MultiIter_DATA(multi, 1)
-            op_data = <double *>PyArray_MultiIter_DATA(multi, 2)
-            array_data[i] = func(state, on_data[0], op_data[0])
-            PyArray_MultiIter_NEXTi(multi, 1)
-            PyArray_MultiIter_NEXTi(multi, 2)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <long *>PyArray_MultiIter_DATA(multi, 1)
+                    op_data = <double *>PyArray_MultiIter_DATA(multi, 2)
+                    array_data[i] = func(state, on_data[0], op_data[0])
+                    PyArray_MultiIter_NEXTi(multi, 1)
+                    PyArray_MultiIter_NEXTi(multi, 2)
 
     return array
 
-cdef object discdd_array_sc(rk_state *state, rk_discdd func, object size, double n, double p):
+cdef object discdd_array_sc(rk_state *state, rk_discdd func, object size, double n, double p, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, n, p)
+        with lock:
+            return func(state, n, p)
     else:
         array = <ndarray>np.empty(size, int)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, n, p)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, n, p)
         return array
 
-cdef object discdd_array(rk_state *state, rk_discdd func, object size, ndarray on, ndarray op):
+cdef object discdd_array(rk_state *state, rk_discdd func, object size, ndarray on, ndarray op, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef npy_intp length
@@ -388,45 +597,52 @@ cdef object discdd_array(rk_state *state, rk_discdd func, object size, ndarray o
         multi = <broadcast> PyArray_MultiIterNew(2, <void *>on, <void *>op)
         array = <ndarray> PyArray_SimpleNew(multi.nd, multi.dimensions, NPY_LONG)
         array_data = <long *>array.data
-        for i from 0 <= i < multi.size:
-            on_data = <double *>PyArray_MultiIter_DATA(multi, 0)
-            op_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            array_data[i] = func(state, on_data[0], op_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <double *>PyArray_MultiIter_DATA(multi, 0)
+                    op_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    array_data[i] = func(state, on_data[0], op_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     else:
         array = <ndarray>np.empty(size, int)
         array_data = <long *>array.data
         multi = <broadcast>PyArray_MultiIterNew(3, <void*>array, <void *>on, <void *>op)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            on_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            op_data = <double *>PyArray_MultiIter_DATA(multi, 2)
-            array_data[i] = func(state, on_data[0], op_data[0])
-            PyArray_MultiIter_NEXTi(multi, 1)
-            PyArray_MultiIter_NEXTi(multi, 2)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    op_data = <double *>PyArray_MultiIter_DATA(multi, 2)
+                    array_data[i] = func(state, on_data[0], op_data[0])
+                    PyArray_MultiIter_NEXTi(multi, 1)
+                    PyArray_MultiIter_NEXTi(multi, 2)
 
     return array
 
 cdef object discnmN_array_sc(rk_state *state, rk_discnmN func, object size,
-    long n, long m, long N):
+    long n, long m, long N, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, n, m, N)
+        with lock:
+            return func(state, n, m, N)
     else:
         array = <ndarray>np.empty(size, int)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, n, m, N)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, n, m, N)
         return array
 
 cdef object discnmN_array(rk_state *state, rk_discnmN func, object size,
-    ndarray on, ndarray om, ndarray oN):
+    ndarray on, ndarray om, ndarray oN, object lock):
     cdef long *array_data
     cdef long *on_data
     cdef long *om_data
@@ -440,12 +656,14 @@ cdef object discnmN_array(rk_state *state, rk_discnmN func, object size,
         multi = <broadcast> PyArray_MultiIterNew(3, <void *>on, <void *>om, <void *>oN)
         array = <ndarray> PyArray_SimpleNew(multi.nd, multi.dimensions, NPY_LONG)
         array_data = <long *>array.data
-        for i from 0 <= i < multi.size:
-            on_data = <long *>PyArray_MultiIter_DATA(multi, 0)
-            om_data = <long *>PyArray_MultiIter_DATA(multi, 1)
-            oN_data = <long *>PyArray_MultiIter_DATA(multi, 2)
-            array_data[i] = func(state, on_data[0], om_data[0], oN_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <long *>PyArray_MultiIter_DATA(multi, 0)
+                    om_data = <long *>PyArray_MultiIter_DATA(multi, 1)
+                    oN_data = <long *>PyArray_MultiIter_DATA(multi, 2)
+                    array_data[i] = func(state, on_data[0], om_data[0], oN_data[0])
+                    PyArray_MultiIter_NEXT(multi)
     else:
         array = <ndarray>np.empty(size, int)
         array_data = <long *>array.data
@@ -453,32 +671,37 @@ cdef object discnmN_array(rk_state *state, rk_discnmN func, object size,
                                                 <void *>oN)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            on_data = <long *>PyArray_MultiIter_DATA(multi, 1)
-            om_data = <long *>PyArray_MultiIter_DATA(multi, 2)
-            oN_data = <long *>PyArray_MultiIter_DATA(multi, 3)
-            array_data[i] = func(state, on_data[0], om_data[0], oN_data[0])
-            PyArray_MultiIter_NEXT(multi)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    on_data = <long *>PyArray_MultiIter_DATA(multi, 1)
+                    om_data = <long *>PyArray_MultiIter_DATA(multi, 2)
+                    oN_data = <long *>PyArray_MultiIter_DATA(multi, 3)
+                    array_data[i] = func(state, on_data[0], om_data[0], oN_data[0])
+                    PyArray_MultiIter_NEXT(multi)
 
     return array
 
-cdef object discd_array_sc(rk_state *state, rk_discd func, object size, double a):
+cdef object discd_array_sc(rk_state *state, rk_discd func, object size, double a, object lock):
     cdef long *array_data
     cdef ndarray array "arrayObject"
     cdef long length
     cdef long i
 
     if size is None:
-        return func(state, a)
+        with lock:
+            return func(state, a)
     else:
         array = <ndarray>np.empty(size, int)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
-        for i from 0 <= i < length:
-            array_data[i] = func(state, a)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, a)
         return array
 
-cdef object discd_array(rk_state *state, rk_discd func, object size, ndarray oa):
+cdef object discd_array(rk_state *state, rk_discd func, object size, ndarray oa, object lock):
     cdef long *array_data
     cdef double *oa_data
     cdef ndarray array "arrayObject"
@@ -492,19 +715,23 @@ cdef object discd_array(rk_state *state, rk_discd func, object size, ndarray oa)
         length = PyArray_SIZE(array)
         array_data = <long *>array.data
         itera = <flatiter>PyArray_IterNew(<object>oa)
-        for i from 0 <= i < length:
-            array_data[i] = func(state, (<double *>(itera.dataptr))[0])
-            PyArray_ITER_NEXT(itera)
+        with lock:
+            with nogil:
+                for i from 0 <= i < length:
+                    array_data[i] = func(state, (<double *>(itera.dataptr))[0])
+                    PyArray_ITER_NEXT(itera)
     else:
         array = <ndarray>np.empty(size, int)
         array_data = <long *>array.data
         multi = <broadcast>PyArray_MultiIterNew(2, <void *>array, <void *>oa)
         if (multi.size != PyArray_SIZE(array)):
             raise ValueError("size is not compatible with inputs")
-        for i from 0 <= i < multi.size:
-            oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
-            array_data[i] = func(state, oa_data[0])
-            PyArray_MultiIter_NEXTi(multi, 1)
+        with lock:
+            with nogil:
+                for i from 0 <= i < multi.size:
+                    oa_data = <double *>PyArray_MultiIter_DATA(multi, 1)
+                    array_data[i] = func(state, oa_data[0])
+                    PyArray_MultiIter_NEXTi(multi, 1)
     return array
 
 cdef double kahan_sum(double *darr, long n):
@@ -542,6 +769,16 @@ cdef class RandomState:
         If `seed` is ``None``, then `RandomState` will try to read data from
         ``/dev/urandom`` (or the Windows analogue) if available or seed from
         the clock otherwise.
+    brng : {'MT19937', 'Philox'}, optional
+        The generator of random bits. 'MT19937' (the default) is the
+        Mersenne Twister. 'Philox' is the Philox4x32-10 counter-based
+        generator, which provides independent streams and can skip ahead
+        any number of values in constant time, see `advance`.
+    stream : int, optional
+        For 'Philox', the stream to draw from, between 0 and 2**64 - 1.
+        Generators with the same seed and different streams produce
+        independent sequences, so that parallel workers can each use the
+        stream of their index.
 
     Notes
     -----
@@ -551,23 +788,31 @@ cdef class RandomState:
     NumPy-aware, has the advantage that it provides a much larger number
     of probability distributions to choose from.
 
+    Arrays of random values are filled without holding the GIL, so that
+    separate `RandomState` instances can be used concurrently from several
+    threads. Each instance has a lock protecting its state, so that an
+    instance shared between threads gives each call a consecutive part of
+    its stream.
+
     """
     cdef rk_state *internal_state
+    cdef object lock
     poisson_lam_max = np.iinfo('l').max - np.sqrt(np.iinfo('l').max)*10
 
-    def __init__(self, seed=None):
+    def __init__(self, seed=None, brng='MT19937', stream=0):
         self.internal_state = <rk_state*>PyMem_Malloc(sizeof(rk_state))
+        self.lock = Lock()
 
-        self.seed(seed)
+        self.seed(seed, brng, stream)
 
     def __dealloc__(self):
         if self.internal_state != NULL:
             PyMem_Free(self.internal_state)
             self.internal_state = NULL
 
-    def seed(self, seed=None):
+    def seed(self, seed=None, brng=None, stream=0):
         """
-        seed(seed=None)
+        seed(seed=None, brng=None, stream=0)
 
         Seed the generator.
 
@@ -578,6 +823,11 @@ cdef class RandomState:
         ----------
         seed : int or array_like, optional
             Seed for `RandomState`.
+        brng : {None, 'MT19937', 'Philox'}, optional
+            The generator of random bits. By default the current one is
+            kept.
+        stream : int, optional
+            The stream of the 'Philox' generator.
 
         See Also
         --------
@@ -586,17 +836,145 @@ cdef class RandomState:
         """
         cdef rk_error errcode
         cdef ndarray obj "arrayObject_obj"
+        if brng is None:
+            if self.internal_state.brng == RK_PHILOX:
+                brng = 'Philox'
+            else:
+                brng = 'MT19937'
+        if brng == 'Philox':
+            self._seed_philox(seed, stream)
+            return
+        if brng != 'MT19937':
+            raise ValueError("brng must be 'MT19937' or 'Philox'")
+        if stream != 0:
+            raise ValueError("streams are only supported by 'Philox'")
         if seed is None:
-            errcode = rk_randomseed(self.internal_state)
+            with self.lock:
+                errcode = rk_randomseed(self.internal_state)
         elif type(seed) is int:
-            rk_seed(seed, self.internal_state)
+            with self.lock:
+                rk_seed(seed, self.internal_state)
         elif isinstance(seed, np.integer):
             iseed = int(seed)
-            rk_seed(iseed, self.internal_state)
+            with self.lock:
+                rk_seed(iseed, self.internal_state)
         else:
             obj = <ndarray>PyArray_ContiguousFromObject(seed, NPY_LONG, 1, 1)
-            init_by_array(self.internal_state, <unsigned long *>(obj.data),
-                obj.dimensions[0])
+            with self.lock:
+                init_by_array(self.internal_state, <unsigned long *>(obj.data),
+                    obj.dimensions[0])
+
+    def _seed_philox(self, seed, stream):
+        cdef rk_state mt
+        cdef ndarray obj "arrayObject_obj"
+        cdef unsigned int key[2], words[2]
+
+        stream = int(stream)
+        if not 0 <= stream < 2**64:
+            raise ValueError("stream must be between 0 and 2**64 - 1")
+        if seed is not None and (type(seed) is int or type(seed) is long or
+                                 isinstance(seed, np.integer)):
+            seed = int(seed)
+            if not 0 <= seed < 2**64:
+                raise ValueError("seed must be between 0 and 2**64 - 1")
+            key[0] = seed & 0xffffffff
+            key[1] = seed >> 32
+        else:
+            # Derive the key from the Mersenne Twister seeded the usual way
+            if seed is None:
+                rk_randomseed(&mt)
+            else:
+                obj = <ndarray>PyArray_ContiguousFromObject(seed, NPY_LONG, 1, 1)
+                init_by_array(&mt, <unsigned long *>(obj.data),
+                    obj.dimensions[0])
+            key[0] = rk_random(&mt)
+            key[1] = rk_random(&mt)
+        words[0] = stream & 0xffffffff
+        words[1] = stream >> 32
+        with self.lock:
+            rk_philox_seed(key, words, self.internal_state)
+
+    def advance(self, n):
+        """
+        advance(n)
+
+        Skip the next `n` random values of the generator, in constant time.
+
+        Only the 'Philox' generator can be advanced. A value is 32 random
+        bits; a double, as returned by `random_sample`, takes two of them.
+
+        Parameters
+        ----------
+        n : int
+            The number of values to skip, less than 2**128.
+
+        Examples
+        --------
+        >>> a = np.random.RandomState(12, brng='Philox')
+        >>> b = np.random.RandomState(12, brng='Philox')
+        >>> x = a.random_sample(5)
+        >>> b.advance(10)
+        >>> b.random_sample() == a.random_sample()
+        True
+
+        """
+        cdef unsigned int delta[4]
+        cdef int i
+        if self.internal_state.brng != RK_PHILOX:
+            raise ValueError("only the 'Philox' generator can be advanced")
+        n = int(n)
+        if not 0 <= n < 2**128:
+            raise ValueError("n must be between 0 and 2**128 - 1")
+        for i from 0 <= i < 4:
+            delta[i] = n & 0xffffffff
+            n = n >> 32
+        with self.lock:
+            rk_philox_advance(delta, self.internal_state)
+
+    def jumped(self, jumps=1):
+        """
+        jumped(jumps=1)
+
+        Return a copy of the generator, jumped ahead by ``jumps * 2**128``
+        values.
+
+        Generators jumped from the same state by different numbers of jumps
+        draw from parts of its sequence which do not overlap, unless more
+        than 2**128 values are drawn, so that parallel workers can use the
+        Mersenne Twister reproducibly. A jump takes about as long as drawing
+        20000 values. For the 'Philox' generator, use separate streams
+        instead.
+
+        Parameters
+        ----------
+        jumps : int, optional
+            The number of jumps of 2**128 values.
+
+        Returns
+        -------
+        out : RandomState
+            A new generator.
+
+        Examples
+        --------
+        >>> base = np.random.RandomState(1234)
+        >>> workers = [base.jumped(i) for i in range(1, 5)]
+
+        """
+        cdef RandomState other
+        cdef long i, n
+        if self.internal_state.brng == RK_PHILOX:
+            raise ValueError("only the 'MT19937' generator can be jumped")
+        n = jumps
+        if n < 0:
+            raise ValueError("jumps must be non-negative")
+        other = RandomState(0)
+        other.set_state(self.get_state())
+        with other.lock:
+            with nogil:
+                for i from 0 <= i < n:
+                    rk_jump(other.internal_state)
+        return other
 
     def get_state(self):
         """
@@ -617,6 +995,10 @@ cdef class RandomState:
             4. an integer ``has_gauss``.
             5. a float ``cached_gaussian``.
 
+            For the 'Philox' generator, the tuple is ('Philox', key,
+            counter, pos, has_gauss, cached_gaussian), with the key as 2
+            and the counter as 4 unsigned 32 bit integers.
+
         See Also
         --------
         set_state
@@ -629,11 +1011,27 @@ cdef class RandomState:
 
         """
         cdef ndarray state "arrayObject_state"
+        if self.internal_state.brng == RK_PHILOX:
+            with self.lock:
+                key = np.array([self.internal_state.philox_key[0],
+                                self.internal_state.philox_key[1]], np.uint32)
+                ctr = np.array([self.internal_state.philox_ctr[0],
+                                self.internal_state.philox_ctr[1],
+                                self.internal_state.philox_ctr[2],
+                                self.internal_state.philox_ctr[3]], np.uint32)
+                state_tuple = ('Philox', key, ctr,
+                               self.internal_state.philox_pos,
+                               self.internal_state.has_gauss,
+                               self.internal_state.gauss)
+            return state_tuple
         state = <ndarray>np.empty(624, np.uint)
-        memcpy(<void*>(state.data), <void*>(self.internal_state.key), 624*sizeof(long))
+        with self.lock:
+            memcpy(<void*>(state.data), <void*>(self.internal_state.key), 624*sizeof(long))
+            has_gauss = self.internal_state.has_gauss
+            gauss = self.internal_state.gauss
+            pos = self.internal_state.pos
         state = <ndarray>np.asarray(state, np.uint32)
-        return ('MT19937', state, self.internal_state.pos,
-            self.internal_state.has_gauss, self.internal_state.gauss)
+        return ('MT19937', state, pos, has_gauss, gauss)
 
     def set_state(self, state):
         """
@@ -685,8 +1083,11 @@ cdef class RandomState:
         cdef ndarray obj "arrayObject_obj"
         cdef int pos
         algorithm_name = state[0]
+        if algorithm_name == 'Philox':
+            self._set_philox_state(state)
+            return
         if algorithm_name != 'MT19937':
-            raise ValueError("algorithm must be 'MT19937'")
+            raise ValueError("algorithm must be 'MT19937' or 'Philox'")
         key, pos = state[1:3]
         if len(state) == 3:
             has_gauss = 0
@@ -700,10 +1101,37 @@ cdef class RandomState:
             obj = <ndarray>PyArray_ContiguousFromObject(key, NPY_LONG, 1, 1)
         if obj.dimensions[0] != 624:
             raise ValueError("state must be 624 longs")
-        memcpy(<void*>(self.internal_state.key), <void*>(obj.data), 624*sizeof(long))
-        self.internal_state.pos = pos
-        self.internal_state.has_gauss = has_gauss
-        self.internal_state.gauss = cached_gaussian
+        with self.lock:
+            memcpy(<void*>(self.internal_state.key), <void*>(obj.data), 624*sizeof(long))
+            self.internal_state.pos = pos
+            self.internal_state.has_gauss = has_gauss
+            self.internal_state.gauss = cached_gaussian
+            self.internal_state.brng = RK_MT19937
+
+    def _set_philox_state(self, state):
+        cdef unsigned int zero[4]
+        cdef int i
+        key, ctr, pos, has_gauss, cached_gaussian = state[1:6]
+        key = np.asarray(key, np.uint32)
+        ctr = np.asarray(ctr, np.uint32)
+        if key.shape != (2,) or ctr.shape != (4,):
+            raise ValueError("a Philox state has a key of 2 and a counter "
+                             "of 4 unsigned 32 bit integers")
+        if not 0 <= pos <= 4:
+            raise ValueError("pos must be between 0 and 4")
+        for i from 0 <= i < 4:
+            zero[i] = 0
+        with self.lock:
+            self.internal_state.brng = RK_PHILOX
+            for i from 0 <= i < 2:
+                self.internal_state.philox_key[i] = key[i]
+            for i from 0 <= i < 4:
+                self.internal_state.philox_ctr[i] = ctr[i]
+            self.internal_state.philox_pos = pos
+            # Compute the block of the counter
+            rk_philox_advance(zero, self.internal_state)
+            self.internal_state.has_gauss = has_gauss
+            self.internal_state.gauss = cached_gaussian
 
     # Pickling support:
     def __getstate__(self):
@@ -716,9 +1144,9 @@ cdef class RandomState:
         return (np.random.__RandomState_ctor, (), self.get_state())
 
     # Basic distributions:
-    def random_sample(self, size=None):
+    def random_sample(self, size=None, dtype=np.float64):
         """
-        random_sample(size=None)
+        random_sample(size=None, dtype=np.float64)
 
         Return random floats in the half-open interval [0.0, 1.0).
 
@@ -733,6 +1161,9 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Defines the shape of the returned array of random floats. If None
             (the default), returns a single float.
+        dtype : {float64, float32}, optional
+            The type of the result. float32 samples are made from 24 random
+            bits each, and take half the values of the generator.
 
         Returns
         -------
@@ -757,7 +1188,11 @@ cdef class RandomState:
                [-1.23204345, -1.75224494]])
 
         """
-        return cont0_array(self.internal_state, rk_double, size)
+        if is_float32(dtype):
+            return float_fill_array(self.internal_state, rk_fill_floats, size,
+                                    self.lock)
+        return fill_array_sc(self.internal_state, rk_double, rk_fill_doubles,
+                             size, 0.0, 1.0, self.lock)
 
     def tomaxint(self, size=None):
         """
@@ -804,11 +1239,11 @@ cdef class RandomState:
                 [ True,  True]]], dtype=bool)
 
         """
-        return disc0_array(self.internal_state, rk_long, size)
+        return disc0_array(self.internal_state, rk_long, size, self.lock)
 
-    def randint(self, low, high=None, size=None):
+    def randint(self, low, high=None, size=None, dtype=int, method=None):
         """
-        randint(low, high=None, size=None)
+        randint(low, high=None, size=None, dtype=int, method=None)
 
         Return random integers from `low` (inclusive) to `high` (exclusive).
 
@@ -828,6 +1263,14 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Output shape. Default is None, in which case a single int is
             returned.
+        dtype : integer dtype, optional
+            The type of the result, of 8 to 64 bits, signed or unsigned.
+            `low` and `high` - 1 must be within its range.
+        method : {None, 'lemire'}, optional
+            None, the default, masks random words to the bit length of the
+            range and rejects the values beyond it. 'lemire' maps random
+            words to the range with a multiplication and rarely rejects one,
+            see Notes.
 
         Returns
         -------
@@ -842,6 +1285,21 @@ cdef class RandomState:
             omitted. In particular, this other one is the one to use to generate
             uniformly distributed discrete non-integers.
 
+        Notes
+        -----
+        With ``method='lemire'``, a random word x of b bits gives the value
+        ``(x * s) >> b`` for a range of s values, unless the low b bits of
+        the product are below ``(2**b - s) % s`` [1]_. Ranges of fewer than
+        2**8 or 2**16 values take four or two values from each 32 bit word.
+        This draws different values than the default method for the same
+        seed, and is several times as fast for small ranges.
+
+        References
+        ----------
+        .. [1] D. Lemire, "Fast random integer generation in an interval",
+               ACM Transactions on Modeling and Computer Simulation, Vol. 29,
+               No. 1, 2019.
+
         Examples
         --------
         >>> np.random.randint(2, size=10)
@@ -855,36 +1313,65 @@ cdef class RandomState:
         array([[4, 0, 2, 1],
                [3, 2, 2, 0]])
 
+        Generate a million bytes between 0 and 9, inclusive:
+
+        >>> np.random.randint(10, size=10**6, dtype=np.uint8, method='lemire')
+        array([3, 9, 0, ..., 5, 1, 7], dtype=uint8)
+
         """
         cdef long lo, hi, rv
         cdef unsigned long diff
-        cdef long *array_data
+        cdef rk_uint64 off, rng
         cdef ndarray array "arrayObject"
-        cdef long length
-        cdef long i
+        cdef void *array_data
+        cdef size_t itemsize, length
+        cdef int bounded = lemire(method)
 
         if high is None:
-            lo = 0
-            hi = low
-        else:
+            low, high = 0, low
+        dtype = np.dtype(dtype)
+        if dtype.kind not in 'iu':
+            raise ValueError("dtype must be an integer type")
+
+        if size is None and not bounded and dtype == np.dtype(int):
             lo = low
             hi = high
+            if lo >= hi :
+                raise ValueError("low >= high")
+            diff = <unsigned long>hi - <unsigned long>lo - 1UL
+            with self.lock:
+                rv = lo + <long>rk_interval(diff, self. internal_state)
+            return rv
 
-        if lo >= hi :
+        low, high = int(low), int(high)
+        if low >= high:
             raise ValueError("low >= high")
+        if low < np.iinfo(dtype).min:
+            raise ValueError("low is out of bounds for %s" % dtype)
+        if high - 1 > np.iinfo(dtype).max:
+            raise ValueError("high is out of bounds for %s" % dtype)
+        # The values are off plus [0, rng], modulo 2**64 and the items
+        off = low % 2**64
+        rng = high - low - 1
 
-        diff = <unsigned long>hi - <unsigned long>lo - 1UL
         if size is None:
-            rv = lo + <long>rk_interval(diff, self. internal_state)
-            return rv
+            array = <ndarray>np.empty((), dtype)
         else:
-            array = <ndarray>np.empty(size, int)
-            length = PyArray_SIZE(array)
-            array_data = <long *>array.data
-            for i from 0 <= i < length:
-                rv = lo + <long>rk_interval(diff, self. internal_state)
-                array_data[i] = rv
-            return array
+            array = <ndarray>np.empty(size, dtype)
+        length = PyArray_SIZE(array)
+        array_data = <void *>array.data
+        itemsize = array.descr.elsize
+        with self.lock:
+            with nogil:
+                if bounded:
+                    rk_fill_bounded(off, rng, array_data, itemsize, length,
+                                    self.internal_state)
+                else:
+                    rk_fill_interval(off, rng, array_data, itemsize, length,
+                                     self.internal_state)
+        if size is None:
+            return array[()]
+        return array
 
     def bytes(self, unsigned int length):
         """
@@ -910,9 +1397,270 @@ cdef class RandomState:
         """
         cdef void *bytes
         bytestring = empty_py_bytes(length, &bytes)
-        rk_fill(bytes, length, self.internal_state)
+        with self.lock:
+            with nogil:
+                rk_fill(bytes, length, self.internal_state)
         return bytestring
 
+    def choice(self, a, size=None, replace=True, p=None):
+        """
+        choice(a, size=None, replace=True, p=None)
+
+        Generates a random sample from a given 1-D array.
+
+        Parameters
+        ----------
+        a : 1-D array-like or int
+            If an ndarray, a random sample is generated from its elements.
+            If an int, the random sample is generated as if a was
+            ``np.arange(a)``.
+        size : int or tuple of ints, optional
+            Shape of the output. If None (the default), a single value is
+            returned.
+        replace : boolean, optional
+            Whether the sample is with or without replacement.
+        p : 1-D array-like, optional
+            The probabilities associated with each entry in a. If not given
+            the sample assumes a uniform distribution over all entries in a.
+
+        Returns
+        -------
+        samples : 1-D ndarray, shape (size,)
+            The generated random samples.
+
+        Raises
+        ------
+        ValueError
+            If a is an int and less than zero, if a or p are not
+            1-dimensional, if a is an array-like of size 0, if p is not a
+            vector of probabilities, if a and p have different lengths, or if
+            replace=False and the sample size is greater than the population
+            size.
+
+        See Also
+        --------
+        randint, shuffle, permutation
+
+        Notes
+        -----
+        Weighted samples with replacement are drawn from an alias table
+        [1]_, built once in O(n) time, which takes two random values per
+        sample whatever the number of entries. Small samples without
+        replacement from a large population are drawn with Floyd's algorithm
+        [2]_, which takes time and memory in proportion to the sample and not
+        to the population, and weighted samples without replacement by
+        sorting exponential keys [3]_, which is equivalent to drawing the
+        entries one by one.
+
+        References
+        ----------
+        .. [1] M. D. Vose, "A linear algorithm for generating random numbers
+               with a given distribution", IEEE Transactions on Software
+               Engineering, Vol. 17, No. 9, pp. 972-975, 1991.
+        .. [2] J. Bentley and B. Floyd, "Programming pearls: a sample of
+               brilliance", Communications of the ACM, Vol. 30, No. 9,
+               pp. 754-757, 1987.
+        .. [3] P. S. Efraimidis and P. G. Spirakis, "Weighted random sampling
+               with a reservoir", Information Processing Letters, Vol. 97,
+               No. 5, pp. 181-185, 2006.
+
+        Examples
+        --------
+        Generate a uniform random sample from np.arange(5) of size 3:
+
+        >>> np.random.choice(5, 3)
+        array([0, 3, 4])
+        >>> #This is equivalent to np.random.randint(0,5,3)
+
+        Generate a non-uniform random sample from np.arange(5) of size 3:
+
+        >>> np.random.choice(5, 3, p=[0.1, 0, 0.3, 0.6, 0])
+        array([3, 3, 0])
+
+        Generate a uniform random sample from np.arange(5) of size 3 without
+        replacement:
+
+        >>> np.random.choice(5, 3, replace=False)
+        array([3,1,0])
+        >>> #This is equivalent to np.random.permutation(np.arange(5))[:3]
+
+        Any of the above can be repeated with an arbitrary array-like
+        instead of just integers. For instance:
+
+        >>> aa_milne_arr = ['pooh', 'rabbit', 'piglet', 'Christopher']
+        >>> np.random.choice(aa_milne_arr, 5, p=[0.5, 0.1, 0.1, 0.3])
+        array(['pooh', 'pooh', 'pooh', 'Christopher', 'piglet'],
+              dtype='|S11')
+
+        """
+        cdef long n, k, i, j, t, m, mask, slot
+        cdef long *idx_data
+        cdef long *alias_data
+        cdef long *work_data
+        cdef double *prob_data
+        cdef ndarray idx, prob, alias, work
+
+        # Format and verify input
+        pop = None
+        if isinstance(a, (int, long, np.integer)):
+            n = a
+            if n <= 0:
+                raise ValueError("a must be greater than 0")
+        else:
+            pop = np.array(a, copy=False)
+            if pop.ndim == 0:
+                # A 0-d integer array is a population size, like an int
+                n = operator.index(pop.item())
+                if n <= 0:
+                    raise ValueError("a must be greater than 0")
+                pop = None
+            elif pop.ndim != 1:
+                raise ValueError("a must be 1-dimensional")
+            else:
+                n = pop.shape[0]
+                if n == 0:
+                    raise ValueError("a must be non-empty")
+        if p is not None:
+            prob = <ndarray>np.array(p, np.float64, ndmin=1)
+            if prob.ndim != 1:
+                raise ValueError("p must be 1-dimensional")
+            if prob.shape[0] != n:
+                raise ValueError("a and p must have same size")
+            if not np.isfinite(prob).all():
+                raise ValueError("probabilities are not finite")
+            if np.any(prob < 0):
+                raise ValueError("probabilities are not non-negative")
+            if abs(prob.sum() - 1) > np.sqrt(np.finfo(np.float64).eps):
+                raise ValueError("probabilities do not sum to 1")
+
+        if size is None:
+            idx = <ndarray>np.empty((), int)
+        else:
+            idx = <ndarray>np.empty(size, int)
+        k = PyArray_SIZE(idx)
+        idx_data = <long *>idx.data
+
+        if replace:
+            if p is None:
+                with self.lock:
+                    with nogil:
+                        rk_fill_interval(0, n - 1, idx_data, sizeof(long), k,
+                                         self.internal_state)
+            else:
+                # Vose's alias table: entry i is i with probability
+                # prob[i] and alias[i] otherwise
+                prob = <ndarray>(prob * n)
+                alias = <ndarray>np.arange(n)
+                work = <ndarray>np.empty(n, int)
+                prob_data = <double *>prob.data
+                alias_data = <long *>alias.data
+                work_data = <long *>work.data
+                with nogil:
+                    # The small entries from the front, the large ones from
+                    # the back of work
+                    j = 0
+                    m = n
+                    for i from 0 <= i < n:
+                        if prob_data[i] < 1.0:
+                            work_data[j] = i
+                            j = j + 1
+                        else:
+                            m = m - 1
+                            work_data[m] = i
+                    while j > 0 and m < n:
+                        j = j - 1
+                        t = work_data[j]
+                        alias_data[t] = work_data[m]
+                        prob_data[work_data[m]] = (prob_data[work_data[m]] +
+                                                   prob_data[t] - 1.0)
+                        if prob_data[work_data[m]] < 1.0:
+                            work_data[j] = work_data[m]
+                            j = j + 1
+                            m = m + 1
+                    # The rest differ from 1 by rounding only
+                    for i from 0 <= i < j:
+                        prob_data[work_data[i]] = 1.0
+                    for i from m <= i < n:
+                        prob_data[work_data[i]] = 1.0
+                with self.lock:
+                    with nogil:
+                        for i from 0 <= i < k:
+                            t = rk_interval(n - 1, self.internal_state)
+                            if rk_double(self.internal_state) < prob_data[t]:
+                                idx_data[i] = t
+                            else:
+                                idx_data[i] = alias_data[t]
+        else:
+            if k > n:
+                raise ValueError("Cannot take a larger sample than "
+                                 "population when 'replace=False'")
+            if p is not None:
+                if np.count_nonzero(prob) < k:
+                    raise ValueError("Fewer non-zero entries in p than size")
+                # The entries with the smallest exponential keys, in order
+                keys = self.standard_exponential(n)
+                nonzero = prob > 0
+                keys[nonzero] /= prob[nonzero]
+                keys[~nonzero] = np.inf
+                idx.flat[:] = keys.argsort()[:k]
+            elif k * 32 < n:
+                # Floyd's algorithm, with an open addressing hash set of
+                # the sample, which is then shuffled
+                m = 4
+                while m < 2 * k:
+                    m = m * 2
+                mask = m - 1
+                work = <ndarray>np.empty(m, int)
+                work_data = <long *>work.data
+                with self.lock:
+                    with nogil:
+                        for i from 0 <= i < m:
+                            work_data[i] = -1
+                        for i from 0 <= i < k:
+                            j = n - k + i
+                            t = rk_interval(j, self.internal_state)
+                            slot = <long>((<unsigned long>t *
+                                           2654435761UL) & mask)
+                            while (work_data[slot] != -1 and
+                                   work_data[slot] != t):
+                                slot = (slot + 1) & mask
+                            if work_data[slot] == t:
+                                # t is taken, but j is new
+                                t = j
+                                slot = <long>((<unsigned long>t *
+                                               2654435761UL) & mask)
+                                while work_data[slot] != -1:
+                                    slot = (slot + 1) & mask
+                            work_data[slot] = t
+                            idx_data[i] = t
+                        i = k - 1
+                        while i > 0:
+                            j = rk_interval(i, self.internal_state)
+                            t = idx_data[i]
+                            idx_data[i] = idx_data[j]
+                            idx_data[j] = t
+                            i = i - 1
+            else:
+                # A Fisher-Yates shuffle of the first k entries only
+                work = <ndarray>np.arange(n)
+                work_data = <long *>work.data
+                with self.lock:
+                    with nogil:
+                        for i from 0 <= i < k:
+                            j = i + rk_interval(n - 1 - i, self.internal_state)
+                            t = work_data[j]
+                            work_data[j] = work_data[i]
+                            work_data[i] = t
+                            idx_data[i] = t
+
+        if pop is not None:
+            if size is None:
+                return pop[idx[()]]
+            return pop[idx]
+        if size is None:
+            return idx[()]
+        return idx
+
     def uniform(self, low=0.0, high=1.0, size=None):
         """
         uniform(low=0.0, high=1.0, size=1)
@@ -990,7 +1738,9 @@ cdef class RandomState:
         flow = PyFloat_AsDouble(low)
         fhigh = PyFloat_AsDouble(high)
         if not PyErr_Occurred():
-            return cont2_array_sc(self.internal_state, rk_uniform, size, flow, fhigh-flow)
+            return fill_array_sc(self.internal_state, rk_double,
+                                 rk_fill_doubles, size, flow, fhigh-flow,
+                                 self.lock)
         PyErr_Clear()
         olow = <ndarray>PyArray_FROM_OTF(low, NPY_DOUBLE, NPY_ALIGNED)
         ohigh = <ndarray>PyArray_FROM_OTF(high, NPY_DOUBLE, NPY_ALIGNED)
@@ -998,7 +1748,7 @@ cdef class RandomState:
         Py_INCREF(temp) # needed to get around Pyrex's automatic reference-counting
                         #  rules because EnsureArray steals a reference
         odiff = <ndarray>PyArray_EnsureArray(temp)
-        return cont2_array(self.internal_state, rk_uniform, size, olow, odiff)
+        return cont2_array(self.internal_state, rk_uniform, size, olow, odiff, self.lock)
 
     def rand(self, *args):
         """
@@ -1177,9 +1927,9 @@ cdef class RandomState:
         return self.randint(low, high+1, size)
 
     # Complicated, continuous distributions:
-    def standard_normal(self, size=None):
+    def standard_normal(self, size=None, method=None, dtype=np.float64):
         """
-        standard_normal(size=None)
+        standard_normal(size=None, method=None, dtype=np.float64)
 
         Returns samples from a Standard Normal distribution (mean=0, stdev=1).
 
@@ -1188,6 +1938,14 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Output shape. Default is None, in which case a single value is
             returned.
+        method : {None, 'ziggurat'}, optional
+            None (the default) uses the polar Box-Muller method, which draws
+            the same samples as earlier versions. 'ziggurat' uses the faster
+            ziggurat method, which draws a different stream of samples.
+        dtype : {float64, float32}, optional
+            The type of the result. float32 samples are always drawn by the
+            ziggurat method, all but about 1% of them from a single 32 bit
+            value of the generator.
 
         Returns
         -------
@@ -1207,11 +1965,18 @@ cdef class RandomState:
         (3, 4, 2)
 
         """
-        return cont0_array(self.internal_state, rk_gauss, size)
-
-    def normal(self, loc=0.0, scale=1.0, size=None):
+        zig = ziggurat(method)
+        if is_float32(dtype):
+            return float_fill_array(self.internal_state, rk_fill_gauss_float,
+                                    size, self.lock)
+        if zig:
+            return fill_array_sc(self.internal_state, rk_gauss_zig,
+                                 rk_fill_gauss_zig, size, 0.0, 1.0, self.lock)
+        return cont0_array(self.internal_state, rk_gauss, size, self.lock)
+
+    def normal(self, loc=0.0, scale=1.0, size=None, method=None):
         """
-        normal(loc=0.0, scale=1.0, size=None)
+        normal(loc=0.0, scale=1.0, size=None, method=None)
 
         Draw random samples from a normal (Gaussian) distribution.
 
@@ -1234,6 +1999,10 @@ cdef class RandomState:
         size : tuple of ints
             Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
             ``m * n * k`` samples are drawn.
+        method : {None, 'ziggurat'}, optional
+            None (the default) uses the polar Box-Muller method, which draws
+            the same samples as earlier versions. 'ziggurat' uses the faster
+            ziggurat method, which draws a different stream of samples.
 
         See Also
         --------
@@ -1293,13 +2062,19 @@ cdef class RandomState:
         """
         cdef ndarray oloc, oscale
         cdef double floc, fscale
+        cdef int zig
 
+        zig = ziggurat(method)
         floc = PyFloat_AsDouble(loc)
         fscale = PyFloat_AsDouble(scale)
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_normal, size, floc, fscale)
+            if zig:
+                return fill_array_sc(self.internal_state, rk_gauss_zig,
+                                     rk_fill_gauss_zig, size, floc, fscale,
+                                     self.lock)
+            return cont2_array_sc(self.internal_state, rk_normal, size, floc, fscale, self.lock)
 
         PyErr_Clear()
 
@@ -1307,7 +2082,10 @@ cdef class RandomState:
         oscale = <ndarray>PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_normal, size, oloc, oscale)
+        if zig:
+            return cont2_array(self.internal_state, rk_normal_zig, size, oloc,
+                               oscale, self.lock)
+        return cont2_array(self.internal_state, rk_normal, size, oloc, oscale, self.lock)
 
     def beta(self, a, b, size=None):
         """
@@ -1356,7 +2134,7 @@ cdef class RandomState:
                 raise ValueError("a <= 0")
             if fb <= 0:
                 raise ValueError("b <= 0")
-            return cont2_array_sc(self.internal_state, rk_beta, size, fa, fb)
+            return cont2_array_sc(self.internal_state, rk_beta, size, fa, fb, self.lock)
 
         PyErr_Clear()
 
@@ -1366,11 +2144,11 @@ cdef class RandomState:
             raise ValueError("a <= 0")
         if np.any(np.less_equal(ob, 0)):
             raise ValueError("b <= 0")
-        return cont2_array(self.internal_state, rk_beta, size, oa, ob)
+        return cont2_array(self.internal_state, rk_beta, size, oa, ob, self.lock)
 
-    def exponential(self, scale=1.0, size=None):
+    def exponential(self, scale=1.0, size=None, method=None):
         """
-        exponential(scale=1.0, size=None)
+        exponential(scale=1.0, size=None, method=None)
 
         Exponential distribution.
 
@@ -1395,6 +2173,10 @@ cdef class RandomState:
         size : tuple of ints
             Number of samples to draw.  The output is shaped
             according to `size`.
+        method : {None, 'ziggurat'}, optional
+            None (the default) inverts the distribution function, which draws
+            the same samples as earlier versions. 'ziggurat' uses the faster
+            ziggurat method, which draws a different stream of samples.
 
         References
         ----------
@@ -1408,23 +2190,33 @@ cdef class RandomState:
         """
         cdef ndarray oscale
         cdef double fscale
+        cdef int zig
 
+        zig = ziggurat(method)
         fscale = PyFloat_AsDouble(scale)
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont1_array_sc(self.internal_state, rk_exponential, size, fscale)
+            if zig:
+                return fill_array_sc(self.internal_state,
+                                     rk_standard_exponential_zig,
+                                     rk_fill_standard_exponential_zig, size,
+                                     0.0, fscale, self.lock)
+            return cont1_array_sc(self.internal_state, rk_exponential, size, fscale, self.lock)
 
         PyErr_Clear()
 
         oscale = <ndarray> PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont1_array(self.internal_state, rk_exponential, size, oscale)
+        if zig:
+            return cont1_array(self.internal_state, rk_exponential_zig, size,
+                               oscale, self.lock)
+        return cont1_array(self.internal_state, rk_exponential, size, oscale, self.lock)
 
-    def standard_exponential(self, size=None):
+    def standard_exponential(self, size=None, method=None, dtype=np.float64):
         """
-        standard_exponential(size=None)
+        standard_exponential(size=None, method=None, dtype=np.float64)
 
         Draw samples from the standard exponential distribution.
 
@@ -1435,6 +2227,14 @@ cdef class RandomState:
         ----------
         size : int or tuple of ints
             Shape of the output.
+        method : {None, 'ziggurat'}, optional
+            None (the default) inverts the distribution function, which draws
+            the same samples as earlier versions. 'ziggurat' uses the faster
+            ziggurat method, which draws a different stream of samples.
+        dtype : {float64, float32}, optional
+            The type of the result. float32 samples are always drawn by the
+            ziggurat method, all but about 1% of them from a single 32 bit
+            value of the generator.
 
         Returns
         -------
@@ -1448,11 +2248,21 @@ cdef class RandomState:
         >>> n = np.random.standard_exponential((3, 8000))
 
         """
-        return cont0_array(self.internal_state, rk_standard_exponential, size)
-
-    def standard_gamma(self, shape, size=None):
+        zig = ziggurat(method)
+        if is_float32(dtype):
+            return float_fill_array(self.internal_state,
+                                    rk_fill_standard_exponential_float, size,
+                                    self.lock)
+        if zig:
+            return fill_array_sc(self.internal_state,
+                                 rk_standard_exponential_zig,
+                                 rk_fill_standard_exponential_zig, size, 0.0,
+                                 1.0, self.lock)
+        return cont0_array(self.internal_state, rk_standard_exponential, size, self.lock)
+
+    def standard_gamma(self, shape, size=None, method=None, dtype=np.float64):
         """
-        standard_gamma(shape, size=None)
+        standard_gamma(shape, size=None, method=None, dtype=np.float64)
 
         Draw samples from a Standard Gamma distribution.
 
@@ -1466,6 +2276,12 @@ cdef class RandomState:
         size : int or tuple of ints
             Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
             ``m * n * k`` samples are drawn.
+        method : {None, 'ziggurat'}, optional
+            The method of the normal and exponential samples the gamma
+            samples are made from, see `standard_normal`.
+        dtype : {float64, float32}, optional
+            The type of the result. float32 samples are made from single
+            precision uniform, normal and exponential samples.
 
         Returns
         -------
@@ -1519,22 +2335,33 @@ cdef class RandomState:
         """
         cdef ndarray oshape
         cdef double fshape
-
+        cdef rk_cont1 func
+
+        func = rk_standard_gamma
+        if ziggurat(method):
+            func = rk_standard_gamma_zig
+        if is_float32(dtype):
+            oshape = <ndarray>PyArray_FROM_OTF(shape, NPY_DOUBLE, NPY_ALIGNED)
+            if np.any(np.less_equal(oshape, 0.0)):
+                raise ValueError("shape <= 0")
+            return cont1_float_array(self.internal_state,
+                                     rk_standard_gamma_float, size, oshape,
+                                     self.lock)
         fshape = PyFloat_AsDouble(shape)
         if not PyErr_Occurred():
             if fshape <= 0:
                 raise ValueError("shape <= 0")
-            return cont1_array_sc(self.internal_state, rk_standard_gamma, size, fshape)
+            return cont1_array_sc(self.internal_state, func, size, fshape, self.lock)
 
         PyErr_Clear()
         oshape = <ndarray> PyArray_FROM_OTF(shape, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oshape, 0.0)):
             raise ValueError("shape <= 0")
-        return cont1_array(self.internal_state, rk_standard_gamma, size, oshape)
+        return cont1_array(self.internal_state, func, size, oshape, self.lock)
 
-    def gamma(self, shape, scale=1.0, size=None):
+    def gamma(self, shape, scale=1.0, size=None, method=None):
         """
-        gamma(shape, scale=1.0, size=None)
+        gamma(shape, scale=1.0, size=None, method=None)
 
         Draw samples from a Gamma distribution.
 
@@ -1551,6 +2378,9 @@ cdef class RandomState:
         size : shape_tuple, optional
             Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
             ``m * n * k`` samples are drawn.
+        method : {None, 'ziggurat'}, optional
+            The method of the normal and exponential samples the gamma
+            samples are made from, see `standard_normal`.
 
         Returns
         -------
@@ -1604,7 +2434,11 @@ cdef class RandomState:
         """
         cdef ndarray oshape, oscale
         cdef double fshape, fscale
+        cdef rk_cont2 func
 
+        func = rk_gamma
+        if ziggurat(method):
+            func = rk_gamma_zig
         fshape = PyFloat_AsDouble(shape)
         fscale = PyFloat_AsDouble(scale)
         if not PyErr_Occurred():
@@ -1612,7 +2446,7 @@ cdef class RandomState:
                 raise ValueError("shape <= 0")
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_gamma, size, fshape, fscale)
+            return cont2_array_sc(self.internal_state, func, size, fshape, fscale, self.lock)
 
         PyErr_Clear()
         oshape = <ndarray>PyArray_FROM_OTF(shape, NPY_DOUBLE, NPY_ALIGNED)
@@ -1621,7 +2455,7 @@ cdef class RandomState:
             raise ValueError("shape <= 0")
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_gamma, size, oshape, oscale)
+        return cont2_array(self.internal_state, func, size, oshape, oscale, self.lock)
 
     def f(self, dfnum, dfden, size=None):
         """
@@ -1714,7 +2548,7 @@ cdef class RandomState:
                 raise ValueError("shape <= 0")
             if fdfden <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_f, size, fdfnum, fdfden)
+            return cont2_array_sc(self.internal_state, rk_f, size, fdfnum, fdfden, self.lock)
 
         PyErr_Clear()
 
@@ -1724,7 +2558,7 @@ cdef class RandomState:
             raise ValueError("dfnum <= 0")
         if np.any(np.less_equal(odfden, 0.0)):
             raise ValueError("dfden <= 0")
-        return cont2_array(self.internal_state, rk_f, size, odfnum, odfden)
+        return cont2_array(self.internal_state, rk_f, size, odfnum, odfden, self.lock)
 
     def noncentral_f(self, dfnum, dfden, nonc, size=None):
         """
@@ -1804,7 +2638,7 @@ cdef class RandomState:
             if fnonc < 0:
                 raise ValueError("nonc < 0")
             return cont3_array_sc(self.internal_state, rk_noncentral_f, size,
-                                  fdfnum, fdfden, fnonc)
+                                  fdfnum, fdfden, fnonc, self.lock)
 
         PyErr_Clear()
 
@@ -1819,7 +2653,7 @@ cdef class RandomState:
         if np.any(np.less(ononc, 0.0)):
             raise ValueError("nonc < 0")
         return cont3_array(self.internal_state, rk_noncentral_f, size, odfnum,
-            odfden, ononc)
+            odfden, ononc, self.lock)
 
     def chisquare(self, df, size=None):
         """
@@ -1890,14 +2724,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fdf <= 0:
                 raise ValueError("df <= 0")
-            return cont1_array_sc(self.internal_state, rk_chisquare, size, fdf)
+            return cont1_array_sc(self.internal_state, rk_chisquare, size, fdf, self.lock)
 
         PyErr_Clear()
 
         odf = <ndarray>PyArray_FROM_OTF(df, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(odf, 0.0)):
             raise ValueError("df <= 0")
-        return cont1_array(self.internal_state, rk_chisquare, size, odf)
+        return cont1_array(self.internal_state, rk_chisquare, size, odf, self.lock)
 
     def noncentral_chisquare(self, df, nonc, size=None):
         """
@@ -1978,7 +2812,7 @@ cdef class RandomState:
             if fnonc <= 0:
                 raise ValueError("nonc <= 0")
             return cont2_array_sc(self.internal_state, rk_noncentral_chisquare,
-                                  size, fdf, fnonc)
+                                  size, fdf, fnonc, self.lock)
 
         PyErr_Clear()
 
@@ -1989,7 +2823,7 @@ cdef class RandomState:
         if np.any(np.less_equal(ononc, 0.0)):
             raise ValueError("nonc < 0")
         return cont2_array(self.internal_state, rk_noncentral_chisquare, size,
-            odf, ononc)
+            odf, ononc, self.lock)
 
     def standard_cauchy(self, size=None):
         """
@@ -2050,7 +2884,7 @@ cdef class RandomState:
         >>> plt.show()
 
         """
-        return cont0_array(self.internal_state, rk_standard_cauchy, size)
+        return cont0_array(self.internal_state, rk_standard_cauchy, size, self.lock)
 
     def standard_t(self, df, size=None):
         """
@@ -2144,14 +2978,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fdf <= 0:
                 raise ValueError("df <= 0")
-            return cont1_array_sc(self.internal_state, rk_standard_t, size, fdf)
+            return cont1_array_sc(self.internal_state, rk_standard_t, size, fdf, self.lock)
 
         PyErr_Clear()
 
         odf = <ndarray> PyArray_FROM_OTF(df, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(odf, 0.0)):
             raise ValueError("df <= 0")
-        return cont1_array(self.internal_state, rk_standard_t, size, odf)
+        return cont1_array(self.internal_state, rk_standard_t, size, odf, self.lock)
 
     def vonmises(self, mu, kappa, size=None):
         """
@@ -2237,7 +3071,7 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fkappa < 0:
                 raise ValueError("kappa < 0")
-            return cont2_array_sc(self.internal_state, rk_vonmises, size, fmu, fkappa)
+            return cont2_array_sc(self.internal_state, rk_vonmises, size, fmu, fkappa, self.lock)
 
         PyErr_Clear()
 
@@ -2245,7 +3079,7 @@ cdef class RandomState:
         okappa = <ndarray> PyArray_FROM_OTF(kappa, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less(okappa, 0.0)):
             raise ValueError("kappa < 0")
-        return cont2_array(self.internal_state, rk_vonmises, size, omu, okappa)
+        return cont2_array(self.internal_state, rk_vonmises, size, omu, okappa, self.lock)
 
     def pareto(self, a, size=None):
         """
@@ -2334,14 +3168,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fa <= 0:
                 raise ValueError("a <= 0")
-            return cont1_array_sc(self.internal_state, rk_pareto, size, fa)
+            return cont1_array_sc(self.internal_state, rk_pareto, size, fa, self.lock)
 
         PyErr_Clear()
 
         oa = <ndarray>PyArray_FROM_OTF(a, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oa, 0.0)):
             raise ValueError("a <= 0")
-        return cont1_array(self.internal_state, rk_pareto, size, oa)
+        return cont1_array(self.internal_state, rk_pareto, size, oa, self.lock)
 
     def weibull(self, a, size=None):
         """
@@ -2434,14 +3268,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fa <= 0:
                 raise ValueError("a <= 0")
-            return cont1_array_sc(self.internal_state, rk_weibull, size, fa)
+            return cont1_array_sc(self.internal_state, rk_weibull, size, fa, self.lock)
 
         PyErr_Clear()
 
         oa = <ndarray>PyArray_FROM_OTF(a, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oa, 0.0)):
             raise ValueError("a <= 0")
-        return cont1_array(self.internal_state, rk_weibull, size, oa)
+        return cont1_array(self.internal_state, rk_weibull, size, oa, self.lock)
 
     def power(self, a, size=None):
         """
@@ -2543,14 +3377,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fa <= 0:
                 raise ValueError("a <= 0")
-            return cont1_array_sc(self.internal_state, rk_power, size, fa)
+            return cont1_array_sc(self.internal_state, rk_power, size, fa, self.lock)
 
         PyErr_Clear()
 
         oa = <ndarray>PyArray_FROM_OTF(a, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oa, 0.0)):
             raise ValueError("a <= 0")
-        return cont1_array(self.internal_state, rk_power, size, oa)
+        return cont1_array(self.internal_state, rk_power, size, oa, self.lock)
 
     def laplace(self, loc=0.0, scale=1.0, size=None):
         """
@@ -2633,14 +3467,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_laplace, size, floc, fscale)
+            return cont2_array_sc(self.internal_state, rk_laplace, size, floc, fscale, self.lock)
 
         PyErr_Clear()
         oloc = PyArray_FROM_OTF(loc, NPY_DOUBLE, NPY_ALIGNED)
         oscale = PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_laplace, size, oloc, oscale)
+        return cont2_array(self.internal_state, rk_laplace, size, oloc, oscale, self.lock)
 
     def gumbel(self, loc=0.0, scale=1.0, size=None):
         """
@@ -2764,14 +3598,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_gumbel, size, floc, fscale)
+            return cont2_array_sc(self.internal_state, rk_gumbel, size, floc, fscale, self.lock)
 
         PyErr_Clear()
         oloc = PyArray_FROM_OTF(loc, NPY_DOUBLE, NPY_ALIGNED)
         oscale = PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_gumbel, size, oloc, oscale)
+        return cont2_array(self.internal_state, rk_gumbel, size, oloc, oscale, self.lock)
 
     def logistic(self, loc=0.0, scale=1.0, size=None):
         """
@@ -2852,14 +3686,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_logistic, size, floc, fscale)
+            return cont2_array_sc(self.internal_state, rk_logistic, size, floc, fscale, self.lock)
 
         PyErr_Clear()
         oloc = PyArray_FROM_OTF(loc, NPY_DOUBLE, NPY_ALIGNED)
         oscale = PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_logistic, size, oloc, oscale)
+        return cont2_array(self.internal_state, rk_logistic, size, oloc, oscale, self.lock)
 
     def lognormal(self, mean=0.0, sigma=1.0, size=None):
         """
@@ -2982,7 +3816,7 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fsigma <= 0:
                 raise ValueError("sigma <= 0")
-            return cont2_array_sc(self.internal_state, rk_lognormal, size, fmean, fsigma)
+            return cont2_array_sc(self.internal_state, rk_lognormal, size, fmean, fsigma, self.lock)
 
         PyErr_Clear()
 
@@ -2990,7 +3824,7 @@ cdef class RandomState:
         osigma = PyArray_FROM_OTF(sigma, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(osigma, 0.0)):
             raise ValueError("sigma <= 0.0")
-        return cont2_array(self.internal_state, rk_lognormal, size, omean, osigma)
+        return cont2_array(self.internal_state, rk_lognormal, size, omean, osigma, self.lock)
 
     def rayleigh(self, scale=1.0, size=None):
         """
@@ -3055,14 +3889,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont1_array_sc(self.internal_state, rk_rayleigh, size, fscale)
+            return cont1_array_sc(self.internal_state, rk_rayleigh, size, fscale, self.lock)
 
         PyErr_Clear()
 
         oscale = <ndarray>PyArray_FROM_OTF(scale, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0.0")
-        return cont1_array(self.internal_state, rk_rayleigh, size, oscale)
+        return cont1_array(self.internal_state, rk_rayleigh, size, oscale, self.lock)
 
     def wald(self, mean, scale, size=None):
         """
@@ -3137,7 +3971,7 @@ cdef class RandomState:
                 raise ValueError("mean <= 0")
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_wald, size, fmean, fscale)
+            return cont2_array_sc(self.internal_state, rk_wald, size, fmean, fscale, self.lock)
 
         PyErr_Clear()
         omean = PyArray_FROM_OTF(mean, NPY_DOUBLE, NPY_ALIGNED)
@@ -3146,7 +3980,7 @@ cdef class RandomState:
             raise ValueError("mean <= 0.0")
         elif np.any(np.less_equal(oscale,0.0)):
             raise ValueError("scale <= 0.0")
-        return cont2_array(self.internal_state, rk_wald, size, omean, oscale)
+        return cont2_array(self.internal_state, rk_wald, size, omean, oscale, self.lock)
 
 
 
@@ -3221,7 +4055,7 @@ cdef class RandomState:
             if fleft == fright:
                 raise ValueError("left == right")
             return cont3_array_sc(self.internal_state, rk_triangular, size, fleft,
-                                  fmode, fright)
+                                  fmode, fright, self.lock)
 
         PyErr_Clear()
         oleft = <ndarray>PyArray_FROM_OTF(left, NPY_DOUBLE, NPY_ALIGNED)
@@ -3235,7 +4069,7 @@ cdef class RandomState:
         if np.any(np.equal(oleft, oright)):
             raise ValueError("left == right")
         return cont3_array(self.internal_state, rk_triangular, size, oleft,
-            omode, oright)
+            omode, oright, self.lock)
 
     # Complicated, discrete distributions:
     def binomial(self, n, p, size=None):
@@ -3332,7 +4166,7 @@ cdef class RandomState:
                 raise ValueError("p < 0")
             elif fp > 1:
                 raise ValueError("p > 1")
-            return discnp_array_sc(self.internal_state, rk_binomial, size, ln, fp)
+            return discnp_array_sc(self.internal_state, rk_binomial, size, ln, fp, self.lock)
 
         PyErr_Clear()
 
@@ -3344,7 +4178,7 @@ cdef class RandomState:
             raise ValueError("p < 0")
         if np.any(np.greater(p, 1)):
             raise ValueError("p > 1")
-        return discnp_array(self.internal_state, rk_binomial, size, on, op)
+        return discnp_array(self.internal_state, rk_binomial, size, on, op, self.lock)
 
     def negative_binomial(self, n, p, size=None):
         """
@@ -3426,7 +4260,7 @@ cdef class RandomState:
             elif fp > 1:
                 raise ValueError("p > 1")
             return discdd_array_sc(self.internal_state, rk_negative_binomial,
-                                   size, fn, fp)
+                                   size, fn, fp, self.lock)
 
         PyErr_Clear()
 
@@ -3439,7 +4273,7 @@ cdef class RandomState:
         if np.any(np.greater(p, 1)):
             raise ValueError("p > 1")
         return discdd_array(self.internal_state, rk_negative_binomial, size,
-                            on, op)
+                            on, op, self.lock)
 
     def poisson(self, lam=1.0, size=None):
         """
@@ -3501,7 +4335,7 @@ cdef class RandomState:
                 raise ValueError("lam < 0")
             if lam > self.poisson_lam_max:
                 raise ValueError("lam value too large")
-            return discd_array_sc(self.internal_state, rk_poisson, size, flam)
+            return discd_array_sc(self.internal_state, rk_poisson, size, flam, self.lock)
 
         PyErr_Clear()
 
@@ -3510,7 +4344,7 @@ cdef class RandomState:
             raise ValueError("lam < 0")
         if np.any(np.greater(olam, self.poisson_lam_max)):
             raise ValueError("lam value too large.")
-        return discd_array(self.internal_state, rk_poisson, size, olam)
+        return discd_array(self.internal_state, rk_poisson, size, olam, self.lock)
 
     def zipf(self, a, size=None):
         """
@@ -3591,14 +4425,14 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fa <= 1.0:
                 raise ValueError("a <= 1.0")
-            return discd_array_sc(self.internal_state, rk_zipf, size, fa)
+            return discd_array_sc(self.internal_state, rk_zipf, size, fa, self.lock)
 
         PyErr_Clear()
 
         oa = <ndarray>PyArray_FROM_OTF(a, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oa, 1.0)):
             raise ValueError("a <= 1.0")
-        return discd_array(self.internal_state, rk_zipf, size, oa)
+        return discd_array(self.internal_state, rk_zipf, size, oa, self.lock)
 
     def geometric(self, p, size=None):
         """
@@ -3654,7 +4488,7 @@ cdef class RandomState:
                 raise ValueError("p < 0.0")
             if fp > 1.0:
                 raise ValueError("p > 1.0")
-            return discd_array_sc(self.internal_state, rk_geometric, size, fp)
+            return discd_array_sc(self.internal_state, rk_geometric, size, fp, self.lock)
 
         PyErr_Clear()
 
@@ -3664,7 +4498,7 @@ cdef class RandomState:
             raise ValueError("p < 0.0")
         if np.any(np.greater(op, 1.0)):
             raise ValueError("p > 1.0")
-        return discd_array(self.internal_state, rk_geometric, size, op)
+        return discd_array(self.internal_state, rk_geometric, size, op, self.lock)
 
     def hypergeometric(self, ngood, nbad, nsample, size=None):
         """
@@ -3766,7 +4600,7 @@ cdef class RandomState:
             if ngood + nbad < nsample:
                 raise ValueError("ngood + nbad < nsample")
             return discnmN_array_sc(self.internal_state, rk_hypergeometric, size,
-                                    lngood, lnbad, lnsample)
+                                    lngood, lnbad, lnsample, self.lock)
 
 
         PyErr_Clear()
@@ -3783,7 +4617,7 @@ cdef class RandomState:
         if np.any(np.less(np.add(ongood, onbad),onsample)):
             raise ValueError("ngood + nbad < nsample")
         return discnmN_array(self.internal_state, rk_hypergeometric, size,
-            ongood, onbad, onsample)
+            ongood, onbad, onsample, self.lock)
 
     def logseries(self, p, size=None):
         """
@@ -3868,7 +4702,7 @@ cdef class RandomState:
                 raise ValueError("p <= 0.0")
             if fp >= 1.0:
                 raise ValueError("p >= 1.0")
-            return discd_array_sc(self.internal_state, rk_logseries, size, fp)
+            return discd_array_sc(self.internal_state, rk_logseries, size, fp, self.lock)
 
         PyErr_Clear()
 
@@ -3877,7 +4711,7 @@ cdef class RandomState:
             raise ValueError("p <= 0.0")
         if np.any(np.greater_equal(op, 1.0)):
             raise ValueError("p >= 1.0")
-        return discd_array(self.internal_state, rk_logseries, size, op)
+        return discd_array(self.internal_state, rk_logseries, size, op, self.lock)
 
     # Multivariate distributions:
     def multivariate_normal(self, mean, cov, size=None):
@@ -4089,19 +4923,20 @@ cdef class RandomState:
         mnarr = <ndarray>multin
         mnix = <long*>mnarr.data
         i = 0
-        while i < PyArray_SIZE(mnarr):
-            Sum = 1.0
-            dn = n
-            for j from 0 <= j < d-1:
-                mnix[i+j] = rk_binomial(self.internal_state, dn, pix[j]/Sum)
-                dn = dn - mnix[i+j]
-                if dn <= 0:
-                    break
-                Sum = Sum - pix[j]
-            if dn > 0:
-                mnix[i+d-1] = dn
-
-            i = i + d
+        with self.lock:
+            while i < PyArray_SIZE(mnarr):
+                Sum = 1.0
+                dn = n
+                for j from 0 <= j < d-1:
+                    mnix[i+j] = rk_binomial(self.internal_state, dn, pix[j]/Sum)
+                    dn = dn - mnix[i+j]
+                    if dn <= 0:
+                        break
+                    Sum = Sum - pix[j]
+                if dn > 0:
+                    mnix[i+d-1] = dn
+
+                i = i + d
 
         return multin
 
@@ -4208,15 +5043,16 @@ cdef class RandomState:
 
         i = 0
         totsize = PyArray_SIZE(val_arr)
-        while i < totsize:
-            acc = 0.0
-            for j from 0 <= j < k:
-                val_data[i+j]   = rk_standard_gamma(self.internal_state, alpha_data[j])
-                acc             = acc + val_data[i+j]
-            invacc  = 1/acc
-            for j from 0 <= j < k:
-                val_data[i+j]   = val_data[i+j] * invacc
-            i = i + k
+        with self.lock:
+            while i < totsize:
+                acc = 0.0
+                for j from 0 <= j < k:
+                    val_data[i+j]   = rk_standard_gamma(self.internal_state, alpha_data[j])
+                    acc             = acc + val_data[i+j]
+                invacc  = 1/acc
+                for j from 0 <= j < k:
+                    val_data[i+j]   = val_data[i+j] * invacc
+                i = i + k
 
         return diric
 
@@ -4256,6 +5092,15 @@ cdef class RandomState:
         """
         cdef long i, j
         cdef int copy
+        cdef npy_intp size = -1
+
+        # Arrays whose rows are contiguous are shuffled in C
+        if (type(x) is np.ndarray and x.ndim > 0 and x.flags.writeable and
+                not x.flags.maskna):
+            size = row_bytes(x)
+        if size >= 0:
+            shuffle_rows(self.internal_state, x, size, self.lock)
+            return
 
         i = len(x) - 1
         try:
@@ -4266,7 +5111,8 @@ cdef class RandomState:
         if (j == 0):
             # adaptation of random.shuffle()
             while i > 0:
-                j = rk_interval(i, self.internal_state)
+                with self.lock:
+                    j = rk_interval(i, self.internal_state)
                 x[i], x[j] = x[j], x[i]
                 i = i - 1
         else:
@@ -4274,12 +5120,14 @@ cdef class RandomState:
             copy = hasattr(x[0], 'copy')
             if copy:
                 while(i > 0):
-                    j = rk_interval(i, self.internal_state)
+                    with self.lock:
+                        j = rk_interval(i, self.internal_state)
                     x[i], x[j] = x[j].copy(), x[i].copy()
                     i = i - 1
             else:
                 while(i > 0):
-                    j = rk_interval(i, self.internal_state)
+                    with self.lock:
+                        j = rk_interval(i, self.internal_state)
                     x[i], x[j] = x[j][:], x[i][:]
                     i = i - 1
 
@@ -4326,6 +5174,131 @@ cdef class RandomState:
         self.shuffle(arr)
         return arr
 
+
+class MultivariateNormal(object):
+    """
+    MultivariateNormal(mean, cov, method='cholesky', random_state=None)
+
+    A multivariate normal distribution, for drawing samples repeatedly.
+
+    The covariance is factored once, when the distribution is created,
+    instead of on every call as by `RandomState.multivariate_normal`.
+
+    Parameters
+    ----------
+    mean : 1-D array_like, of length N
+        Mean of the N-dimensional distribution.
+    cov : 2-D array_like, of shape (N, N)
+        Covariance matrix of the distribution. It must be symmetric and
+        positive definite, or positive semi-definite with ``method='eigh'``.
+    method : {'cholesky', 'eigh'}, optional
+        The factorization of `cov`, its Cholesky decomposition or its
+        eigendecomposition.
+    random_state : RandomState, optional
+        The generator of the samples. The default is the generator of the
+        functions of `numpy.random`.
+
+    Attributes
+    ----------
+    mean : ndarray, shape (N,)
+        The mean.
+    factor : ndarray, shape (N, N)
+        A matrix A with ``dot(A.T, A) == cov``. The samples are
+        ``mean + dot(z, A)`` for standard normal row vectors z, which are
+        drawn with the ziggurat method, all at once, and transformed with
+        one matrix product.
+
+    See Also
+    --------
+    RandomState.multivariate_normal
+
+    Examples
+    --------
+    >>> mvn = np.random.MultivariateNormal([1, 2], [[1, 0.5], [0.5, 2]])
+    >>> mvn.sample(3)
+    array([[ 1.07545612,  2.83893495],
+           [-0.49129138,  0.32917211],
+           [ 2.07165214,  3.88066412]])
+
+    Samples can be written into an existing array:
+
+    >>> out = np.empty((1000, 2))
+    >>> x = mvn.sample(1000, out=out)
+    >>> x is out
+    True
+
+    """
+    def __init__(self, mean, cov, method='cholesky', random_state=None):
+        mean = np.array(mean, dtype=np.float64)
+        cov = np.array(cov, dtype=np.float64)
+        if len(mean.shape) != 1:
+            raise ValueError("mean must be 1 dimensional")
+        if (len(cov.shape) != 2) or (cov.shape[0] != cov.shape[1]):
+            raise ValueError("cov must be 2 dimensional and square")
+        if mean.shape[0] != cov.shape[0]:
+            raise ValueError("mean and cov must have same length")
+        if method == 'cholesky':
+            try:
+                factor = np.linalg.cholesky(cov).T
+            except np.linalg.LinAlgError:
+                raise ValueError("cov must be positive definite, or use "
+                                 "method='eigh'")
+        elif method == 'eigh':
+            w, v = np.linalg.eigh(cov)
+            if len(w) and w.min() < -1e6*np.finfo(np.float64).eps*abs(w).max():
+                raise ValueError("cov must be positive semi-definite")
+            factor = (v*np.sqrt(np.maximum(w, 0))).T
+        else:
+            raise ValueError("method must be 'cholesky' or 'eigh'")
+        self.mean = mean
+        self.factor = np.ascontiguousarray(factor)
+        self.random_state = random_state
+
+    def sample(self, size=None, out=None):
+        """
+        sample(size=None, out=None)
+
+        Draw samples from the distribution.
+
+        Parameters
+        ----------
+        size : int or tuple of ints, optional
+            The shape of the samples. The output has a last axis of length
+            N more. If no shape is given, a single sample is returned.
+        out : ndarray, optional
+            A C-contiguous float64 array of the shape of the output, into
+            which the samples are written.
+
+        Returns
+        -------
+        out : ndarray
+            The samples, of shape ``size + (N,)``.
+
+        """
+        if size is None:
+            shape = (len(self.mean),)
+        elif isinstance(size, (int, long, np.integer)):
+            shape = (size, len(self.mean))
+        else:
+            shape = tuple(size) + (len(self.mean),)
+        if out is None:
+            out = np.empty(shape)
+        elif (type(out) is not np.ndarray or out.shape != shape or
+                out.dtype != np.float64 or not out.flags.c_contiguous):
+            raise ValueError("out must be a C-contiguous float64 array of "
+                             "shape %s" % (shape,))
+        if self.random_state is None:
+            random_state = _rand
+        else:
+            random_state = self.random_state
+        # The standard normals in one block, transformed by one matrix
+        # product straight into out
+        z = random_state.standard_normal(out.size, method='ziggurat')
+        z.shape = (out.size // max(len(self.mean), 1), len(self.mean))
+        np.dot(z, self.factor, out.reshape(z.shape))
+        out += self.mean
+        return out
+
 _rand = RandomState()
 seed = _rand.seed
 get_state = _rand.get_state
@@ -4333,6 +5306,7 @@ set_state = _rand.set_state
 random_sample = _rand.random_sample
 randint = _rand.randint
 bytes = _rand.bytes
+choice = _rand.choice
 uniform = _rand.uniform
 rand = _rand.rand
 randn = _rand.randn
@@ -67,6 +67,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include <limits.h>
 #include <math.h>
@@ -116,6 +117,7 @@
 #endif
 
 #include "randomkit.h"
+#include "randomkit_jump.h"
 
 #ifndef RK_DEV_URANDOM
 #define RK_DEV_URANDOM "/dev/urandom"
@@ -149,6 +151,7 @@ rk_seed(unsigned long seed, rk_state *state)
     state->gauss = 0;
     state->has_gauss = 0;
     state->has_binomial = 0;
+    state->brng = RK_MT19937;
 }
 
 /* Thomas Wang 32 bits integer hash function */
@@ -181,6 +184,7 @@ rk_randomseed(rk_state *state)
         state->gauss = 0;
         state->has_gauss = 0;
         state->has_binomial = 0;
+        state->brng = RK_MT19937;
 
         for (i = 0; i < 624; i++) {
             state->key[i] &= 0xffffffffUL;
@@ -207,37 +211,121 @@ rk_randomseed(rk_state *state)
 #define UPPER_MASK 0x80000000UL
 #define LOWER_MASK 0x7fffffffUL
 
+#define MT_TWIST(u, v, w) \
+    ((w) ^ ((((u) & UPPER_MASK) | ((v) & LOWER_MASK)) >> 1) ^ \
+     (-((v) & 1) & MATRIX_A))
+
+#define MT_TEMPER(y) \
+    ((y) ^= ((y) >> 11), \
+     (y) ^= ((y) << 7) & 0x9d2c5680UL, \
+     (y) ^= ((y) << 15) & 0xefc60000UL, \
+     (y) ^= ((y) >> 18))
+
+static unsigned long rk_philox_next(rk_state *state);
+
+/*
+ * Compute the next N words of the state. The loops have no branches and the
+ * words they depend on are at least N - M apart, so that compilers can
+ * vectorize them.
+ */
+static void
+rk_reload(rk_state *state)
+{
+    unsigned long *key = state->key;
+    int i;
+
+    for (i = 0; i < N - M; i++) {
+        key[i] = MT_TWIST(key[i], key[i+1], key[i+M]);
+    }
+    for (; i < N - 1; i++) {
+        key[i] = MT_TWIST(key[i], key[i+1], key[i+(M-N)]);
+    }
+    key[N - 1] = MT_TWIST(key[N - 1], key[0], key[M - 1]);
+    state->pos = 0;
+}
+
 /* Slightly optimised reference implementation of the Mersenne Twister */
 unsigned long
 rk_random(rk_state *state)
 {
     unsigned long y;
 
+    if (state->brng == RK_PHILOX) {
+        return rk_philox_next(state);
+    }
     if (state->pos == RK_STATE_LEN) {
-        int i;
+        rk_reload(state);
+    }
+    y = state->key[state->pos++];
+    MT_TEMPER(y);
+    return y;
+}
+
+void
+rk_fill_uint32(unsigned int *out, size_t n, rk_state *state)
+{
+    if (state->brng == RK_PHILOX) {
+        rk_philox_fill(out, n, state);
+        return;
+    }
+    while (n > 0) {
+        unsigned long y, *key;
+        size_t i, k;
 
-        for (i = 0; i < N - M; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+M] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+        if (state->pos == RK_STATE_LEN) {
+            rk_reload(state);
+        }
+        key = state->key + state->pos;
+        k = RK_STATE_LEN - state->pos;
+        if (k > n) {
+            k = n;
         }
-        for (; i < N - 1; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+(M-N)] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+        for (i = 0; i < k; i++) {
+            y = key[i];
+            MT_TEMPER(y);
+            out[i] = (unsigned int)y;
         }
-        y = (state->key[N - 1] & UPPER_MASK) | (state->key[0] & LOWER_MASK);
-        state->key[N - 1] = state->key[M - 1] ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
+        state->pos += (int)k;
+        out += k;
+        n -= k;
+    }
+}
 
-        state->pos = 0;
+void
+rk_fill_floats(float *out, size_t n, rk_state *state)
+{
+    /* The values of rk_float, one word each */
+    unsigned int chunk[256];
+
+    while (n > 0) {
+        size_t i, k = n < 256 ? n : 256;
+
+        rk_fill_uint32(chunk, k, state);
+        for (i = 0; i < k; i++) {
+            out[i] = (long)(chunk[i] >> 8) * 5.9604644775390625e-08f;
+        }
+        out += k;
+        n -= k;
     }
-    y = state->key[state->pos++];
+}
 
-    /* Tempering */
-    y ^= (y >> 11);
-    y ^= (y << 7) & 0x9d2c5680UL;
-    y ^= (y << 15) & 0xefc60000UL;
-    y ^= (y >> 18);
+void
+rk_fill_doubles(double *out, size_t n, rk_state *state)
+{
+    /* The values of rk_double, two words each */
+    unsigned int chunk[512];
 
-    return y;
+    while (n > 0) {
+        size_t i, k = n < 256 ? n : 256;
+
+        rk_fill_uint32(chunk, 2*k, state);
+        for (i = 0; i < k; i++) {
+            long a = chunk[2*i] >> 5, b = chunk[2*i + 1] >> 6;
+            out[i] = (a * 67108864.0 + b) / 9007199254740992.0;
+        }
+        out += k;
+        n -= k;
+    }
 }
 
 long
@@ -296,18 +384,33 @@ rk_double(rk_state *state)
     return (a * 67108864.0 + b) / 9007199254740992.0;
 }
 
+float
+rk_float(rk_state *state)
+{
+    /* 5.9604644775390625e-08 = 1/0x1000000 */
+    return (long)(rk_random(state) >> 8) * 5.9604644775390625e-08f;
+}
+
 void
 rk_fill(void *buffer, size_t size, rk_state *state)
 {
     unsigned long r;
     unsigned char *buf = buffer;
-
-    for (; size >= 4; size -= 4) {
-        r = rk_random(state);
-        *(buf++) = r & 0xFF;
-        *(buf++) = (r >> 8) & 0xFF;
-        *(buf++) = (r >> 16) & 0xFF;
-        *(buf++) = (r >> 24) & 0xFF;
+    /* Generate the values a chunk at a time */
+    unsigned int chunk[256];
+
+    while (size >= 4) {
+        size_t i, n = size/4 < 256 ? size/4 : 256;
+
+        rk_fill_uint32(chunk, n, state);
+        for (i = 0; i < n; i++) {
+            r = chunk[i];
+            *(buf++) = r & 0xFF;
+            *(buf++) = (r >> 8) & 0xFF;
+            *(buf++) = (r >> 16) & 0xFF;
+            *(buf++) = (r >> 24) & 0xFF;
+        }
+        size -= 4*n;
     }
 
     if (!size) {
@@ -319,6 +422,277 @@ rk_fill(void *buffer, size_t size, rk_state *state)
     }
 }
 
+/* The low half of a * b, and its high half in *hi */
+static rk_uint64
+rk_umul128(rk_uint64 a, rk_uint64 b, rk_uint64 *hi)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t p = (__uint128_t)a * b;
+
+    *hi = (rk_uint64)(p >> 64);
+    return (rk_uint64)p;
+#else
+    const rk_uint64 low = 0xffffffffUL;
+    rk_uint64 p00 = (a & low) * (b & low), p01 = (a & low) * (b >> 32);
+    rk_uint64 p10 = (a >> 32) * (b & low), p11 = (a >> 32) * (b >> 32);
+    rk_uint64 mid = (p00 >> 32) + (p01 & low) + (p10 & low);
+
+    *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & low);
+#endif
+}
+
+/*
+ * Draw n values of rk_interval(rng) into vals. At most one word is drawn
+ * per missing value, two for ranges of more than 32 bits, so that the
+ * state ends where it would after n calls to rk_interval.
+ */
+static void
+rk_interval_chunk(rk_uint64 rng, rk_uint64 *vals, size_t n, rk_state *state)
+{
+    unsigned int words[256];
+    rk_uint64 mask = rng, v;
+    size_t i = 0, k, m;
+
+    if (rng == 0) {
+        memset(vals, 0, n*sizeof(rk_uint64));
+        return;
+    }
+    mask |= mask >> 1;
+    mask |= mask >> 2;
+    mask |= mask >> 4;
+    mask |= mask >> 8;
+    mask |= mask >> 16;
+    mask |= mask >> 32;
+    while (i < n) {
+        if (rng <= 0xffffffffUL) {
+            m = n - i < 256 ? n - i : 256;
+            rk_fill_uint32(words, m, state);
+            for (k = 0; k < m; k++) {
+                if ((v = words[k] & mask) <= rng) {
+                    vals[i++] = v;
+                }
+            }
+        }
+        else {
+            m = n - i < 128 ? n - i : 128;
+            rk_fill_uint32(words, 2*m, state);
+            for (k = 0; k < m; k++) {
+                v = (((rk_uint64)words[2*k] << 32) | words[2*k + 1]) & mask;
+                if (v <= rng) {
+                    vals[i++] = v;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Draw n values uniformly distributed in [0, rng] into vals, with the
+ * method of D. Lemire, "Fast random integer generation in an interval",
+ * ACM Transactions on Modeling and Computer Simulation, 29(1), 2019. A
+ * random x of b bits is mapped to the high b bits of x * s, s = rng + 1,
+ * and rejected when the low b bits are below (2**b - s) % s, which leaves
+ * the same number of x for each value. Ranges of up to 8 and 16 bits take
+ * x from the bytes and halves of the words.
+ */
+static void
+rk_bounded_chunk(rk_uint64 rng, rk_uint64 *vals, size_t n, rk_state *state)
+{
+    unsigned int words[256];
+    rk_uint64 s = rng + 1;
+    size_t i = 0, k, m;
+
+    if (rng == 0) {
+        memset(vals, 0, n*sizeof(rk_uint64));
+    }
+    else if (rng <= 0xff) {
+        unsigned int t = (unsigned int)((0x100 - s) % s), p;
+
+        while (i < n) {
+            m = (n - i + 3)/4 < 256 ? (n - i + 3)/4 : 256;
+            rk_fill_uint32(words, m, state);
+            for (k = 0; k < 4*m && i < n; k++) {
+                p = ((words[k >> 2] >> ((k & 3) << 3)) & 0xff)
+                    * (unsigned int)s;
+                if ((p & 0xff) >= t) {
+                    vals[i++] = p >> 8;
+                }
+            }
+        }
+    }
+    else if (rng <= 0xffff) {
+        unsigned int t = (unsigned int)((0x10000 - s) % s), p;
+
+        while (i < n) {
+            m = (n - i + 1)/2 < 256 ? (n - i + 1)/2 : 256;
+            rk_fill_uint32(words, m, state);
+            for (k = 0; k < 2*m && i < n; k++) {
+                p = ((words[k >> 1] >> ((k & 1) << 4)) & 0xffff)
+                    * (unsigned int)s;
+                if ((p & 0xffff) >= t) {
+                    vals[i++] = p >> 16;
+                }
+            }
+        }
+    }
+    else if (rng <= 0xffffffffUL) {
+        rk_uint64 t = (((rk_uint64)1 << 32) - s) % s, p;
+
+        while (i < n) {
+            m = n - i < 256 ? n - i : 256;
+            rk_fill_uint32(words, m, state);
+            for (k = 0; k < m; k++) {
+                p = words[k] * s;
+                if ((p & 0xffffffffUL) >= t) {
+                    vals[i++] = p >> 32;
+                }
+            }
+        }
+    }
+    else {
+        /* (2**64 - s) % s, and a full range when s wraps to 0 */
+        rk_uint64 t = s ? (0 - s) % s : 0, x, hi;
+
+        while (i < n) {
+            m = n - i < 128 ? n - i : 128;
+            rk_fill_uint32(words, 2*m, state);
+            for (k = 0; k < m; k++) {
+                x = ((rk_uint64)words[2*k] << 32) | words[2*k + 1];
+                if (!s) {
+                    vals[i++] = x;
+                }
+                else if (rk_umul128(x, s, &hi) >= t) {
+                    vals[i++] = hi;
+                }
+            }
+        }
+    }
+}
+
+/* Store off plus the n values of a chunk into items of itemsize bytes */
+#define RK_STORE_CHUNK(type) \
+    for (k = 0; k < m; k++) { \
+        ((type *)out)[i + k] = (type)(off + vals[k]); \
+    }
+
+static void
+rk_fill_chunks(void (*chunk)(rk_uint64, rk_uint64 *, size_t, rk_state *),
+               rk_uint64 off, rk_uint64 rng, void *out, size_t itemsize,
+               size_t n, rk_state *state)
+{
+    rk_uint64 vals[256];
+    size_t i, k, m;
+
+    for (i = 0; i < n; i += m) {
+        m = n - i < 256 ? n - i : 256;
+        chunk(rng, vals, m, state);
+        switch (itemsize) {
+            case 1: RK_STORE_CHUNK(unsigned char) break;
+            case 2: RK_STORE_CHUNK(unsigned short) break;
+            case 4: RK_STORE_CHUNK(unsigned int) break;
+            default: RK_STORE_CHUNK(rk_uint64)
+        }
+    }
+}
+
+void
+rk_fill_interval(rk_uint64 off, rk_uint64 rng, void *out, size_t itemsize,
+                 size_t n, rk_state *state)
+{
+    rk_fill_chunks(rk_interval_chunk, off, rng, out, itemsize, n, state);
+}
+
+void
+rk_fill_bounded(rk_uint64 off, rk_uint64 rng, void *out, size_t itemsize,
+                size_t n, rk_state *state)
+{
+    rk_fill_chunks(rk_bounded_chunk, off, rng, out, itemsize, n, state);
+}
+
+#if defined(__GNUC__)
+#define RK_PREFETCH(p) __builtin_prefetch(p, 1)
+#else
+#define RK_PREFETCH(p)
+#endif
+
+/* The number of swaps whose indices are drawn together */
+#define RK_SHUFFLE_BLOCK 64
+
+/* Swaps of a constant size, which compile to moves */
+#define RK_SHUFFLE_SWAPS(size) \
+    for (k = 0; k < count; k++) { \
+        char *a = data + (ptrdiff_t)(i - k)*stride, t[size]; \
+        char *b = data + (ptrdiff_t)j[k]*stride; \
+        memcpy(t, a, size); \
+        memcpy(a, b, size); \
+        memcpy(b, t, size); \
+    }
+
+void
+rk_shuffle(char *data, size_t n, ptrdiff_t stride, size_t itemsize,
+           char *buf, rk_state *state)
+{
+    unsigned long j[RK_SHUFFLE_BLOCK], mask = ~0UL, y;
+    size_t i, k, count;
+
+    if (n < 2) {
+        return;
+    }
+    /*
+     * The indices of a block of swaps are drawn first and their items
+     * prefetched, so that the cache misses of the swaps overlap. They are
+     * the values of rk_interval(i), with the mask found once per power of
+     * two.
+     */
+    for (i = n - 1; i > 0; i -= count) {
+        count = i < RK_SHUFFLE_BLOCK ? i : RK_SHUFFLE_BLOCK;
+        for (k = 0; k < count; k++) {
+            unsigned long max = i - k;
+
+            if (max > 0xffffffffUL) {
+                j[k] = rk_interval(max, state);
+            }
+            else {
+                while ((mask >> 1) >= max) {
+                    mask >>= 1;
+                }
+                if (state->brng == RK_PHILOX) {
+                    while ((j[k] = rk_random(state) & mask) > max);
+                }
+                else {
+                    /* rk_random of the Mersenne Twister, inline */
+                    do {
+                        if (state->pos == RK_STATE_LEN) {
+                            rk_reload(state);
+                        }
+                        y = state->key[state->pos++];
+                        MT_TEMPER(y);
+                    } while ((y & mask) > max);
+                    j[k] = y & mask;
+                }
+            }
+            RK_PREFETCH(data + (ptrdiff_t)j[k]*stride);
+        }
+        switch (itemsize) {
+            case 1: RK_SHUFFLE_SWAPS(1) break;
+            case 2: RK_SHUFFLE_SWAPS(2) break;
+            case 4: RK_SHUFFLE_SWAPS(4) break;
+            case 8: RK_SHUFFLE_SWAPS(8) break;
+            case 16: RK_SHUFFLE_SWAPS(16) break;
+            default:
+                for (k = 0; k < count; k++) {
+                    char *a = data + (ptrdiff_t)(i - k)*stride;
+                    char *b = data + (ptrdiff_t)j[k]*stride;
+
+                    memcpy(buf, a, itemsize);
+                    memcpy(a, b, itemsize);
+                    memcpy(b, buf, itemsize);
+                }
+        }
+    }
+}
+
 rk_error
 rk_devfill(void *buffer, size_t size, int strong)
 {
@@ -400,3 +774,174 @@ rk_gauss(rk_state *state)
         return f*x2;
     }
 }
+
+/*
+ * Jump ahead, from H. Haramoto, M. Matsumoto, T. Nishimura, F. Panneton and
+ * P. L'Ecuyer, "Efficient jump ahead for F2-linear random number
+ * generators", INFORMS Journal on Computing, 20(3), 2008. The state is the
+ * window of the next N untempered words, and advancing it by one word is a
+ * linear map T. With the jump polynomial p(x) = x**J mod the characteristic
+ * polynomial of T, advancing by J words is p(T), a sum of the windows
+ * following this one.
+ */
+void
+rk_jump(rk_state *state)
+{
+    rk_state tmp;
+    unsigned long window[N], sum[N];
+    int i, j, k;
+
+    memcpy(&tmp, state, sizeof(tmp));
+    for (j = 0; j < N; j++) {
+        if (tmp.pos == RK_STATE_LEN) {
+            rk_reload(&tmp);
+        }
+        window[j] = tmp.key[tmp.pos++];
+        sum[j] = 0;
+    }
+    /* window holds the words i, ..., i + N - 1 from i % N on */
+    for (i = 0; i < N*32 - 31; i++) {
+        k = i % N;
+        if (rk_jump_poly[i / 32] >> (i % 32) & 1) {
+            for (j = 0; j < N - k; j++) {
+                sum[j] ^= window[k + j];
+            }
+            for (; j < N; j++) {
+                sum[j] ^= window[k + j - N];
+            }
+        }
+        window[k] = MT_TWIST(window[k], window[(k + 1) % N],
+                             window[(k + M) % N]);
+    }
+    memcpy(state->key, sum, sizeof(sum));
+    state->pos = 0;
+    state->has_gauss = 0;
+    state->has_binomial = 0;
+}
+
+/*
+ * Philox4x32-10, from J. K. Salmon, M. A. Moraes, R. O. Dror and
+ * D. E. Shaw, "Parallel random numbers: as easy as 1, 2, 3", SC11, 2011.
+ * Each 128 bit counter is encrypted by ten rounds of multiplications and
+ * xors with the key into four 32 bit values.
+ */
+#define PHILOX_M0 0xD2511F53UL
+#define PHILOX_M1 0xCD9E8D57UL
+#define PHILOX_W0 0x9E3779B9UL
+#define PHILOX_W1 0xBB67AE85UL
+
+static void
+philox_block(const unsigned int *ctr, const unsigned int *key,
+             unsigned int *out)
+{
+    unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    unsigned int k0 = key[0], k1 = key[1];
+    int round;
+
+    for (round = 0; round < 10; round++) {
+        rk_uint64 p0 = (rk_uint64)PHILOX_M0 * c0;
+        rk_uint64 p1 = (rk_uint64)PHILOX_M1 * c2;
+        unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)p0;
+        unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)p1;
+
+        c0 = hi1 ^ c1 ^ k0;
+        c1 = lo1;
+        c2 = hi0 ^ c3 ^ k1;
+        c3 = lo0;
+        k0 += (unsigned int)PHILOX_W0;
+        k1 += (unsigned int)PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/* Add the 128 bit number delta to the counter, ignoring the overflow */
+static void
+philox_add(unsigned int *ctr, const unsigned int *delta)
+{
+    rk_uint64 carry = 0;
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        carry += (rk_uint64)ctr[i] + delta[i];
+        ctr[i] = (unsigned int)carry;
+        carry >>= 32;
+    }
+}
+
+static void
+philox_increment(unsigned int *ctr)
+{
+    static const unsigned int one[4] = {1, 0, 0, 0};
+    philox_add(ctr, one);
+}
+
+void
+rk_philox_seed(const unsigned int *key, const unsigned int *stream,
+               rk_state *state)
+{
+    state->brng = RK_PHILOX;
+    state->philox_key[0] = key[0];
+    state->philox_key[1] = key[1];
+    state->philox_ctr[0] = 0;
+    state->philox_ctr[1] = 0;
+    state->philox_ctr[2] = stream[0];
+    state->philox_ctr[3] = stream[1];
+    philox_block(state->philox_ctr, state->philox_key, state->philox_buf);
+    state->philox_pos = 0;
+    state->gauss = 0;
+    state->has_gauss = 0;
+    state->has_binomial = 0;
+}
+
+static unsigned long
+rk_philox_next(rk_state *state)
+{
+    if (state->philox_pos == 4) {
+        philox_increment(state->philox_ctr);
+        philox_block(state->philox_ctr, state->philox_key, state->philox_buf);
+        state->philox_pos = 0;
+    }
+    return state->philox_buf[state->philox_pos++];
+}
+
+void
+rk_philox_advance(const unsigned int *delta, rk_state *state)
+{
+    unsigned int words[4], blocks[4];
+    unsigned int pos[4] = {0, 0, 0, 0};
+    int i;
+
+    /* The position of the next value is 4*ctr + pos */
+    pos[0] = state->philox_pos;
+    for (i = 0; i < 4; i++) {
+        words[i] = delta[i];
+    }
+    philox_add(words, pos);
+    for (i = 0; i < 4; i++) {
+        blocks[i] = (words[i] >> 2) | (i < 3 ? words[i + 1] << 30 : 0);
+    }
+    philox_add(state->philox_ctr, blocks);
+    philox_block(state->philox_ctr, state->philox_key, state->philox_buf);
+    state->philox_pos = words[0] & 3;
+}
+
+void
+rk_philox_fill(unsigned int *out, size_t n, rk_state *state)
+{
+    /* Finish the current block, then write whole blocks directly */
+    while (n > 0 && state->philox_pos < 4) {
+        *out++ = state->philox_buf[state->philox_pos++];
+        n--;
+    }
+    for (; n >= 4; n -= 4, out += 4) {
+        philox_increment(state->philox_ctr);
+        philox_block(state->philox_ctr, state->philox_key, out);
+    }
+    while (n > 0) {
+        *out++ = rk_philox_next(state);
+        n--;
+    }
+}
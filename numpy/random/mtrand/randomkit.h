@@ -63,6 +63,18 @@
 
 #define RK_STATE_LEN 624
 
+#ifdef _MSC_VER
+typedef unsigned __int64 rk_uint64;
+#else
+typedef unsigned long long rk_uint64;
+#endif
+
+/* The bit generators which produce the random values of a state */
+typedef enum {
+    RK_MT19937 = 0, /* Mersenne Twister */
+    RK_PHILOX = 1 /* Philox4x32-10 counter-based generator */
+} rk_brng;
+
 typedef struct rk_state_
 {
     unsigned long key[RK_STATE_LEN];
@@ -94,6 +106,16 @@ typedef struct rk_state_
     double p3;
     double p4;
 
+    /* The bit generator in use. For RK_PHILOX, the values come from the
+     * four 32 bit words of philox_buf, which is the block of the 128 bit
+     * counter philox_ctr encrypted with philox_key, and philox_pos is the
+     * index of the next word. The high 64 bits of the counter select the
+     * stream. */
+    rk_brng brng;
+    unsigned int philox_key[2];
+    unsigned int philox_ctr[4];
+    unsigned int philox_buf[4];
+    int philox_pos;
 }
 rk_state;
 
@@ -153,11 +175,64 @@ extern unsigned long rk_interval(unsigned long max, rk_state *state);
  */
 extern double rk_double(rk_state *state);
 
+/*
+ * Returns a random float between 0.0 and 1.0, 1.0 excluded, with 24 random
+ * bits from one value of rk_random.
+ */
+extern float rk_float(rk_state *state);
+
 /*
  * fill the buffer with size random bytes
  */
 extern void rk_fill(void *buffer, size_t size, rk_state *state);
 
+/*
+ * Fill out with the next n values of rk_random, a block of the state at a
+ * time.
+ */
+extern void rk_fill_uint32(unsigned int *out, size_t n, rk_state *state);
+
+/*
+ * Fill out with the next n values of rk_double.
+ */
+extern void rk_fill_doubles(double *out, size_t n, rk_state *state);
+
+/*
+ * Fill out with the next n values of rk_float.
+ */
+extern void rk_fill_floats(float *out, size_t n, rk_state *state);
+
+/*
+ * Fill the n items of itemsize 1, 2, 4 or 8 bytes at out with off plus the
+ * values of rk_interval(rng, state), modulo the size of the items. Ranges
+ * of more than 32 bits draw two words per value, the high one first.
+ */
+extern void rk_fill_interval(rk_uint64 off, rk_uint64 rng, void *out,
+                             size_t itemsize, size_t n, rk_state *state);
+
+/*
+ * Fill the n items of itemsize 1, 2, 4 or 8 bytes at out with off plus
+ * values uniformly distributed in [0, rng], modulo the size of the items,
+ * with Lemire's multiply-shift method. Ranges below 2**8 and 2**16 take
+ * four and two values from each 32 bit word.
+ */
+extern void rk_fill_bounded(rk_uint64 off, rk_uint64 rng, void *out,
+                            size_t itemsize, size_t n, rk_state *state);
+
+/*
+ * Shuffle the n items of itemsize bytes at data, stride bytes apart, in
+ * place, with the same values as swapping the items i and
+ * rk_interval(i, state) for i = n - 1, ..., 1. buf holds itemsize bytes.
+ */
+extern void rk_shuffle(char *data, size_t n, ptrdiff_t stride,
+                       size_t itemsize, char *buf, rk_state *state);
+
+/*
+ * Advance a Mersenne Twister state as if 2**128 values had been drawn with
+ * rk_random, in about as much time as drawing 20000 values with it.
+ */
+extern void rk_jump(rk_state *state);
+
 /*
  * fill the buffer with randombytes from the random device
  * Returns RK_ENODEV if the device is unavailable, or RK_NOERR if it is
@@ -182,6 +257,28 @@ extern rk_error rk_altfill(void *buffer, size_t size, int strong,
  */
 extern double rk_gauss(rk_state *state);
 
+/*
+ * Initialize the state to use the Philox4x32-10 generator with the 64 bit
+ * key given as two 32 bit words, starting at the beginning of the stream
+ * given as two 32 bit words. Different keys or streams give independent
+ * sequences of 2**66 values each.
+ */
+extern void rk_philox_seed(const unsigned int *key, const unsigned int *stream,
+                           rk_state *state);
+
+/*
+ * Advance a Philox state as if delta values had been drawn with rk_random.
+ * delta is a 128 bit number given as four 32 bit words, least significant
+ * first.
+ */
+extern void rk_philox_advance(const unsigned int *delta, rk_state *state);
+
+/*
+ * Fill out with the next n values of a Philox state, as n calls of
+ * rk_random would, generating whole blocks at a time.
+ */
+extern void rk_philox_fill(unsigned int *out, size_t n, rk_state *state);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,542 @@
+/*
+ * Tables of the ziggurat samplers in distributions.c.
+ *
+ * Generated by generate_ziggurat.py, do not edit.
+ */
+#define RK_ZIG_NORMAL_R 3.654152885361009
+#define RK_ZIG_EXPONENTIAL_R 7.69711747013105
+
+static const double rk_zig_ki[256] = {
+    4208095142460473.0, 0.0, 3387314423377066.0,
+    3838760076329526.0, 4030768804284853.0, 4136731738831425.0,
+    4203757248061980.0, 4249917568175232.0, 4283617341567279.0,
+    4309289223118741.0, 4329489775160291.0, 4345795907381542.0,
+    4359232558735043.0, 4370494503729112.0, 4380069246208637.0,
+    4388308869036326.0, 4395473957544017.0, 4401761481779246.0,
+    4407323076017087.0, 4412277362214489.0, 4416718463609856.0,
+    4420722014513400.0, 4424349484774333.0, 4427651345406786.0,
+    4430669422002933.0, 4433438668973077.0, 4435988524276394.0,
+    4438343955928258.0, 4440526279075747.0, 4442553800233099.0,
+    4444442329864404.0, 4446205593656774.0, 4447855565092038.0,
+    4449402736338919.0, 4450856340407494.0, 4452224534495418.0,
+    4453514552209504.0, 4454732830655845.0, 4455885117108466.0,
+    4456976558984185.0, 4458011780093629.0, 4458994945549610.0,
+    4459929817253382.0, 4460819801516491.0, 4461667990088497.0,
+    4462477195631624.0, 4463249982499768.0, 4463988693531267.0,
+    4464695473444936.0, 4465372289331327.0, 4466020948651398.0,
+    4466643115089263.0, 4467240322551661.0, 4467813987562078.0,
+    4468365420260224.0, 4468895834186563.0, 4469406355005624.0,
+    4469898028299962.0, 4470371826548245.0, 4470828655385394.0,
+    4471269359229479.0, 4471694726348839.0, 4472105493433334.0,
+    4472502349725409.0, 4472885940759615.0, 4473256871753215.0,
+    4473615710685231.0, 4473962991096833.0, 4474299214642012.0,
+    4474624853414143.0, 4474940352071037.0, 4475246129778548.0,
+    4475542581990524.0, 4475830082080948.0, 4476108982842370.0,
+    4476379617863191.0, 4476642302795094.0, 4476897336520643.0,
+    4477145002230123.0, 4477385568415673.0, 4477619289790061.0,
+    4477846408136603.0, 4478067153096183.0, 4478281742896694.0,
+    4478490385029730.0, 4478693276878899.0, 4478890606303726.0,
+    4479082552182711.0, 4479269284918826.0, 4479450966910420.0,
+    4479627752990208.0, 4479799790834828.0, 4479967221347196.0,
+    4480130179013718.0, 4480288792238217.0, 4480443183654313.0,
+    4480593470417794.0, 4480739764480445.0, 4480882172846633.0,
+    4481020797813872.0, 4481155737198477.0, 4481287084547321.0,
+    4481414929336655.0, 4481539357158847.0, 4481660449897836.0,
+    4481778285894042.0, 4481892940099419.0, 4482004484223265.0,
+    4482112986869377.0, 4482218513665090.0, 4482321127382689.0,
+    4482420888053648.0, 4482517853076137.0, 4482612077316170.0,
+    4482703613202767.0, 4482792510817473.0, 4482878817978526.0,
+    4482962580319976.0, 4483043841366027.0, 4483122642600828.0,
+    4483199023533961.0, 4483273021761828.0, 4483344673025133.0,
+    4483414011262633.0, 4483481068661338.0, 4483545875703290.0,
+    4483608461209084.0, 4483668852378237.0, 4483727074826540.0,
+    4483783152620481.0, 4483837108308851.0, 4483888962951605.0,
+    4483938736146064.0, 4483986446050518.0, 4484032109405295.0,
+    4484075741551344.0, 4484117356446376.0, 4484156966678588.0,
+    4484194583478007.0, 4484230216725477.0, 4484263874959273.0,
+    4484295565379379.0, 4484325293849403.0, 4484353064896116.0,
+    4484378881706606.0, 4484402746123007.0, 4484424658634767.0,
+    4484444618368408.0, 4484462623074730.0, 4484478669113370.0,
+    4484492751434676.0, 4484504863558768.0, 4484514997551725.0,
+    4484523143998772.0, 4484529291974333.0, 4484533429008846.0,
+    4484535541052160.0, 4484535612433364.0, 4484533625816867.0,
+    4484529562154522.0, 4484523400633580.0, 4484515118620234.0,
+    4484504691598498.0, 4484492093104109.0, 4484477294653176.0,
+    4484460265665197.0, 4484440973380099.0, 4484419382768864.0,
+    4484395456437316.0, 4484369154522569.0, 4484340434581588.0,
+    4484309251471307.0, 4484275557219628.0, 4484239300886605.0,
+    4484200428415063.0, 4484158882469765.0, 4484114602264222.0,
+    4484067523374110.0, 4484017577536167.0, 4483964692431316.0,
+    4483908791450666.0, 4483849793442839.0, 4483787612440988.0,
+    4483722157367614.0, 4483653331715151.0, 4483581033200037.0,
+    4483505153387718.0, 4483425577285788.0, 4483342182902111.0,
+    4483254840764426.0, 4483163413397502.0, 4483067754753491.0,
+    4482967709590519.0, 4482863112794028.0, 4482753788634647.0,
+    4482639549955592.0, 4482520197281676.0, 4482395517841033.0,
+    4482265284489366.0, 4482129254525262.0, 4481987168383444.0,
+    4481838748191032.0, 4481683696169739.0, 4481521692864423.0,
+    4481352395175528.0, 4481175434169523.0, 4480990412637465.0,
+    4480796902367093.0, 4480594441088291.0, 4480382529045184.0,
+    4480160625140269.0, 4479928142586622.0, 4479684443993020.0,
+    4479428835793358.0, 4479160561915410.0, 4478878796564346.0,
+    4478582635972352.0, 4478271088936365.0, 4477943065929917.0,
+    4477597366530497.0, 4477232664848663.0, 4476847492576150.0,
+    4476440219183740.0, 4476009028690393.0, 4475551892286383.0,
+    4475066535915605.0, 4474550401693464.0, 4474000601739862.0,
+    4473413862618157.0, 4472786458058253.0, 4472114126958961.0,
+    4471391972746450.0, 4470614338917675.0, 4469774653883112.0,
+    4468865235838851.0, 4467877045039485.0, 4466799366045308.0,
+    4465619395558350.0, 4464321701199587.0, 4462887501169234.0,
+    4461293691124291.0, 4459511507635920.0, 4457504658253014.0,
+    4455226650324954.0, 4452616884242290.0, 4449594783440737.0,
+    4446050695647601.0, 4441831266659550.0, 4436714892173985.0,
+    4430368316897255.0, 4422264825074646.0, 4411517007702021.0,
+    4396496531309840.0, 4373832704204105.0, 4335125104963354.0,
+    4251099761678858.0,
+};
+
+static const double rk_zig_wi[256] = {
+    8.683627060828347e-16, 4.7793301741377593e-17, 6.354352416410258e-17,
+    7.454870480493524e-17, 8.329366815173283e-17, 9.068060404526806e-17,
+    9.714860076096846e-17, 1.0294750313816509e-16, 1.0823430288059529e-16,
+    1.131147019575026e-16, 1.1766359456688471e-16, 1.2193617278400444e-16,
+    1.259743991434077e-16, 1.2981099885983e-16, 1.3347203736556521e-16,
+    1.3697864842315511e-16, 1.4034823000997335e-16, 1.4359529451821483e-16,
+    1.4673208742137644e-16, 1.4976904668172175e-16, 1.5271515003384589e-16,
+    1.555781816925582e-16, 1.58364940090921e-16, 1.6108140175081854e-16,
+    1.6373285203782087e-16, 1.6632399058238027e-16, 1.6885901708498422e-16,
+    1.713417017638584e-16, 1.7377544365695136e-16, 1.7616331922835133e-16,
+    1.785081231681451e-16, 1.8081240285640384e-16, 1.8307848764671256e-16,
+    1.8530851388465636e-16, 1.8750444639224454e-16, 1.8966809700628152e-16,
+    1.9180114064694707e-16, 1.9390512930483762e-16, 1.9598150426489938e-16,
+    1.9803160682991647e-16, 2.0005668776139063e-16, 2.0205791561939557e-16,
+    2.04036384153502e-16, 2.0599311887275701e-16, 2.0792908290287945e-16,
+    2.0984518222246143e-16, 2.117422703563793e-16, 2.136211525932919e-16,
+    2.1548258978462456e-16, 2.1732730177446985e-16, 2.1915597050311459e-16,
+    2.2096924282121024e-16, 2.227677330467673e-16, 2.2455202529302963e-16,
+    2.263226755917567e-16, 2.280802138334151e-16, 2.298251455431733e-16,
+    2.3155795350934717e-16, 2.3327909927899507e-16, 2.349890245336731e-16,
+    2.3668815235689126e-16, 2.3837688840352904e-16, 2.4005562198034833e-16,
+    2.417247270457588e-16, 2.4338456313612944e-16, 2.45035476225179e-16,
+    2.4667779952231006e-16, 2.483118542151581e-16, 2.499379501611042e-16,
+    2.5155638653203404e-16, 2.5316745241621325e-16, 2.547714273807808e-16,
+    2.5636858199803476e-16, 2.579591783383904e-16, 2.595434704326291e-16,
+    2.6112170470582226e-16, 2.626941203851009e-16, 2.6426094988325525e-16,
+    2.658224191599747e-16, 2.6737874806238796e-16, 2.689301506464206e-16,
+    2.7047683548036584e-16, 2.7201900593194673e-16, 2.735568604400485e-16,
+    2.7509059277220414e-16, 2.7662039226883326e-16, 2.781464440751553e-16,
+    2.796689293616304e-16, 2.811880255337159e-16, 2.8270390643166804e-16,
+    2.8421674252106693e-16, 2.8572670107469254e-16, 2.872339463463364e-16,
+    2.887386397370925e-16, 2.9024093995463437e-16, 2.917410031659504e-16,
+    2.932389831439797e-16, 2.9473503140856054e-16, 2.9622929736207917e-16,
+    2.977219284201809e-16, 2.9921307013788463e-16, 3.0070286633142165e-16,
+    3.0219145919609987e-16, 3.03678989420479e-16, 3.051655962971257e-16,
+    3.066514178302042e-16, 3.0813659084014336e-16, 3.0962125106561073e-16,
+    3.111055332630125e-16, 3.125895713037278e-16, 3.1407349826927714e-16,
+    3.1555744654461717e-16, 3.1704154790974445e-16, 3.1852593362978663e-16,
+    3.200107345437515e-16, 3.214960811520994e-16, 3.2298210370330056e-16,
+    3.2446893227953307e-16, 3.2595669688167537e-16, 3.2744552751374234e-16,
+    3.2893555426691273e-16, 3.304269074032927e-16, 3.3191971743955903e-16,
+    3.3341411523062504e-16, 3.349102320534696e-16, 3.364081996912721e-16,
+    3.379081505179944e-16, 3.394102175835522e-16, 3.409145346997196e-16,
+    3.424212365269125e-16, 3.4393045866199745e-16, 3.4544233772727637e-16,
+    3.4695701146079997e-16, 3.4847461880816654e-16, 3.4999530001596677e-16,
+    3.5151919672703956e-16, 3.530464520777096e-16, 3.545772107971826e-16,
+    3.5611161930928127e-16, 3.5764982583671083e-16, 3.5919198050805217e-16,
+    3.6073823546768767e-16, 3.62288744988875e-16, 3.638436655901936e-16,
+    3.6540315615559934e-16, 3.669673780583357e-16, 3.6853649528896015e-16,
+    3.7011067458776174e-16, 3.716900855818573e-16, 3.732749009272725e-16,
+    3.748652964563301e-16, 3.764614513306871e-16, 3.7806354820038333e-16,
+    3.796717733692847e-16, 3.81286316967331e-16, 3.829073731300205e-16,
+    3.8453514018559503e-16, 3.8616982085041696e-16, 3.8781162243306366e-16,
+    3.8946075704770047e-16, 3.9111744183733125e-16, 3.9278189920756777e-16,
+    3.9445435707160414e-16, 3.961350491071328e-16, 3.978242150259903e-16,
+    3.995221008573813e-16, 4.0122895924559053e-16, 4.0294504976316317e-16,
+    4.0467063924060814e-16, 4.064060021137609e-16, 4.0815142079003244e-16,
+    4.099071860348679e-16, 4.1167359737984646e-16, 4.134509635539701e-16,
+    4.1523960293981795e-16, 4.170398440563833e-16, 4.1885202607056557e-16,
+    4.206764993394585e-16, 4.2251362598576456e-16, 4.243637805088701e-16,
+    4.2622735043434475e-16, 4.281047370048792e-16, 4.299963559159534e-16,
+    4.3190263809983563e-16, 4.338240305618544e-16, 4.3576099727326276e-16,
+    4.3771402012543917e-16, 4.396835999506351e-16, 4.4167025761500585e-16,
+    4.4367453519024474e-16, 4.456969972107949e-16, 4.477382320243465e-16,
+    4.497988532441506e-16, 4.51879501312604e-16, 4.53980845186604e-16,
+    4.561035841563454e-16, 4.582484498105624e-16, 4.604162081627236e-16,
+    4.626076619543955e-16, 4.648236531539341e-16, 4.67065065670879e-16,
+    4.693328283089513e-16, 4.716279179834561e-16, 4.739513632322101e-16,
+    4.763042480529397e-16, 4.786877161045007e-16, 4.811029753143727e-16,
+    4.83551302940786e-16, 4.860340511447171e-16, 4.885526531349988e-16,
+    4.911086299591681e-16, 4.937035980236772e-16, 4.96339277440045e-16,
+    4.990175013088311e-16, 5.017402260714605e-16, 5.045095430815269e-16,
+    5.07327691573011e-16, 5.101970732338156e-16, 5.131202686303404e-16,
+    5.161000557739877e-16, 5.191394311754375e-16, 5.222416337996938e-16,
+    5.254101724174328e-16, 5.286488569501704e-16, 5.319618345335188e-16,
+    5.353536311813313e-16, 5.388292001330899e-16, 5.423939782198587e-16,
+    5.460539519071686e-16, 5.49815735088975e-16, 5.536866612464843e-16,
+    5.576748932923575e-16, 5.617895553552448e-16, 5.660408920079487e-16,
+    5.704404621288487e-16, 5.750013768917029e-16, 5.797385945721764e-16,
+    5.846692893452686e-16, 5.898133176475145e-16, 5.951938149638729e-16,
+    6.008379696269235e-16, 6.067780409330819e-16, 6.130527208722697e-16,
+    6.19708989457909e-16, 6.268046963298801e-16, 6.34412240712508e-16,
+    6.426239659545692e-16, 6.515603317342698e-16, 6.613827885095446e-16,
+    6.723150462503459e-16, 6.846803417562237e-16, 6.989718336385731e-16,
+    7.159994934828948e-16, 7.372424301797334e-16, 7.658936370804535e-16,
+    8.113849337656484e-16,
+};
+
+static const double rk_zig_fi[256] = {
+    1.0, 0.9771017012827313, 0.9598790918124159,
+    0.945198953453078, 0.9320600759689902, 0.9199915050483602,
+    0.9087264400605629, 0.898095921906304, 0.8879846607633999,
+    0.8783096558161468, 0.8690086880437932, 0.8600336212030086,
+    0.8513462584651237, 0.8429156531184411, 0.8347162929929304,
+    0.8267268339520942, 0.8189291916094148, 0.8113078743182199,
+    0.8038494831763895, 0.7965423304282546, 0.7893761435711986,
+    0.7823418326598619, 0.7754313049861383, 0.7686373158033348,
+    0.7619533468415465, 0.7553735065117545, 0.7488924472237267,
+    0.7425052963446362, 0.7362075981312667, 0.7299952645658024,
+    0.7238645334728816, 0.7178119326349014, 0.7118342488823585,
+    0.7059285013367974, 0.7000919181404901, 0.6943219161300326,
+    0.6886160830085271, 0.6829721616487914, 0.6773880362225131,
+    0.6718617199007664, 0.6663913439123806, 0.6609751477802414,
+    0.6556114705832247, 0.6502987431142946, 0.6450354808242519,
+    0.639820277456439, 0.63465179929096, 0.6295287799281283,
+    0.6244500155502742, 0.6194143606090392, 0.6144207238920768,
+    0.6094680649288954, 0.6045553907005495, 0.5996817526221677,
+    0.5948462437709913, 0.590047996335792, 0.5852861792663003,
+    0.5805599961036835, 0.5758686829752105, 0.571211506738075,
+    0.5665877632589518, 0.5619967758172779, 0.5574378936214863,
+    0.5529104904285199, 0.5484139632579211, 0.5439477311926499,
+    0.5395112342595446, 0.5351039323830196, 0.5307253044061939,
+    0.5263748471741867, 0.5220520746747949, 0.5177565172322006,
+    0.513487720749743, 0.5092452459981361, 0.5050286679458288,
+    0.5008375751284821, 0.4966715690547963, 0.49253026364614866,
+    0.48841328470771206, 0.4843202694289116, 0.4802508659112497,
+    0.4762047327216838, 0.47218153846988326, 0.46818096140782217,
+    0.46420268905027884, 0.4602464178149235, 0.45631185268077357,
+    0.4523987068638825, 0.44850670150921407, 0.44463556539772775,
+    0.4407850346677699, 0.4369548525499293, 0.43314476911457406,
+    0.4293545410313415, 0.4255839313399006, 0.4218327092313533,
+    0.4181006498396846, 0.4143875340427068, 0.4106931482719832,
+    0.40701728433124795, 0.4033597392228689, 0.39972031498193167,
+    0.3960988185175471, 0.39249506146101076, 0.3889088600204646,
+    0.38534003484173396, 0.38178841087503135, 0.3782538172472381,
+    0.3747360871394914, 0.37123505766982134, 0.3677505697805962,
+    0.3642824681305496, 0.36083060099117575, 0.3573948201472905,
+    0.35397498080156925, 0.3505709414828812, 0.3471825639582515,
+    0.34380971314829134, 0.34045225704594545, 0.3371100666384128,
+    0.3337830158321085, 0.3304709813805371, 0.3271738428149586,
+    0.323891482377732, 0.32062378495823013, 0.3173706380312224,
+    0.31413193159763014, 0.3109075581275637, 0.30769741250555377,
+    0.3045013919778963, 0.3013193961020341, 0.29815132669790134,
+    0.29499708780116257, 0.291856585618281, 0.28872972848335393,
+    0.2856164268166581, 0.2825165930848494, 0.2794301417627653,
+    0.27635698929678126, 0.2732970540696758, 0.27025025636696,
+    0.26721651834463184, 0.26419576399831757, 0.2611879191337637,
+    0.258192911338648, 0.25521066995567715, 0.25224112605694377,
+    0.2492842124195167, 0.24633986350223877, 0.243408015423712,
+    0.2404886059414491, 0.23758157443217368, 0.2346868618732527,
+    0.23180441082524852, 0.22893416541557748, 0.22607607132326488,
+    0.2232300757647896, 0.2203961274810116, 0.21757417672517837,
+    0.2147641752520085, 0.21196607630785294, 0.20917983462193565,
+    0.20640540639867933, 0.2036427493111215, 0.20089182249543133,
+    0.1981525865465381, 0.1954250035148856, 0.1927090369043288,
+    0.19000465167119307, 0.18731181422451693, 0.18463049242750454,
+    0.1819606556002165, 0.1793022745235304, 0.17665532144440665,
+    0.17401977008249936, 0.17139559563815562, 0.16878277480185033,
+    0.16618128576511007, 0.16359110823298295, 0.16101222343811766,
+    0.15844461415652022, 0.15588826472506456, 0.15334316106083767,
+    0.15080929068241017, 0.14828664273312872, 0.14577520800653793,
+    0.14327497897404712, 0.1407859498149683, 0.13830811644906432,
+    0.13584147657175735, 0.13338602969216284, 0.13094177717412817,
+    0.12850872228047364, 0.12608687022065035, 0.1236762282020514,
+    0.12127680548523544, 0.1188886134433457, 0.11651166562603701,
+    0.11414597782825521, 0.11179156816424558, 0.10944845714721002,
+    0.10711666777507288, 0.10479622562286706, 0.10248715894230627,
+    0.10018949876917202, 0.09790327903921563, 0.09562853671335333,
+    0.09336531191302662, 0.09111364806670073, 0.08887359206859423,
+    0.08664519445086778, 0.08442850957065466, 0.08222359581349568,
+    0.08003051581494751, 0.07784933670237221, 0.07568013035919496,
+    0.07352297371424099, 0.07137794905914197, 0.06924514439725027,
+    0.06712465382802399, 0.06501657797147044, 0.06292102443797785,
+    0.060838108349751806, 0.058767952921137984, 0.05671069010639947,
+    0.054666461325077916, 0.05263541827697365, 0.05061772386112179,
+    0.048613553216035145, 0.046623094902089664, 0.044646552251446536,
+    0.04268414491661938, 0.04073611065607875, 0.03880270740465692,
+    0.03688421568869115, 0.03498094146183307, 0.0330932194586887,
+    0.03122141719202369, 0.02936593975823011, 0.027527235669693315,
+    0.025705804008632656, 0.023902203305873237, 0.022117062707379922,
+    0.020351096230109354, 0.01860512127578335, 0.01688008315259584,
+    0.015177088307982072, 0.013497450601780807, 0.011842757857943104,
+    0.0102149714397311, 0.008616582769422917, 0.00705087547139211,
+    0.005522403299264754, 0.0040379725933718715, 0.002609072746106363,
+    0.001260285930498598,
+};
+
+static const double rk_zig_ke[256] = {
+    3985772928715732.0, 0.0, 2742928985166952.0,
+    3438700186803299.0, 3744780257810304.0, 3914896975372733.0,
+    4022625697542711.0, 4096776410635388.0, 4150853606149163.0,
+    4192001604687380.0, 4224344877584072.0, 4250427292531716.0,
+    4271901371161534.0, 4289886428824102.0, 4305167164135185.0,
+    4318309783140419.0, 4329732973408930.0, 4339752937704670.0,
+    4348612900760380.0, 4356502988721760.0, 4363573953227340.0,
+    4369946852445013.0, 4375720012348343.0, 4380974119031475.0,
+    4385776001930294.0, 4390181484145301.0, 4394237557465215.0,
+    4397984061535395.0, 4401454994146426.0, 4404679543790852.0,
+    4407682910787982.0, 4410486965794396.0, 4413110782053577.0,
+    4415571068741701.0, 4417882526198710.0, 4420058138987323.0,
+    4422109419110768.0, 4424046609003129.0, 4425878851844250.0,
+    4427614335173866.0, 4429260412563038.0, 4430823707156473.0,
+    4432310200160196.0, 4433725306767515.0, 4435073941555375.0,
+    4436360575016072.0, 4437589282595120.0, 4438763787369084.0,
+    4439887497305301.0, 4440963537889315.0, 4441994780778251.0,
+    4442983869033583.0, 4443933239400426.0, 4444845142028909.0,
+    4445721657973832.0, 4446564714759240.0, 4447376100252991.0,
+    4448157475061631.0, 4448910383626428.0, 4449636264176641.0,
+    4450336457674983.0, 4451012215872351.0, 4451664708573596.0,
+    4452295030203005.0, 4452904205747009.0, 4453493196141905.0,
+    4454062903166142.0, 4454614173889473.0, 4455147804725090.0,
+    4455664545125434.0, 4456165100957686.0, 4456650137590828.0,
+    4457120282722585.0, 4457576128971458.0, 4458018236256244.0,
+    4458447133983073.0, 4458863323057846.0, 4459267277740095.0,
+    4459659447352585.0, 4460040257859578.0, 4460410113325308.0,
+    4460769397263133.0, 4461118473884710.0, 4461457689257740.0,
+    4461787372379910.0, 4462107836175979.0, 4462419378424317.0,
+    4462722282618581.0, 4463016818769708.0, 4463303244152964.0,
+    4463581804004300.0, 4463852732169940.0, 4464116251712772.0,
+    4464372575478779.0, 4464621906626489.0, 4464864439122177.0,
+    4465100358203282.0, 4465329840812355.0, 4465553056003595.0,
+    4465770165323938.0, 4465981323170417.0, 4466186677125455.0,
+    4466386368271563.0, 4466580531486826.0, 4466769295722447.0,
+    4466952784263502.0, 4467131114974006.0, 4467304400527264.0,
+    4467472748622446.0, 4467636262188207.0, 4467795039574164.0,
+    4467949174730939.0, 4468098757379441.0, 4468243873170018.0,
+    4468384603832024.0, 4468521027314373.0, 4468653217917530.0,
+    4468781246417428.0, 4468905180181701.0, 4469025083278642.0,
+    4469141016579233.0, 4469253037852581.0, 4469361201855066.0,
+    4469465560413473.0, 4469566162502383.0, 4469663054316031.0,
+    4469756279334881.0, 4469845878387079.0, 4469931889704995.0,
+    4470014348976986.0, 4470093289394550.0, 4470168741694983.0,
+    4470240734199651.0, 4470309292847996.0, 4470374441227331.0,
+    4470436200598525.0, 4470494589917604.0, 4470549625853343.0,
+    4470601322800852.0, 4470649692891184.0, 4470694745996980.0,
+    4470736489734115.0, 4470774929459349.0, 4470810068263924.0,
+    4470841906963073.0, 4470870444081369.0, 4470895675833820.0,
+    4470917596102651.0, 4470936196409613.0, 4470951465883736.0,
+    4470963391224346.0, 4470971956659197.0, 4470977143897541.0,
+    4470978932077904.0, 4470977297710361.0, 4470972214613072.0,
+    4470963653842747.0, 4470951583618801.0, 4470935969240827.0,
+    4470916772999008.0, 4470893954077117.0, 4470867468447603.0,
+    4470837268758337.0, 4470803304210460.0, 4470765520426769.0,
+    4470723859310028.0, 4470678258890503.0, 4470628653161979.0,
+    4470574971905457.0, 4470517140499614.0, 4470455079717082.0,
+    4470388705505446.0, 4470317928751817.0, 4470242655029689.0,
+    4470162784326668.0, 4470078210751556.0, 4469988822219057.0,
+    4469894500110288.0, 4469795118907000.0, 4469690545797298.0,
+    4469580640250319.0, 4469465253557163.0, 4469344228335006.0,
+    4469217397991048.0, 4469084586142555.0, 4468945605988874.0,
+    4468800259630802.0, 4468648337332216.0, 4468489616718258.0,
+    4468323861903709.0, 4468150822544456.0, 4467970232804101.0,
+    4467781810226787.0, 4467585254506221.0, 4467380246139658.0,
+    4467166444954116.0, 4466943488490515.0, 4466710990229517.0,
+    4466468537640690.0, 4466215690034133.0, 4465951976190801.0,
+    4465676891744454.0, 4465389896284246.0, 4465090410142477.0,
+    4464777810826750.0, 4464451429049612.0, 4464110544301482.0,
+    4463754379904174.0, 4463382097472202.0, 4462992790697121.0,
+    4462585478355953.0, 4462159096427752.0, 4461712489182115.0,
+    4461244399078944.0, 4460753455289386.0, 4460238160612098.0,
+    4459696876515553.0, 4459127805983955.0, 4458528973779075.0,
+    4457898203649721.0, 4457233091920645.0, 4456530976767892.0,
+    4455788902331217.0, 4455003576616606.0, 4454171321891082.0,
+    4453288015951104.0, 4452349022232650.0, 4451349106194827.0,
+    4450282334707461.0, 4449141954247902.0, 4447920242480610.0,
+    4446608326137820.0, 4445195955871676.0, 4443671225661689.0,
+    4442020220072462.0, 4440226566619900.0, 4438270861888260.0,
+    4436129927556552.0, 4433775834104270.0, 4431174602388627.0,
+    4428284451100006.0, 4425053392146958.0, 4421415870372502.0,
+    4417287970124083.0, 4412560416174562.0, 4407088078325945.0,
+    4400673742272493.0, 4393042098597073.0, 4383796248451588.0,
+    4372341169422858.0, 4357740343059955.0, 4338425130125967.0,
+    4311541827049176.0, 4271262897902398.0, 4203411844498904.0,
+    4061213381260383.0,
+};
+
+static const double rk_zig_we[256] = {
+    1.9311480126418445e-15, 1.417802848790034e-17, 2.327882499337466e-17,
+    3.0487830247057855e-17, 3.6665697714469215e-17, 4.2179302189284605e-17,
+    4.7222561556858037e-17, 5.1911915446213466e-17, 5.632347108395089e-17,
+    6.051008260642371e-17, 6.451016509672375e-17, 6.835264680369693e-17,
+    7.205993957468557e-17, 7.564981553738962e-17, 7.91366439619478e-17,
+    8.253223556351575e-17, 8.58464361688474e-17, 8.908755486564438e-17,
+    9.226267962966075e-17, 9.537791450528982e-17, 9.843856087455641e-17,
+    1.0144925809006014e-16, 1.044140940558507e-16, 1.0733669323436116e-16,
+    1.1022028745669924e-16, 1.1306777346479073e-16, 1.1588176009705277e-16,
+    1.1866460730417632e-16, 1.2141845865694108e-16, 1.241452686232614e-16,
+    1.2684682560605911e-16, 1.2952477151912048e-16, 1.3218061851538576e-16,
+    1.348157633574521e-16, 1.3743149982367396e-16, 1.400290294680763e-16,
+    1.4260947099321062e-16, 1.4517386844829072e-16, 1.4772319842763362e-16,
+    1.5025837641447237e-16, 1.5278026239101435e-16, 1.5528966581595482e-16,
+    1.5778735005459367e-16, 1.6027403633350697e-16, 1.6275040728083315e-16,
+    1.652171101041987e-16, 1.6767475945078072e-16, 1.7012393998770442e-16,
+    1.7256520873568024e-16, 1.7499909718432168e-16, 1.7742611321380307e-16,
+    1.7984674284430517e-16, 1.8226145183195626e-16, 1.8467068712763381e-16,
+    1.8707487821298066e-16, 1.894744383262571e-16, 1.9186976558915807e-16,
+    1.9426124404442855e-16, 1.9664924461298835e-16, 1.990341259782996e-16,
+    2.0141623540485714e-16, 2.03795909496937e-16, 2.0617347490308257e-16,
+    2.085492489712359e-16, 2.1092354035891348e-16, 2.1329664960238117e-16,
+    2.1566886964838792e-16, 2.1804048635166832e-16, 2.2041177894111385e-16,
+    2.2278302045723773e-16, 2.2515447816331177e-16, 2.275264139323352e-16,
+    2.2989908461180013e-16, 2.3227274236804194e-16, 2.346476350118075e-16,
+    2.370240063065322e-16, 2.3940209626069136e-16, 2.4178214140547543e-16,
+    2.4416437505893955e-16, 2.4654902757768136e-16, 2.489363265970209e-16,
+    2.513264972605781e-16, 2.537197624400779e-16, 2.5611634294614825e-16,
+    2.5851645773082223e-16, 2.6092032408240414e-16, 2.633281578133129e-16,
+    2.657401734414746e-16, 2.681565843657983e-16, 2.7057760303623356e-16,
+    2.7300344111887807e-16, 2.754343096565747e-16, 2.778704192254113e-16,
+    2.8031198008751283e-16, 2.8275920234049556e-16, 2.852122960639316e-16,
+    2.876714714631566e-16, 2.9013693901073616e-16, 2.9260890958589376e-16,
+    2.9508759461218895e-16, 2.9757320619372383e-16, 3.00065957250146e-16,
+    3.0256606165070646e-16, 3.0507373434762373e-16, 3.07589191508998e-16,
+    3.1011265065151405e-16, 3.126443307731661e-16, 3.1518445248623385e-16,
+    3.1773323815073545e-16, 3.2029091200858197e-16, 3.2285770031865435e-16,
+    3.2543383149302467e-16, 3.280195362345422e-16, 3.30615047676006e-16,
+    3.3322060152114703e-16, 3.3583643618764434e-16, 3.38462792952403e-16,
+    3.4109991609932454e-16, 3.437480530698049e-16, 3.464074546162003e-16,
+    3.490783749585054e-16, 3.517610719444969e-16, 3.544558072135999e-16,
+    3.5716284636474514e-16, 3.5988245912849136e-16, 3.6261491954369893e-16,
+    3.6536050613904907e-16, 3.681195021197162e-16, 3.708921955595125e-16,
+    3.7367887959883716e-16, 3.7647985264877703e-16, 3.7929541860172196e-16,
+    3.8212588704887393e-16, 3.849715735050474e-16, 3.878327996411785e-16,
+    3.9070989352498045e-16, 3.936031898702061e-16, 3.965130302950025e-16,
+    3.994397635898671e-16, 4.023837459957456e-16, 4.053453414928384e-16,
+    4.0832492210071647e-16, 4.113228681903823e-16, 4.143395688089461e-16,
+    4.1737542201763066e-16, 4.2043083524385723e-16, 4.235062256482139e-16,
+    4.2660202050715454e-16, 4.297186576123314e-16, 4.328565856875197e-16,
+    4.360162648241555e-16, 4.391981669365729e-16, 4.42402776238098e-16,
+    4.456305897392349e-16, 4.488821177692605e-16, 4.521578845226336e-16,
+    4.55458428631723e-16, 4.587843037674611e-16, 4.621360792696415e-16,
+    4.655143408087057e-16, 4.689196910809904e-16, 4.723527505395536e-16,
+    4.758141581628542e-16, 4.793045722637235e-16, 4.828246713412574e-16,
+    4.863751549784499e-16, 4.899567447886129e-16, 4.935701854138566e-16,
+    4.972162455791692e-16, 5.008957192059101e-16, 5.046094265888421e-16,
+    5.083582156411612e-16, 5.121429632123529e-16, 5.159645764841049e-16,
+    5.198239944499481e-16, 5.237221894847837e-16, 5.276601690109873e-16,
+    5.316389772683677e-16, 5.3565969719590385e-16, 5.397234524338966e-16,
+    5.438314094559625e-16, 5.479847798411618e-16, 5.521848226975221e-16,
+    5.564328472492859e-16, 5.607302156013954e-16, 5.650783456960495e-16,
+    5.694787144776336e-16, 5.739328612839624e-16, 5.784423914835979e-16,
+    5.830089803810575e-16, 5.876343774140044e-16, 5.92320410669092e-16,
+    5.970689917460079e-16, 6.018821210025225e-16, 6.067618932169995e-16,
+    6.11710503708971e-16, 6.167302549630609e-16, 6.218235638068522e-16,
+    6.269929691993316e-16, 6.322411406934202e-16, 6.375708876439416e-16,
+    6.429851692413585e-16, 6.484871054618893e-16, 6.540799890364471e-16,
+    6.597672985544556e-16, 6.655527128343333e-16, 6.714401267106478e-16,
+    6.774336684090999e-16, 6.835377187051263e-16, 6.897569320906838e-16,
+    6.960962602074874e-16, 7.025609778445949e-16, 7.091567118449574e-16,
+    7.158894733208543e-16, 7.227656936438111e-16, 7.297922647529075e-16,
+    7.369765844191232e-16, 7.443266072160405e-16, 7.518509020832502e-16,
+    7.595587175337739e-16, 7.674600557578418e-16, 7.755657571215781e-16,
+    7.838875968622848e-16, 7.92438396157354e-16, 8.012321502113074e-16,
+    8.1028417659131365e-16, 8.196112877806115e-16, 8.292319928581799e-16,
+    8.391667344146788e-16, 8.49438168364876e-16, 8.600714963334932e-16,
+    8.710948629387894e-16, 8.825398338072131e-16, 8.944419748519855e-16,
+    9.06841559713166e-16, 9.197844409811855e-16, 9.333231329422942e-16,
+    9.475181706524974e-16, 9.624398345658464e-16, 9.781703654784408e-16,
+    9.94806847238387e-16, 1.012465014428831e-15, 1.0312843657756156e-15,
+    1.051435160404454e-15, 1.0731281954224031e-15, 1.0966288068517398e-15,
+    1.122277490935031e-15, 1.1505212963006654e-15, 1.1819635283304196e-15,
+    1.2174462832361807e-15, 1.2581958069755106e-15, 1.3060984107128074e-15,
+    1.3642786158057851e-15, 1.4384889932178717e-15, 1.541219070006419e-15,
+    1.7091034077168055e-15,
+};
+
+static const double rk_zig_fe[256] = {
+    1.0, 0.938143680862219, 0.900469929925778,
+    0.871704332381229, 0.8477855006240113, 0.8269932966430694,
+    0.8084216515230256, 0.7915276369725114, 0.7759568520401301,
+    0.7614633888499097, 0.7478686219852078, 0.7350380924314355,
+    0.7228676595935833, 0.7112747608050868, 0.7001926550827985,
+    0.6895664961170879, 0.6793505722647749, 0.669506316731934,
+    0.6600008410790086, 0.6508058334145795, 0.6418967164272743,
+    0.6332519942143741, 0.6248527387036736, 0.6166821809152151,
+    0.6087253820796293, 0.6009689663652393, 0.5934009016917403,
+    0.5860103184772747, 0.5787873586028516, 0.5717230486648321,
+    0.5648091929124064, 0.5580382822625934, 0.5514034165406472,
+    0.5448982376724454, 0.5385168720028675, 0.5322538802630488,
+    0.5261042139836251, 0.5200631773682388, 0.5141263938147537,
+    0.5082897764106479, 0.5025495018413526, 0.4969019872415544,
+    0.4913438695940373, 0.4858719873418896, 0.48048336393045876,
+    0.4751751930373818, 0.46994482528396436, 0.46478975625043045,
+    0.45970761564214185, 0.45469615747461956, 0.449753251162759,
+    0.44487687341455245, 0.4400651008423577, 0.4353161032156404,
+    0.43062813728846255, 0.425999541143038, 0.4214287289976202,
+    0.41691418643300643, 0.4124544659971646, 0.4080481831520358,
+    0.4036940125305336, 0.39939068447523435, 0.3951369818332934,
+    0.39093173698480027, 0.3867738290841408, 0.3826621814960129,
+    0.37859575940958384, 0.37457356761590516, 0.37059464843514894,
+    0.36665807978151704, 0.3627629733548206, 0.3589084729487525,
+    0.3550937528667902, 0.35131801643748606, 0.3475804946216396,
+    0.343880444704505, 0.3402171490667826, 0.3365899140286801,
+    0.3329980687618114, 0.3294409642641388, 0.3259179723935586,
+    0.3224284849560915, 0.31897191284495957, 0.3155476852271313,
+    0.3121552487741819, 0.30879406693456246, 0.3054636192445925,
+    0.3021634006756957, 0.2988929210155839, 0.29565170428126325,
+    0.2924392881618946, 0.2892552234896797, 0.28609907373707877,
+    0.28297041453878263, 0.27986883323697476, 0.2767939284485192,
+    0.27374530965280475, 0.27072259679906174, 0.2677254199320465,
+    0.26475341883506387, 0.2618062426893646, 0.25888354974901784,
+    0.255985007030417, 0.25311029001563107, 0.25025908236886385,
+    0.24743107566532918, 0.24462596913189366, 0.24184346939887874,
+    0.23908329026245065, 0.2363451524570611, 0.2336287834374348,
+    0.23093391716962888, 0.22826029393071814, 0.22560766011668545,
+    0.22297576805812155, 0.22036437584336088, 0.21777324714870192,
+    0.21520215107538007, 0.21265086199297964, 0.2101191593889896,
+    0.20760682772422334, 0.205113656293839, 0.20263943909371027,
+    0.20018397469191251, 0.1977470661051001, 0.19532852067956447,
+    0.19292814997677254, 0.19054576966319658, 0.18818119940425548,
+    0.18583426276219828, 0.1835047870977686, 0.18119260347549743,
+    0.17889754657247942, 0.176619454590496, 0.17435816917135458,
+    0.17211353531532111, 0.16988540130252872, 0.16767361861725122,
+    0.165478041874937, 0.1632985287519028, 0.16113493991759298,
+    0.15898713896931513, 0.15685499236936615, 0.154738369384469,
+    0.15263714202744377, 0.15055118500104078, 0.14848037564386765,
+    0.14642459387834578, 0.1443837221606356, 0.142357645432473,
+    0.14034625107486323, 0.13834942886358098, 0.1363670709264296,
+    0.13439907170221438, 0.13244532790138822, 0.13050573846833147,
+    0.12858020454522887, 0.12666862943751134, 0.12477091858083166,
+    0.12288697950954582, 0.12101672182667549, 0.11916005717532833,
+    0.1173168992115562, 0.11548716357863417, 0.11367076788274494,
+    0.11186763167005694, 0.110077676405186, 0.10830082545103438,
+    0.10653700405000224, 0.10478613930657076, 0.1030481601712583,
+    0.10132299742595421, 0.09961058367063771, 0.09791085331149277,
+    0.09622374255043334, 0.09454918937605637, 0.09288713355604407,
+    0.09123751663104068, 0.08960028191003336, 0.0879753744672707,
+    0.08636274114075738, 0.08476233053236859, 0.08317409300963284,
+    0.08159798070923789, 0.08003394754232036, 0.07848194920160685,
+    0.07694194317048093, 0.07541388873405881, 0.07389774699236513,
+    0.07239348087570914, 0.07090105516237222, 0.06942043649872913,
+    0.06795159342193698, 0.06649449638534012, 0.06504911778675408,
+    0.06361543199980767, 0.062193415408541314, 0.06078304644547993,
+    0.059384305633420544, 0.057997175631200916, 0.05662164128374312,
+    0.05525768967669727, 0.053905310196046316, 0.05256449459307192,
+    0.051235237055126504, 0.0499175342827066, 0.04861138557337972,
+    0.04731679291318178, 0.046033761076175385, 0.04476229773294349,
+    0.04350241356888839, 0.04225412241331643, 0.04101744138041501,
+    0.0397923910233743, 0.038578995503075024, 0.03737728277295953,
+    0.03618728478193159, 0.03500903769739757, 0.03384258215087449,
+    0.03268796350895969, 0.03154523217289375, 0.030414443910466743,
+    0.029295660224637525, 0.028188948763978757, 0.02709438378095592,
+    0.026012046645134335, 0.024942026419731898, 0.023884420511558282,
+    0.02283933540638534, 0.021806887504283678, 0.020787204072578207,
+    0.019780424338009826, 0.018786700744696107, 0.017806200410911435,
+    0.016839106826040014, 0.01588562183997323, 0.014945968011691214,
+    0.014020391403182004, 0.01310916493125506, 0.012212592426255444,
+    0.01133101359783465, 0.010464810181030028, 0.009614413642502255,
+    0.008780314985809015, 0.007963077438017078, 0.007163353183635017,
+    0.006381905937319206, 0.005619642207205509, 0.004877655983542413,
+    0.004157295120833812, 0.0034602647778369166, 0.0027887987935740857,
+    0.0021459677437189128, 0.0015362997803015767, 0.000967269282327176,
+    0.0004541343538414966,
+};
+
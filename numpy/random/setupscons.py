@@ -10,11 +10,13 @@ def configuration(parent_package='',top_path=None):
                                                 'numpy.pxi',
                                                 'randomkit.c',
                                                 'randomkit.h',
+                                                'randomkit_jump.h',
                                                 'Python.pxi',
                                                 'initarray.c',
                                                 'initarray.h',
                                                 'distributions.c',
                                                 'distributions.h',
+                                                'ziggurat.h',
                                                 ]]
     config.add_sconscript('SConstruct', source_files = source_files)
     config.add_data_files(('.', join('mtrand', 'randomkit.h')))
@@ -100,6 +100,52 @@ class TestRandomDist(TestCase):
                          [-48, -66]])
         np.testing.assert_array_equal(actual, desired)
 
+    def test_randint_dtypes(self):
+        # The default method draws the same values for every dtype
+        for dt in [np.int8, np.int16, np.int32, np.int64]:
+            np.random.seed(self.seed)
+            actual = np.random.randint(-99, 99, size=(3,2), dtype=dt)
+            desired = np.array([[ 31,   3],
+                                [-52,  41],
+                                [-48, -66]])
+            assert_(actual.dtype == dt)
+            np.testing.assert_array_equal(actual, desired)
+        for dt in [np.uint8, np.uint16, np.uint32, np.uint64]:
+            info = np.iinfo(dt)
+            actual = np.random.randint(info.min, int(info.max) + 1, size=10,
+                                       dtype=dt)
+            assert_(actual.dtype == dt)
+            actual = np.random.randint(info.max, int(info.max) + 1, dtype=dt)
+            assert_(actual == info.max)
+            assert_raises(ValueError, np.random.randint, -1, 1, dtype=dt)
+            assert_raises(ValueError, np.random.randint, int(info.max) + 2,
+                          dtype=dt)
+        assert_raises(ValueError, np.random.randint, 5, dtype=float)
+
+    def test_randint_lemire(self):
+        np.random.seed(self.seed)
+        actual = np.random.randint(-99, 99, size=(3,2), method='lemire')
+        desired = np.array([[  1, -34],
+                            [ 98,  17],
+                            [-66, -32]])
+        np.testing.assert_array_equal(actual, desired)
+        np.random.seed(self.seed)
+        actual = np.random.randint(2**40, size=2, method='lemire')
+        desired = np.array([680372044375, 650497058342])
+        np.testing.assert_array_equal(actual, desired)
+        np.random.seed(self.seed)
+        actual = np.random.randint(2**64, size=2, dtype=np.uint64,
+                                   method='lemire')
+        desired = np.array([11414748748843816959, 10913529655170884655],
+                           dtype=np.uint64)
+        np.testing.assert_array_equal(actual, desired)
+        # Small ranges take several values from each word
+        actual = np.random.randint(3, 13, size=1000, dtype=np.int16,
+                                   method='lemire')
+        assert_(actual.dtype == np.int16)
+        np.testing.assert_array_equal(np.unique(actual), np.arange(3, 13))
+        assert_raises(ValueError, np.random.randint, 5, method='mask')
+
     def test_random_integers(self):
         np.random.seed(self.seed)
         actual = np.random.random_integers(-99, 99, size=(3,2))
@@ -130,6 +176,89 @@ class TestRandomDist(TestCase):
         desired = [0, 1, 9, 6, 2, 4, 5, 8, 7, 3]
         np.testing.assert_array_equal(actual, desired)
 
+    def test_shuffle_arrays(self):
+        # Arrays are shuffled in C, with the same values as lists
+        for arr in [np.arange(20, dtype=np.int8), np.arange(20.0),
+                    np.arange(20, dtype=complex),
+                    np.arange(60.0).reshape(20, 3),
+                    np.arange(40)[::-2], np.arange(20).astype(object),
+                    np.array(['a%d' % i for i in range(20)]),
+                    np.zeros((20, 0))]:
+            alist = list(arr.copy())
+            np.random.seed(self.seed)
+            np.random.shuffle(arr)
+            np.random.seed(self.seed)
+            np.random.shuffle(alist)
+            desired = np.array(alist).reshape(arr.shape)
+            np.testing.assert_array_equal(arr, desired)
+
+    def test_choice_uniform_replace(self):
+        np.random.seed(self.seed)
+        actual = np.random.choice(4, 4)
+        desired = np.array([2, 3, 2, 3])
+        np.testing.assert_array_equal(actual, desired)
+
+    def test_choice_nonuniform_replace(self):
+        np.random.seed(self.seed)
+        actual = np.random.choice(4, 4, p=[0.1, 0.3, 0.5, 0.1])
+        desired = np.array([2, 2, 1, 2])
+        np.testing.assert_array_equal(actual, desired)
+
+    def test_choice_uniform_noreplace(self):
+        np.random.seed(self.seed)
+        actual = np.random.choice(4, 4, replace=False)
+        desired = np.array([2, 3, 1, 0])
+        np.testing.assert_array_equal(actual, desired)
+        # Few samples of a large population are drawn with Floyd's algorithm
+        np.random.seed(self.seed)
+        actual = np.random.choice(10**9, 4, replace=False)
+        desired = np.array([640082991, 393520486, 388732927, 510219650])
+        np.testing.assert_array_equal(actual, desired)
+        actual = np.random.choice(10**6, 1000, replace=False)
+        assert_(len(np.unique(actual)) == 1000)
+        assert_(np.all((0 <= actual) & (actual < 10**6)))
+
+    def test_choice_nonuniform_noreplace(self):
+        np.random.seed(self.seed)
+        actual = np.random.choice(4, 4, replace=False,
+                                  p=[0.1, 0.3, 0.5, 0.1])
+        desired = np.array([1, 2, 0, 3])
+        np.testing.assert_array_equal(actual, desired)
+        actual = np.random.choice(4, 2, replace=False, p=[0, 0.5, 0, 0.5])
+        np.testing.assert_array_equal(np.sort(actual), [1, 3])
+
+    def test_choice_noninteger(self):
+        np.random.seed(self.seed)
+        actual = np.random.choice(['a', 'b', 'c', 'd'], 4)
+        desired = np.array(['c', 'd', 'c', 'd'])
+        np.testing.assert_array_equal(actual, desired)
+
+    def test_choice_0d_integer(self):
+        # A 0-d integer array is a population size, like an int
+        np.random.seed(self.seed)
+        actual = np.random.choice(np.array(4), 4)
+        np.random.seed(self.seed)
+        desired = np.random.choice(4, 4)
+        np.testing.assert_array_equal(actual, desired)
+        assert_(0 <= np.random.choice(np.array(4, dtype=np.int8)) < 4)
+
+    def test_choice_exceptions(self):
+        sample = np.random.choice
+        assert_raises(ValueError, sample, -1, 3)
+        assert_raises(ValueError, sample, [[1, 2], [3, 4]], 3)
+        assert_raises(ValueError, sample, [], 3)
+        assert_raises(ValueError, sample, [1, 2, 3, 4], 3,
+                      p=[[0.25, 0.25], [0.25, 0.25]])
+        assert_raises(ValueError, sample, [1, 2], 3, p=[0.4, 0.4, 0.2])
+        assert_raises(ValueError, sample, [1, 2], 3, p=[1.1, -0.1])
+        assert_raises(ValueError, sample, 3, 3, p=[np.nan, 0.5, 0.5])
+        assert_raises(ValueError, sample, 3, 3, p=[np.inf, -np.inf, 1])
+        assert_raises(ValueError, sample, np.array(0), 3)
+        assert_raises(ValueError, sample, [1, 2], 3, p=[0.4, 0.4])
+        assert_raises(ValueError, sample, [1, 2, 3], 4, replace=False)
+        assert_raises(ValueError, sample, [1, 2, 3], 2, replace=False,
+                      p=[1, 0, 0])
+
     def test_beta(self):
         np.random.seed(self.seed)
         actual = np.random.beta(.1, .9, size=(3, 2))
@@ -271,6 +400,36 @@ class TestRandomDist(TestCase):
                           [  0.29768848031692957,  10.                 ]]])
         np.testing.assert_array_almost_equal(actual, desired, decimal=15)
 
+    def test_multivariate_normal_sampler(self):
+        mean = [.123456789, 10]
+        cov = [[4, 2], [2, 2]]
+        mvn = np.random.MultivariateNormal(mean, cov)
+        np.testing.assert_array_almost_equal(mvn.factor, [[2, 1], [0, 1]])
+        np.random.seed(self.seed)
+        z = np.random.standard_normal((3, 2), method='ziggurat')
+        desired = mean + np.dot(z, [[2, 1], [0, 1]])
+        np.random.seed(self.seed)
+        out = np.empty((3, 2))
+        actual = mvn.sample(3, out=out)
+        assert_(actual is out)
+        np.testing.assert_array_almost_equal(actual, desired, decimal=14)
+        assert_(mvn.sample().shape == (2,))
+        assert_(mvn.sample((4, 5)).shape == (4, 5, 2))
+        # Semi-definite covariances need the eigendecomposition
+        cov = [[1, 1], [1, 1]]
+        assert_raises(ValueError, np.random.MultivariateNormal, mean, cov)
+        mvn = np.random.MultivariateNormal(mean, cov, method='eigh',
+                                           random_state=random.RandomState(1))
+        np.testing.assert_array_almost_equal(np.dot(mvn.factor.T, mvn.factor),
+                                             cov)
+        actual = mvn.sample(5) - mean
+        np.testing.assert_array_almost_equal(actual[:, 0], actual[:, 1])
+        assert_raises(ValueError, mvn.sample, 5, out=np.empty((5, 3)))
+        assert_raises(ValueError, np.random.MultivariateNormal, mean,
+                      [[1, 2], [2, 1]], method='eigh')
+        assert_raises(ValueError, np.random.MultivariateNormal, mean, cov,
+                      method='svd')
+
     def test_negative_binomial(self):
         np.random.seed(self.seed)
         actual = np.random.negative_binomial(n = 100, p = .12345, size = (3, 2))
@@ -376,6 +535,98 @@ class TestRandomDist(TestCase):
                          [ 2.031033998682787  ,  2.17032494605655257]])
         np.testing.assert_array_almost_equal(actual, desired, decimal=15)
 
+    def test_standard_normal_ziggurat(self):
+        np.random.seed(self.seed)
+        actual = np.random.standard_normal(size = (3, 2), method='ziggurat')
+        desired = np.array([[ 1.0188947946689229,  0.4923204943103824],
+                         [-0.1172149037292321,  0.5362290609639675],
+                         [ 0.2869804240338853,  0.9595791323733219]])
+        np.testing.assert_array_almost_equal(actual, desired, decimal=15)
+
+    def test_standard_exponential_ziggurat(self):
+        np.random.seed(self.seed)
+        actual = np.random.standard_exponential(size = (3, 2),
+                                                method='ziggurat')
+        desired = np.array([[ 1.2141669263092143,  0.5743649393108575],
+                         [ 0.1792024840155427,  0.8240680035658485],
+                         [ 0.3016898963866733,  1.305194778967923 ]])
+        np.testing.assert_array_almost_equal(actual, desired, decimal=15)
+
+    def test_gamma_ziggurat(self):
+        np.random.seed(self.seed)
+        actual = np.random.gamma(0.5, 2, size = (3, 2), method='ziggurat')
+        desired = np.array([[ 0.8080639747691   ,  3.1305809972599232],
+                         [ 0.418736001222304 ,  0.1426461124097411],
+                         [ 0.5870813833642378,  0.321601006613387 ]])
+        np.testing.assert_array_almost_equal(actual, desired, decimal=14)
+
+    def test_ziggurat(self):
+        """ Arrays hold the values of scalar draws, and the samples have the
+        right moments.
+        """
+        prng = random.RandomState(self.seed)
+        state = prng.get_state()
+        x = prng.normal(3, 2, size=1000, method='ziggurat')
+        y = prng.standard_exponential(size=1000, method='ziggurat')
+        prng.set_state(state)
+        np.testing.assert_array_equal(
+            x, [prng.normal(3, 2, method='ziggurat') for i in range(1000)])
+        np.testing.assert_array_equal(
+            y, [prng.exponential(method='ziggurat') for i in range(1000)])
+        x = prng.standard_normal(size=100000, method='ziggurat')
+        assert_(abs(x.mean()) < 0.02 and abs(x.var() - 1) < 0.02)
+        y = prng.standard_exponential(size=100000, method='ziggurat')
+        assert_(abs(y.mean() - 1) < 0.02 and abs(y.var() - 1) < 0.04)
+        assert_raises(ValueError, prng.standard_normal, method='polar')
+
+    def test_float32(self):
+        """ Single precision samples are made from one 32 bit value each.
+        """
+        prng = random.RandomState(self.seed)
+        words = np.frombuffer(prng.bytes(4 * 6), dtype='<u4')
+        prng.seed(self.seed)
+        actual = prng.random_sample(size=(3, 2), dtype=np.float32)
+        assert_(actual.dtype == np.float32)
+        np.testing.assert_array_equal(actual.ravel(),
+                                      (words >> 8) / np.float32(2**24))
+        assert_(type(prng.random_sample(dtype=np.float32)) is np.float32)
+        assert_raises(ValueError, prng.random_sample, dtype=np.int32)
+
+    def test_standard_normal_float32(self):
+        np.random.seed(self.seed)
+        actual = np.random.standard_normal(size = (3, 2), dtype=np.float32)
+        desired = np.array([[ 1.437273  ,  0.42896128],
+                         [ 1.5450428 ,  0.2681747 ],
+                         [-0.01465179, -0.00875883]], np.float32)
+        assert_(actual.dtype == np.float32)
+        np.testing.assert_array_almost_equal(actual, desired, decimal=6)
+        x = np.random.standard_normal(size=100000, dtype=np.float32)
+        assert_(abs(x.mean()) < 0.02 and abs(x.var() - 1) < 0.02)
+
+    def test_standard_exponential_float32(self):
+        np.random.seed(self.seed)
+        actual = np.random.standard_exponential(size = (3, 2),
+                                                dtype=np.float32)
+        desired = np.array([[ 1.7127277 ,  0.40759712],
+                         [ 1.8025217 ,  0.20213962],
+                         [ 0.02240021,  0.00741867]], np.float32)
+        assert_(actual.dtype == np.float32)
+        np.testing.assert_array_almost_equal(actual, desired, decimal=6)
+        x = np.random.standard_exponential(size=100000, dtype=np.float32)
+        assert_(abs(x.mean() - 1) < 0.02 and abs(x.var() - 1) < 0.04)
+
+    def test_standard_gamma_float32(self):
+        np.random.seed(self.seed)
+        actual = np.random.standard_gamma(0.5, size = (3, 2),
+                                          dtype=np.float32)
+        desired = np.array([[ 0.40403193,  0.36145276],
+                         [ 1.5993214 ,  0.20936798],
+                         [ 0.82154113,  0.07132304]], np.float32)
+        assert_(actual.dtype == np.float32)
+        np.testing.assert_array_almost_equal(actual, desired, decimal=6)
+        actual = np.random.standard_gamma([1., 2.], dtype=np.float32)
+        assert_(actual.dtype == np.float32 and actual.shape == (2,))
+
     def test_standard_t(self):
         np.random.seed(self.seed)
         actual = np.random.standard_t(df = 10, size = (3, 2))
@@ -434,5 +685,163 @@ class TestRandomDist(TestCase):
                          [ 3, 13]])
         np.testing.assert_array_equal(actual, desired)
 
+
+class TestThread(TestCase):
+    """ Make sure each state produces the same sequence even in threads
+    """
+    def setUp(self):
+        self.seeds = range(4)
+
+    def check_function(self, function, sz):
+        from threading import Thread
+
+        out1 = np.empty((len(self.seeds),) + sz)
+        out2 = np.empty((len(self.seeds),) + sz)
+
+        # threaded generation
+        t = [Thread(target=function, args=(random.RandomState(s), o))
+             for s, o in zip(self.seeds, out1)]
+        [x.start() for x in t]
+        [x.join() for x in t]
+
+        # the same serial
+        for s, o in zip(self.seeds, out2):
+            function(random.RandomState(s), o)
+
+        np.testing.assert_array_equal(out1, out2)
+
+    def test_normal(self):
+        def gen_random(state, out):
+            out[...] = state.normal(size=10000)
+        self.check_function(gen_random, sz=(10000,))
+
+    def test_exp(self):
+        def gen_random(state, out):
+            out[...] = state.exponential(scale=np.ones((100, 1000)))
+        self.check_function(gen_random, sz=(100, 1000))
+
+    def test_multinomial(self):
+        def gen_random(state, out):
+            out[...] = state.multinomial(10, [1/6.]*6, size=10000)
+        self.check_function(gen_random, sz=(10000, 6))
+
+    def test_shared_state(self):
+        """ Threads sharing a state each get a consecutive part of it
+        """
+        from threading import Thread
+        prng = random.RandomState(1234)
+        parts = []
+        def gen_random():
+            parts.append(prng.random_sample(1000))
+        t = [Thread(target=gen_random) for i in range(4)]
+        [x.start() for x in t]
+        [x.join() for x in t]
+        expected = random.RandomState(1234).random_sample(4000)
+        np.testing.assert_array_equal(np.sort(np.concatenate(parts)),
+                                      np.sort(expected))
+        for part in parts:
+            start = np.nonzero(expected == part[0])[0][0]
+            np.testing.assert_array_equal(part,
+                                          expected[start:start + 1000])
+
+
+class TestPhilox(TestCase):
+    """ The Philox4x32-10 generator and its streams
+    """
+    def test_known_answers(self):
+        # Known answers of Random123 for Philox4x32-10
+        prng = random.RandomState(0, brng='Philox')
+        assert_(prng.bytes(16) == asbytes(
+            '\xd5\xe8\x27\x66\x8d\xc5\x69\xe1'
+            '\x4c\xac\x57\xbc\xd8\xdb\x00\x9b'))
+        prng.set_state(('Philox', [0xa4093822, 0x299f31d0],
+                        [0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344],
+                        0, 0, 0.0))
+        assert_(prng.bytes(4) == asbytes('\x09\xfe\x6c\xd1'))
+
+    def test_state(self):
+        prng = random.RandomState(1234, brng='Philox', stream=3)
+        prng.random_sample(3)
+        prng.standard_normal()
+        state = prng.get_state()
+        assert_(state[0] == 'Philox')
+        old = prng.standard_normal(size=5)
+        prng.seed(1)
+        prng.set_state(state)
+        np.testing.assert_array_equal(prng.standard_normal(size=5), old)
+        # reseeding keeps the generator
+        prng.seed(1234, stream=3)
+        assert_(prng.get_state()[0] == 'Philox')
+        prng.seed(1234, brng='MT19937')
+        assert_(prng.get_state()[0] == 'MT19937')
+
+    def test_streams(self):
+        x = random.RandomState(5, brng='Philox').random_sample(1000)
+        y = random.RandomState(5, brng='Philox', stream=1).random_sample(1000)
+        z = random.RandomState(5, brng='Philox', stream=1).random_sample(1000)
+        assert_(not np.any(x == y))
+        np.testing.assert_array_equal(y, z)
+        assert_raises(ValueError, random.RandomState, 5, stream=1)
+        assert_raises(ValueError, random.RandomState, 5, 'Philox', -1)
+
+    def test_advance(self):
+        prng = random.RandomState([1, 2, 3], brng='Philox')
+        state = prng.get_state()
+        expected = prng.bytes(4 * 1003)[4 * 1000:]
+        for n in [0, 1, 3, 999, 1000]:
+            prng.set_state(state)
+            prng.bytes(4 * n)
+            prng.advance(1000 - n)
+            assert_(prng.bytes(12) == expected)
+        # a whole period of the low words carries into the next
+        prng.set_state(('Philox', [1, 2], [2**32 - 1, 2**32 - 1, 0, 0],
+                        4, 0, 0.0))
+        prng.advance(4)
+        assert_(np.all(prng.get_state()[2] == [1, 0, 1, 0]))
+        assert_raises(ValueError, random.RandomState(1).advance, 1)
+
+    def test_pickle(self):
+        import pickle
+        prng = random.RandomState(7, brng='Philox', stream=2**40)
+        prng.random_sample(5)
+        other = pickle.loads(pickle.dumps(prng))
+        np.testing.assert_array_equal(prng.random_sample(10),
+                                      other.random_sample(10))
+
+
+class TestJump(TestCase):
+    def test_known_values(self):
+        prng = random.RandomState(1234)
+        jumped = prng.jumped()
+        assert_(jumped.bytes(8) ==
+                asbytes('\xeb\x36\x49\x90\xc5\xb5\x86\xf5'))
+        # the original is unchanged and jumping commutes with drawing
+        prng.bytes(4)
+        assert_(prng.jumped().bytes(4) == asbytes('\xc5\xb5\x86\xf5'))
+
+    def test_jumps(self):
+        prng = random.RandomState(5)
+        prng.standard_normal()
+        np.testing.assert_array_equal(prng.jumped(2).random_sample(10),
+                                      prng.jumped().jumped().random_sample(10))
+        np.testing.assert_array_equal(prng.jumped(0).random_sample(10),
+                                      prng.random_sample(10))
+        assert_raises(ValueError, prng.jumped, -1)
+        assert_raises(ValueError, random.RandomState(5, 'Philox').jumped)
+
+    def test_fill(self):
+        # filling arrays gives the values of scalar draws
+        for brng in ['MT19937', 'Philox']:
+            prng = random.RandomState(3, brng)
+            prng.random_sample(3)
+            state = prng.get_state()
+            x = prng.random_sample(1000)
+            y = prng.uniform(-2, 3, size=(10, 7))
+            prng.set_state(state)
+            np.testing.assert_array_equal(
+                x, [prng.random_sample() for i in range(1000)])
+            np.testing.assert_array_equal(
+                y.ravel(), [prng.uniform(-2, 3) for i in range(70)])
+
 if __name__ == "__main__":
     run_module_suite()